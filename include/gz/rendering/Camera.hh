@@ -18,9 +18,13 @@
 #define GZ_RENDERING_CAMERA_HH_
 
 #include <string>
+#include <vector>
 
 #include <gz/common/Event.hh>
 #include <gz/math/Matrix4.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/utils/SuppressWarning.hh>
 
 #include "gz/rendering/config.hh"
 #include "gz/rendering/Image.hh"
@@ -44,6 +48,27 @@ namespace gz
       CPT_ORTHOGRAPHIC
     };
 
+    /// \brief A visual found by an area selection query
+    /// \sa Camera::VisualsInRectangle
+    /// \sa Camera::VisualsInPolygon
+    class GZ_RENDERING_VISIBLE VisualAreaResult
+    {
+      /// \brief Id of the visual
+      public: unsigned int objectId = 0;
+
+      /// \brief Number of pixels of the area covered by the visual
+      public: unsigned int pixelCount = 0;
+
+      /// \brief Distance from the camera to the closest point of the visual
+      /// seen in the area. Negative if no valid point was found.
+      public: double distance = -1;
+
+      /// \brief Closest point of the visual seen in the area, in world frame
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      public: math::Vector3d point;
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+
     /// \class Camera Camera.hh gz/rendering/Camera.hh
     /// \brief Posable camera used for rendering the scene graph
     class GZ_RENDERING_VISIBLE Camera :
@@ -158,6 +183,27 @@ namespace gz
       public: virtual VisualPtr VisualAt(const gz::math::Vector2i
                   &_mousePos) = 0;
 
+      /// \brief Get the visuals seen in a rectangular area of the image,
+      /// e.g. for box selection.
+      /// \param[in] _min Top left corner of the area in pixels
+      /// \param[in] _max Bottom right corner of the area in pixels. The area
+      /// includes both corners.
+      /// \return Visuals seen in the area, closest first. Empty if area
+      /// selection is not supported by the render engine.
+      public: virtual std::vector<VisualAreaResult> VisualsInRectangle(
+                  const gz::math::Vector2i &_min,
+                  const gz::math::Vector2i &_max);
+
+      /// \brief Get the visuals seen inside a polygon drawn on the image,
+      /// e.g. for lasso selection. Pixels whose centers are inside the
+      /// polygon, according to the even-odd rule, are considered.
+      /// \param[in] _polygon Polygon vertices in pixels. The last vertex is
+      /// connected back to the first one.
+      /// \return Visuals seen in the polygon, closest first. Empty if area
+      /// selection is not supported by the render engine.
+      public: virtual std::vector<VisualAreaResult> VisualsInPolygon(
+                  const std::vector<gz::math::Vector2i> &_polygon);
+
       /// \brief Renders a new frame.
       /// This is a convenience function for single-camera scenes. It wraps the
       /// pre-render, render, and post-render into a single
@@ -168,7 +214,10 @@ namespace gz
       /// \brief Created an empty image buffer for capturing images. The
       /// resulting image will have sufficient memory allocated for subsequent
       /// calls to this camera's Capture function. However, any changes to this
-      /// cameras properties may invalidate the condition.
+      /// cameras properties may invalidate the condition. The image buffer
+      /// is taken from the render engine's ImageBufferPool if it is enabled.
+      /// Capture and Copy also write into images created over caller owned
+      /// memory, see Image.
       /// \return A newly allocated Image for storing this cameras images
       public: virtual Image CreateImage() const = 0;
 
@@ -75,6 +75,27 @@ namespace gz
           std::function<void(const float *_pointCloud, unsigned int _width,
           unsigned int _height, unsigned int _depth,
           const std::string &_format)> _subscriber) = 0;
+
+      /// \brief Set the number of frames by which depth and point cloud
+      /// data may lag behind rendering. A value of 0 (default) reads the
+      /// data back synchronously, which stalls the CPU until the GPU has
+      /// finished rendering the frame. A value of N > 0 keeps a ring of
+      /// N + 1 asynchronous GPU readbacks in flight so that the data
+      /// rendered in frame K is delivered to subscribers of
+      /// ConnectNewDepthFrame and ConnectNewRgbPointCloud on frame K + N,
+      /// without stalling. No data is delivered for the first N frames
+      /// after this value is changed.
+      /// \param[in] _frames Number of frames of readback latency
+      /// \sa ReadbackLatency
+      public: virtual void SetReadbackLatency(unsigned int _frames);
+
+      /// \brief Get the number of frames by which depth and point cloud
+      /// data lag behind rendering.
+      /// \return Number of frames of readback latency. 0 if data is read
+      /// back synchronously or if asynchronous readback is not supported
+      /// by the render engine.
+      /// \sa SetReadbackLatency
+      public: virtual unsigned int ReadbackLatency() const;
     };
   }
   }
@@ -51,6 +51,22 @@ namespace gz
       /// \brief Copy to the specified memory direction the gpu rays data.
       public: virtual void Copy(float *_data) = 0;
 
+      /// \brief Set a caller-owned buffer that gpu rays data is written to
+      /// directly on every update. This avoids having to Copy() the data out
+      /// of the internal buffer after each frame. While the buffer is set,
+      /// Data() and the new gpu rays frame event point to it.
+      /// \param[in] _buffer Buffer that holds at least
+      /// RangeCount() * VerticalRangeCount() * Channels() floats. It must
+      /// remain valid until it is unset by passing nullptr.
+      /// \sa OutputBuffer
+      public: virtual void SetOutputBuffer(float *_buffer);
+
+      /// \brief Get the caller-owned buffer that gpu rays data is written to
+      /// \return Output buffer, or nullptr if data is written to the internal
+      /// buffer.
+      /// \sa SetOutputBuffer
+      public: virtual float *OutputBuffer() const;
+
       /// \brief Configure behaviour for data values outside of camera range
       /// \param[in] _clamp True to clamp data to camera clip distances,
       // false to leave data values as +/-inf when out of camera range
@@ -159,6 +175,14 @@ namespace gz
       /// \return Channel count.
       public: virtual unsigned int Channels() const = 0;
 
+      /// \brief Set the number of channels used to store the ray data.
+      /// Each reading is stored as [range, retro, 0] with 3 channels
+      /// (default), or as [range, retro, 0, 1] with 4 channels. The 4 channel
+      /// layout matches the layout the data is rendered in, so render engines
+      /// can copy it out without repacking every reading.
+      /// \param[in] _channels Channel count. Either 3 or 4.
+      public: virtual void SetChannels(unsigned int _channels);
+
       /// \brief Set the horizontal resolution. This number is multiplied by
       /// RayCount to calculate RangeCount, which is the the number range data
       /// points.
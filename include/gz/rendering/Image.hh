@@ -17,6 +17,7 @@
 #ifndef GZ_RENDERING_IMAGE_HH_
 #define GZ_RENDERING_IMAGE_HH_
 
+#include <functional>
 #include <memory>
 
 #include <gz/utils/SuppressWarning.hh>
@@ -48,6 +49,21 @@ namespace gz
       public: Image(unsigned int _width, unsigned int _height,
                   PixelFormat _format);
 
+      /// \brief Constructor that wraps externally owned memory instead of
+      /// allocating a new buffer, e.g. a shared memory segment or the buffer
+      /// of a message that is about to be published. Copies of the image
+      /// share the memory.
+      /// \param[in] _width Image width in pixels
+      /// \param[in] _height Image height in pixels
+      /// \param[in] _format Image pixel format
+      /// \param[in] _data Image memory of at least MemorySize() bytes
+      /// \param[in] _release Called with _data once the image and all its
+      /// copies are destroyed. If empty, the caller keeps ownership of _data
+      /// and must keep it alive while the image is in use.
+      public: Image(unsigned int _width, unsigned int _height,
+                  PixelFormat _format, void *_data,
+                  std::function<void(void *)> _release = nullptr);
+
       /// \brief Destructor
       public: ~Image();
 
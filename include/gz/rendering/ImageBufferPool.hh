@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_IMAGEBUFFERPOOL_HH_
+#define GZ_RENDERING_IMAGEBUFFERPOOL_HH_
+
+#include <cstddef>
+#include <memory>
+
+#include <gz/utils/SuppressWarning.hh>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/Export.hh"
+#include "gz/rendering/Image.hh"
+#include "gz/rendering/PixelFormat.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    // forward declaration
+    class ImageBufferPoolPrivate;
+
+    /* \class ImageBufferPool ImageBufferPool.hh \
+     * gz/rendering/ImageBufferPool.hh
+     */
+    /// \brief A pool of reusable image buffers, keyed by image width, height
+    /// and format. Images acquired from the pool return their buffer to it
+    /// once the image and all its copies are destroyed, so high rate camera
+    /// pipelines can hand images over to other threads without allocating a
+    /// new buffer every frame.
+    ///
+    /// The pool is disabled until a capacity is set, in which case Acquire
+    /// allocates a new buffer for every image. All functions are thread
+    /// safe, and acquired images may outlive the pool.
+    class GZ_RENDERING_VISIBLE ImageBufferPool
+    {
+      /// \brief Constructor
+      public: ImageBufferPool();
+
+      /// \brief Destructor
+      public: virtual ~ImageBufferPool();
+
+      /// \brief Set the max number of free buffers kept for each image
+      /// width, height and format. Buffers returned to a full pool are
+      /// deleted.
+      /// \param[in] _capacity Number of free buffers to keep. Zero disables
+      /// the pool and deletes the free buffers.
+      public: void SetCapacity(std::size_t _capacity);
+
+      /// \brief Get the max number of free buffers kept for each image
+      /// width, height and format
+      /// \return Number of free buffers kept. Zero if the pool is disabled.
+      public: std::size_t Capacity() const;
+
+      /// \brief Get an image with a buffer from the pool. A new buffer is
+      /// allocated if there is no free buffer for the given width, height
+      /// and format. The content of the buffer is undefined.
+      /// \param[in] _width Image width in pixels
+      /// \param[in] _height Image height in pixels
+      /// \param[in] _format Image pixel format
+      /// \return Image whose buffer returns to the pool once the image and
+      /// all its copies are destroyed
+      public: Image Acquire(unsigned int _width, unsigned int _height,
+                  PixelFormat _format);
+
+      /// \brief Get the number of free buffers in the pool
+      /// \return Number of free buffers of all widths, heights and formats
+      public: std::size_t FreeCount() const;
+
+      /// \brief Delete all free buffers. Buffers of images in use are
+      /// returned to the pool as usual.
+      public: void Clear();
+
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \internal
+      /// \brief Pointer to private data class. Shared with the images
+      /// acquired from the pool so they can return their buffer.
+      private: std::shared_ptr<ImageBufferPoolPrivate> dataPtr;
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+    }
+  }
+}
+#endif
@@ -17,6 +17,9 @@
 #ifndef GZ_RENDERING_MARKER_HH_
 #define GZ_RENDERING_MARKER_HH_
 
+#include <cstddef>
+#include <vector>
+
 #include <gz/math/Color.hh>
 #include <gz/math/Vector3.hh>
 #include "gz/rendering/config.hh"
@@ -140,6 +143,28 @@ namespace gz
       /// \param[in] _value The new positional vector of the point
       public: virtual void SetPoint(unsigned int _index,
                   const gz::math::Vector3d &_value) = 0;
+
+      /// \brief Replace all points of the marker with points read from
+      /// packed float arrays. This avoids one call per point, e.g. when
+      /// visualizing point clouds.
+      /// \param[in] _xyz Point positions, 3 floats per point
+      /// \param[in] _rgba Point colors, 4 floats per point. Null to make all
+      /// points white.
+      /// \param[in] _count Number of points
+      /// \param[in] _borrow True to read the arrays when the marker is next
+      /// rendered instead of copying them now. The arrays must then stay
+      /// valid and unchanged until the next render. Render engines that do
+      /// not support borrowing copy the arrays.
+      public: virtual void SetPoints(const float *_xyz, const float *_rgba,
+                  std::size_t _count, bool _borrow = false);
+
+      /// \brief Replace all points of the marker, taking ownership of the
+      /// arrays.
+      /// \param[in] _xyz Point positions, 3 floats per point
+      /// \param[in] _rgba Point colors, 4 floats per point. Empty to make all
+      /// points white.
+      public: virtual void SetPoints(std::vector<float> &&_xyz,
+                  std::vector<float> &&_rgba);
     };
     }
   }
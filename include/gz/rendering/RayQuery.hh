@@ -17,6 +17,8 @@
 #ifndef GZ_RENDERING_RAYQUERY_HH_
 #define GZ_RENDERING_RAYQUERY_HH_
 
+#include <vector>
+
 #include <gz/utils/SuppressWarning.hh>
 #include <gz/math/Vector3.hh>
 
@@ -106,6 +108,25 @@ namespace gz
       /// \return A vector of intersection results
       public: virtual RayQueryResult ClosestPoint(
             bool _forceSceneUpdate = true) = 0;
+
+      /// \brief Compute the closest intersection of many rays in one call.
+      /// This is equivalent to calling SetOrigin, SetDirection and
+      /// ClosestPoint for each ray but lets the render engine share work
+      /// between rays, e.g. update the scene graph only once. The origin and
+      /// direction of this ray query are not modified.
+      /// \param[in] _origins Ray origins
+      /// \param[in] _directions Ray directions. Must have the same size as
+      /// _origins.
+      /// \param[in] _forceSceneUpdate Performance optimization hint, see
+      /// ClosestPoint. When true the scene is updated once before any of the
+      /// rays is tested.
+      /// \return One result per ray, in the same order as the input rays.
+      /// Rays that do not hit anything have a negative distance. An empty
+      /// vector is returned if the input sizes do not match.
+      public: virtual std::vector<RayQueryResult> ClosestPoints(
+            const std::vector<math::Vector3d> &_origins,
+            const std::vector<math::Vector3d> &_directions,
+            bool _forceSceneUpdate = true);
     };
     }
   }
@@ -183,6 +183,16 @@ namespace gz
 
       /// \brief Get the render pass system for this engine.
       public: virtual RenderPassSystemPtr RenderPassSystem() const = 0;
+
+      /// \brief Get the image buffer pool shared by all cameras of this
+      /// engine. Camera::CreateImage takes its images from this pool, which
+      /// is disabled by default. Enable it with
+      /// ImageBufferPool::SetCapacity so images handed over to other
+      /// threads, e.g. for publishing, recycle their buffers instead of
+      /// allocating new ones every frame.
+      /// \return The engine image buffer pool, or null if the render engine
+      /// does not provide one
+      public: virtual ImageBufferPoolPtr ImageBufferPool() const;
     };
     }
   }
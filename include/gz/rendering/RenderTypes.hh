@@ -62,6 +62,7 @@ namespace gz
     class Grid;
     class Heightmap;
     class Image;
+    class ImageBufferPool;
     class InertiaVisual;
     class Light;
     class LightVisual;
@@ -172,6 +173,10 @@ namespace gz
     /// \brief Shared pointer to Image
     typedef shared_ptr<Image> ImagePtr;
 
+    /// \typedef ImageBufferPoolPtr
+    /// \brief Shared pointer to ImageBufferPool
+    typedef shared_ptr<ImageBufferPool> ImageBufferPoolPtr;
+
     /// \typedef InertiaVisualPtr
     /// \def Shared pointer to InertiaVisual
     typedef shared_ptr<InertiaVisual> InertiaVisualPtr;
@@ -346,6 +351,10 @@ namespace gz
     /// \brief Shared pointer to const Image
     typedef shared_ptr<const Image> ConstImagePtr;
 
+    /// \typedef const ImageBufferPoolPtr
+    /// \brief Shared pointer to const ImageBufferPool
+    typedef shared_ptr<const ImageBufferPool> ConstImageBufferPoolPtr;
+
     /// \typedef const LightPtr
     /// \brief Shared pointer to const Light
     typedef shared_ptr<const Light> ConstLightPtr;
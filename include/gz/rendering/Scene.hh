@@ -18,13 +18,16 @@
 #define GZ_RENDERING_SCENE_HH_
 
 #include <array>
+#include <cstddef>
 #include <string>
 #include <limits>
+#include <vector>
 
 #include <gz/common/Material.hh>
 #include <gz/common/Mesh.hh>
 
 #include <gz/math/Color.hh>
+#include <gz/math/Pose3.hh>
 
 #include "gz/rendering/base/SceneExt.hh"
 
@@ -215,6 +218,47 @@ namespace gz
       /// \return The desired node
       public: virtual NodePtr NodeByIndex(unsigned int _index) const = 0;
 
+      /// \brief Get the world poses of a list of nodes in one call. World
+      /// poses are cached on each node so nodes that share ancestors do not
+      /// recompute the ancestors' poses.
+      /// \param[in] _ids IDs of the desired nodes
+      /// \param[out] _poses World poses of the nodes, in the same order as
+      /// _ids. The pose is set to math::Pose3d::Zero for ids that do not
+      /// belong to a node of this scene.
+      /// \return Number of ids that belong to a node of this scene
+      public: virtual std::size_t NodeWorldPoses(
+                  const std::vector<unsigned int> &_ids,
+                  std::vector<math::Pose3d> &_poses) const;
+
+      /// \brief Set the local poses of many nodes in one call, e.g. to sync
+      /// the poses of all links of a simulation every step. This avoids the
+      /// overhead of looking up and updating each node through the Node
+      /// interface.
+      /// \param[in] _ids IDs of the nodes to update. Must hold _count ids.
+      /// \param[in] _poses New local poses, in the same order as _ids. Must
+      /// hold _count poses.
+      /// \param[in] _count Number of nodes to update
+      /// \param[in] _parallel True to let the render engine update its scene
+      /// nodes from multiple threads. The scene must not be accessed from
+      /// other threads during the call.
+      /// \return Number of nodes updated. Ids that do not belong to a node of
+      /// this scene and non-finite poses are skipped.
+      public: virtual std::size_t SetNodeLocalPoses(const unsigned int *_ids,
+                  const math::Pose3d *_poses, std::size_t _count,
+                  bool _parallel = false);
+
+      /// \brief Set the world poses of many nodes in one call. Poses are
+      /// applied in order, so if both a node and its ancestor are updated,
+      /// the ancestor should come first.
+      /// \param[in] _ids IDs of the nodes to update. Must hold _count ids.
+      /// \param[in] _poses New world poses, in the same order as _ids. Must
+      /// hold _count poses.
+      /// \param[in] _count Number of nodes to update
+      /// \return Number of nodes updated. Ids that do not belong to a node of
+      /// this scene and non-finite poses are skipped.
+      public: virtual std::size_t SetNodeWorldPoses(const unsigned int *_ids,
+                  const math::Pose3d *_poses, std::size_t _count);
+
       /// \brief Destroy given node. If the given node is not managed by this
       /// scene, no work will be done. Depending on the _recursive argument,
       /// this function will either detach all child nodes from the scene graph
@@ -1335,6 +1379,36 @@ namespace gz
       /// SetCameraPassCountPerGpuFlush
       public: virtual bool LegacyAutoGpuFlush() const = 0;
 
+      /// \brief Add a sensor to the scene sensor scheduler. Scheduled
+      /// sensors are rendered by UpdateSensors when they are due, which
+      /// walks the scene graph once per call instead of once per sensor as
+      /// Camera::Update does.
+      /// \param[in] _sensor Camera based sensor to schedule, e.g. a depth
+      /// camera or gpu rays. Scheduling it again changes its rate.
+      /// \param[in] _rate Update rate in Hz, based on the scene Time(). Zero
+      /// to render the sensor on every call to UpdateSensors.
+      /// \return False if _sensor is null, does not belong to this scene,
+      /// _rate is negative or the render engine does not support sensor
+      /// scheduling
+      /// \sa UpdateSensors
+      public: virtual bool ScheduleSensor(CameraPtr _sensor,
+                  double _rate);
+
+      /// \brief Remove a sensor from the scene sensor scheduler. Destroyed
+      /// sensors are removed automatically.
+      /// \param[in] _sensor Sensor to remove
+      /// \return False if the sensor was not scheduled
+      public: virtual bool UnscheduleSensor(CameraPtr _sensor);
+
+      /// \brief Render the scheduled sensors that are due at the current
+      /// scene Time(). This does a single PreRender, renders the due sensors
+      /// grouped by type, then calls PostRender on them so their results are
+      /// read back after all of them were rendered, followed by the scene
+      /// PostRender. Sensors that are not due are skipped, and nothing is
+      /// done if no sensor is due.
+      /// \return Number of sensors rendered
+      public: virtual unsigned int UpdateSensors();
+
       /// \brief Remove and destroy all objects from the scene graph. This does
       /// not completely destroy scene resources, so new objects can be created
       /// and added to the scene afterwards.
@@ -122,6 +122,22 @@ namespace gz
     GZ_RENDERING_VISIBLE
     Image convertRGBToBayer(const Image &_image, PixelFormat _bayerFormat);
 
+    /// \brief Convert RGB image data into bayer image data stored in a
+    /// caller provided buffer. Large images are converted using multiple
+    /// threads unless the conversion is done in place.
+    /// \param[in] _rgb Input RGB data, 3 bytes per pixel with no row padding
+    /// \param[in] _width Image width in pixels
+    /// \param[in] _height Image height in pixels
+    /// \param[in] _bayerFormat Bayer format to convert to
+    /// \param[out] _bayer Output bayer data, 1 byte per pixel. It can be the
+    /// same buffer as _rgb to convert in place.
+    /// \return True if the data was converted, false if _bayerFormat is not
+    /// a bayer format or a buffer is null
+    GZ_RENDERING_VISIBLE
+    bool convertRGBToBayer(const unsigned char *_rgb, unsigned int _width,
+        unsigned int _height, PixelFormat _bayerFormat,
+        unsigned char *_bayer);
+
     /// \brief Convenience function to get the default graphics API based on
     /// current platform
     /// \return Graphics API, i.e. METAL, OPENGL, VULKAN
@@ -104,6 +104,9 @@ namespace gz
         this->ChildByIndex(i)->SetLocalScale(_scale.X(),
                                              _scale.Y(),
                                              _scale.Z());
+
+      // the scale of the axis visual is the scale of its children
+      this->MarkWorldTransformDirty();
     }
 
     //////////////////////////////////////////////////
@@ -28,6 +28,7 @@
 
 #include "gz/rendering/Camera.hh"
 #include "gz/rendering/Image.hh"
+#include "gz/rendering/ImageBufferPool.hh"
 #include "gz/rendering/RenderEngine.hh"
 #include "gz/rendering/Scene.hh"
 #include "gz/rendering/base/BaseRenderTarget.hh"
@@ -410,6 +411,9 @@ namespace gz
       PixelFormat format = this->ImageFormat();
       unsigned int width = this->ImageWidth();
       unsigned int height = this->ImageHeight();
+      ImageBufferPoolPtr pool = this->Scene()->Engine()->ImageBufferPool();
+      if (pool)
+        return pool->Acquire(width, height, format);
       return Image(width, height, format);
     }
 
@@ -462,7 +466,7 @@ namespace gz
     {
       // TODO(anyone): determine proper type
       unsigned int size = this->ImageMemorySize();
-      return new unsigned char *[size];
+      return new unsigned char[size];
     }
 
     //////////////////////////////////////////////////
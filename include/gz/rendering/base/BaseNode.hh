@@ -18,6 +18,7 @@
 #define GZ_RENDERING_BASE_BASENODE_HH_
 
 #include <map>
+#include <memory>
 #include <string>
 
 #include "gz/rendering/Node.hh"
@@ -189,6 +190,15 @@ namespace gz
 
       protected: virtual void SetRawLocalPose(const math::Pose3d &_pose) = 0;
 
+      /// \brief Compute the raw local pose to store in the render engine
+      /// node from a local pose, i.e. remove the origin offset. Also records
+      /// the first pose set as the initial local pose.
+      /// \param[in] _pose Local pose
+      /// \param[out] _rawPose Raw local pose
+      /// \return False if the pose is not finite and must not be set
+      protected: virtual bool ComputeRawLocalPose(const math::Pose3d &_pose,
+                     math::Pose3d &_rawPose);
+
       protected: virtual NodeStorePtr Children() const = 0;
 
       protected: virtual bool AttachChild(NodePtr _child) = 0;
@@ -200,6 +210,19 @@ namespace gz
       protected: virtual void SetLocalScaleImpl(
                      const math::Vector3d &_scale) = 0;
 
+      /// \brief Mark the cached world pose and scale of this node and of all
+      /// its descendants as out of date. This is called when the local pose,
+      /// scale, origin or parent of the node changes. Derived classes must
+      /// call it when they change any of these without going through the
+      /// BaseNode functions, e.g. when setting whether the scale is inherited.
+      protected: void MarkWorldTransformDirty();
+
+      /// \brief Mark the cached world pose and scale of a child node and of
+      /// all its descendants as out of date.
+      /// \param[in] _child Child node
+      private: static void MarkChildWorldTransformDirty(
+                   const NodePtr &_child);
+
       protected: math::Vector3d origin;
 
       /// \brief Flag to indicate whether initial local pose
@@ -212,6 +235,20 @@ namespace gz
 
       /// \brief A map of custom key value data
       protected: std::map<std::string, Variant> userData;
+
+      /// \brief Cached world pose. Only valid if worldPoseDirty is false.
+      /// If a node's cache is out of date, the caches of all its descendants
+      /// are out of date too.
+      private: mutable math::Pose3d worldPose;
+
+      /// \brief Cached world scale. Only valid if worldScaleDirty is false.
+      private: mutable math::Vector3d worldScale;
+
+      /// \brief True if worldPose needs to be recomputed
+      private: mutable bool worldPoseDirty = true;
+
+      /// \brief True if worldScale needs to be recomputed
+      private: mutable bool worldScaleDirty = true;
     };
 
     //////////////////////////////////////////////////
@@ -254,6 +291,7 @@ namespace gz
       if (this->AttachChild(_child))
       {
         this->Children()->Add(_child);
+        MarkChildWorldTransformDirty(_child);
       }
     }
 
@@ -262,7 +300,11 @@ namespace gz
     NodePtr BaseNode<T>::RemoveChild(NodePtr _child)
     {
       NodePtr child = this->Children()->Remove(_child);
-      if (child) this->DetachChild(child);
+      if (child)
+      {
+        this->DetachChild(child);
+        MarkChildWorldTransformDirty(child);
+      }
       return child;
     }
 
@@ -271,7 +313,11 @@ namespace gz
     NodePtr BaseNode<T>::RemoveChildById(unsigned int _id)
     {
       NodePtr child = this->Children()->RemoveById(_id);
-      if (child) this->DetachChild(child);
+      if (child)
+      {
+        this->DetachChild(child);
+        MarkChildWorldTransformDirty(child);
+      }
       return child;
     }
 
@@ -280,7 +326,11 @@ namespace gz
     NodePtr BaseNode<T>::RemoveChildByName(const std::string &_name)
     {
       NodePtr child = this->Children()->RemoveByName(_name);
-      if (child) this->DetachChild(child);
+      if (child)
+      {
+        this->DetachChild(child);
+        MarkChildWorldTransformDirty(child);
+      }
       return child;
     }
 
@@ -289,7 +339,11 @@ namespace gz
     NodePtr BaseNode<T>::RemoveChildByIndex(unsigned int _index)
     {
       NodePtr child = this->Children()->RemoveByIndex(_index);
-      if (child) this->DetachChild(child);
+      if (child)
+      {
+        this->DetachChild(child);
+        MarkChildWorldTransformDirty(child);
+      }
       return child;
     }
 
@@ -335,24 +389,36 @@ namespace gz
     //////////////////////////////////////////////////
     template <class T>
     void BaseNode<T>::SetLocalPose(const math::Pose3d &_pose)
+    {
+      math::Pose3d pose;
+      if (!this->ComputeRawLocalPose(_pose, pose))
+        return;
+
+      this->SetRawLocalPose(pose);
+      this->MarkWorldTransformDirty();
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseNode<T>::ComputeRawLocalPose(const math::Pose3d &_pose,
+        math::Pose3d &_rawPose)
     {
       if (!_pose.IsFinite())
       {
         gzerr << "Unable to set non-finite pose [" << _pose
                << "] to node [" << this->Name() << "]" << std::endl;
-        return;
+        return false;
       }
 
-      math::Pose3d pose = _pose;
-      pose.Pos() = pose.Pos() - pose.Rot() * this->origin;
+      _rawPose = _pose;
+      _rawPose.Pos() = _rawPose.Pos() - _rawPose.Rot() * this->origin;
 
       if (!initialLocalPoseSet)
       {
-        this->initialLocalPose = pose;
+        this->initialLocalPose = _rawPose;
         this->initialLocalPoseSet = true;
       }
-
-      this->SetRawLocalPose(pose);
+      return true;
     }
 
     //////////////////////////////////////////////////
@@ -434,15 +500,18 @@ namespace gz
     template <class T>
     math::Pose3d BaseNode<T>::WorldPose() const
     {
+      if (!this->worldPoseDirty)
+        return this->worldPose;
+
       NodePtr parent = this->Parent();
       math::Pose3d pose = this->LocalPose();
 
-      if (!parent)
-      {
-        return pose;
-      }
+      if (parent)
+        pose = parent->WorldPose() * pose;
 
-      return parent->WorldPose() * pose;
+      this->worldPose = pose;
+      this->worldPoseDirty = false;
+      return pose;
     }
 
     //////////////////////////////////////////////////
@@ -546,6 +615,7 @@ namespace gz
         return;
       }
       this->origin = _origin;
+      this->MarkWorldTransformDirty();
     }
 
     //////////////////////////////////////////////////
@@ -569,20 +639,28 @@ namespace gz
       math::Pose3d rawPose = this->LocalPose();
       this->SetLocalScaleImpl(_scale);
       this->SetLocalPose(rawPose);
+      this->MarkWorldTransformDirty();
     }
 
     //////////////////////////////////////////////////
     template <class T>
     math::Vector3d BaseNode<T>::WorldScale() const
     {
+      if (!this->worldScaleDirty)
+        return this->worldScale;
+
       math::Vector3d scale = this->LocalScale();
 
-      if (!this->InheritScale() || !this->HasParent())
+      if (this->InheritScale())
       {
-        return scale;
+        NodePtr parent = this->Parent();
+        if (parent)
+          scale = scale * parent->WorldScale();
       }
 
-      return scale * this->Parent()->WorldScale();
+      this->worldScale = scale;
+      this->worldScaleDirty = false;
+      return scale;
     }
 
     //////////////////////////////////////////////////
@@ -631,6 +709,33 @@ namespace gz
       this->SetLocalScale(_scale * this->LocalScale());
     }
 
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseNode<T>::MarkWorldTransformDirty()
+    {
+      // descendants of a node with out of date caches are out of date too
+      if (this->worldPoseDirty && this->worldScaleDirty)
+        return;
+
+      this->worldPoseDirty = true;
+      this->worldScaleDirty = true;
+
+      NodeStorePtr children = this->Children();
+      if (!children)
+        return;
+      for (unsigned int i = 0; i < children->Size(); ++i)
+        MarkChildWorldTransformDirty(children->GetByIndex(i));
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseNode<T>::MarkChildWorldTransformDirty(const NodePtr &_child)
+    {
+      auto child = std::dynamic_pointer_cast<BaseNode<T>>(_child);
+      if (child)
+        child->MarkWorldTransformDirty();
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseNode<T>::Destroy()
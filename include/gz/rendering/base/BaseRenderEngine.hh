@@ -103,6 +103,9 @@ namespace gz
       // Documentation Inherited
       public: virtual RenderPassSystemPtr RenderPassSystem() const override;
 
+      // Documentation Inherited
+      public: virtual ImageBufferPoolPtr ImageBufferPool() const override;
+
       protected: virtual void PrepareScene(ScenePtr _scene);
 
       protected: virtual unsigned int NextSceneId();
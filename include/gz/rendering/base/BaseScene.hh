@@ -619,6 +619,16 @@ namespace gz
       // Documentation inherited.
       public: virtual bool LegacyAutoGpuFlush() const override;
 
+      // Documentation inherited.
+      public: virtual bool ScheduleSensor(CameraPtr _sensor,
+                  double _rate) override;
+
+      // Documentation inherited.
+      public: virtual bool UnscheduleSensor(CameraPtr _sensor) override;
+
+      // Documentation inherited.
+      public: virtual unsigned int UpdateSensors() override;
+
       protected: virtual unsigned int CreateObjectId();
 
       protected: virtual std::string CreateObjectName(unsigned int _id,
@@ -17,9 +17,14 @@
 #ifndef GZ_RENDERING_BASE_BASESTORAGE_HH_
 #define GZ_RENDERING_BASE_BASESTORAGE_HH_
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <gz/common/Console.hh>
@@ -33,6 +38,93 @@ namespace gz
   {
     inline namespace GZ_RENDERING_VERSION_NAMESPACE {
     //
+    //////////////////////////////////////////////////
+    /// \brief Entries of a string keyed std::map in iteration order,
+    /// indexable by position. It is a treap ordered by key with subtree
+    /// sizes, so inserting, erasing and looking up an entry by index are all
+    /// O(log n). The owning storage updates it in its mutators, so const
+    /// lookups never modify it and are safe to run concurrently.
+    template <class Iter>
+    class BaseStorageIndex
+    {
+      public: BaseStorageIndex() = default;
+
+      public: BaseStorageIndex(const BaseStorageIndex &) = delete;
+
+      public: BaseStorageIndex &operator=(const BaseStorageIndex &) = delete;
+
+      /// \brief Add an entry. Its key must not be in the index yet.
+      /// \param[in] _iter Map iterator of the entry
+      public: void Insert(Iter _iter);
+
+      /// \brief Remove the entry with the given key, if any
+      /// \param[in] _key Key of the entry
+      public: void Erase(const std::string &_key);
+
+      /// \brief Remove all entries
+      public: void Clear();
+
+      /// \brief Get the entry at the given position in key order
+      /// \param[in] _index Position of the entry. Must be less than the
+      /// number of entries.
+      /// \return Map iterator of the entry
+      public: Iter At(std::size_t _index) const;
+
+      /// \brief A node of the treap
+      private: struct Node
+      {
+        /// \brief Map iterator of the entry
+        Iter iter;
+
+        /// \brief Heap priority, parents have higher priorities
+        uint32_t priority = 0u;
+
+        /// \brief Number of entries in the subtree rooted at this node
+        std::size_t size = 1u;
+
+        /// \brief Entries with smaller keys
+        std::unique_ptr<Node> left;
+
+        /// \brief Entries with larger keys
+        std::unique_ptr<Node> right;
+      };
+
+      /// \brief Get the number of entries in a subtree
+      /// \param[in] _node Root of the subtree, may be null
+      /// \return Number of entries
+      private: static std::size_t Size(const std::unique_ptr<Node> &_node);
+
+      /// \brief Update the size of a node after its children changed
+      /// \param[in] _node Node to update
+      private: static void Update(Node *_node);
+
+      /// \brief Split a subtree by key
+      /// \param[in] _node Root of the subtree
+      /// \param[in] _key Key to split at
+      /// \param[in] _inclusive True to put the entry equal to _key on the
+      /// left side, false to put it on the right side
+      /// \param[out] _left Entries ordered before the split key
+      /// \param[out] _right Remaining entries
+      private: static void Split(std::unique_ptr<Node> _node,
+                  const std::string &_key, bool _inclusive,
+                  std::unique_ptr<Node> &_left,
+                  std::unique_ptr<Node> &_right);
+
+      /// \brief Merge two subtrees. All keys in _left must be ordered
+      /// before all keys in _right.
+      /// \param[in] _left Left subtree
+      /// \param[in] _right Right subtree
+      /// \return Root of the merged tree
+      private: static std::unique_ptr<Node> Merge(
+                  std::unique_ptr<Node> _left, std::unique_ptr<Node> _right);
+
+      /// \brief Root of the treap
+      private: std::unique_ptr<Node> root;
+
+      /// \brief State of the priority generator
+      private: uint32_t seed = 2463534242u;
+    };
+
     //////////////////////////////////////////////////
     template <class T, class U>
     class BaseMap :
@@ -80,7 +172,19 @@ namespace gz
 
       protected: virtual bool IsValidIter(ConstUIter _iter) const;
 
+      /// \brief Erase an entry and keep the lookup indices in sync
+      /// \param[in] _iter Iterator of the entry to erase
+      /// \return Iterator following the erased entry
+      protected: UIter EraseImpl(UIter _iter);
+
       protected: UMap map;
+
+      /// \brief Hash index of the map entries by key
+      protected: std::unordered_map<std::string, UIter> keyIndex;
+
+      /// \brief Map entries in iteration order, so that access by index
+      /// does not have to walk the map
+      protected: BaseStorageIndex<ConstUIter> orderIndex;
     };
 
     //////////////////////////////////////////////////
@@ -192,6 +296,16 @@ namespace gz
       protected: virtual UIter RemoveConstness(ConstUIter _iter);
 
       protected: UStore store;
+
+      /// \brief Hash index of the store entries by object name
+      protected: std::unordered_map<std::string, UIter> nameIndex;
+
+      /// \brief Hash index of the store entries by object id
+      protected: std::unordered_map<unsigned int, UIter> idIndex;
+
+      /// \brief Store entries in iteration order, so that access by index
+      /// does not have to walk the store
+      protected: BaseStorageIndex<ConstUIter> orderIndex;
     };
 
     //////////////////////////////////////////////////
@@ -386,6 +500,142 @@ namespace gz
     {
     };
 
+    //////////////////////////////////////////////////
+    template <class Iter>
+    void BaseStorageIndex<Iter>::Insert(Iter _iter)
+    {
+      // xorshift32, only used to keep the treap balanced
+      this->seed ^= this->seed << 13;
+      this->seed ^= this->seed >> 17;
+      this->seed ^= this->seed << 5;
+
+      std::unique_ptr<Node> node(new Node);
+      node->iter = _iter;
+      node->priority = this->seed;
+
+      std::unique_ptr<Node> left;
+      std::unique_ptr<Node> right;
+      Split(std::move(this->root), _iter->first, false, left, right);
+      this->root = Merge(Merge(std::move(left), std::move(node)),
+          std::move(right));
+    }
+
+    //////////////////////////////////////////////////
+    template <class Iter>
+    void BaseStorageIndex<Iter>::Erase(const std::string &_key)
+    {
+      std::unique_ptr<Node> left;
+      std::unique_ptr<Node> rest;
+      std::unique_ptr<Node> match;
+      std::unique_ptr<Node> right;
+      Split(std::move(this->root), _key, false, left, rest);
+      Split(std::move(rest), _key, true, match, right);
+      this->root = Merge(std::move(left), std::move(right));
+    }
+
+    //////////////////////////////////////////////////
+    template <class Iter>
+    void BaseStorageIndex<Iter>::Clear()
+    {
+      this->root.reset();
+    }
+
+    //////////////////////////////////////////////////
+    template <class Iter>
+    Iter BaseStorageIndex<Iter>::At(std::size_t _index) const
+    {
+      const Node *node = this->root.get();
+      while (node)
+      {
+        std::size_t leftSize = Size(node->left);
+        if (_index < leftSize)
+        {
+          node = node->left.get();
+        }
+        else if (_index == leftSize)
+        {
+          return node->iter;
+        }
+        else
+        {
+          _index -= leftSize + 1u;
+          node = node->right.get();
+        }
+      }
+      return Iter();
+    }
+
+    //////////////////////////////////////////////////
+    template <class Iter>
+    std::size_t BaseStorageIndex<Iter>::Size(
+        const std::unique_ptr<Node> &_node)
+    {
+      return _node ? _node->size : 0u;
+    }
+
+    //////////////////////////////////////////////////
+    template <class Iter>
+    void BaseStorageIndex<Iter>::Update(Node *_node)
+    {
+      _node->size = Size(_node->left) + Size(_node->right) + 1u;
+    }
+
+    //////////////////////////////////////////////////
+    template <class Iter>
+    void BaseStorageIndex<Iter>::Split(std::unique_ptr<Node> _node,
+        const std::string &_key, bool _inclusive,
+        std::unique_ptr<Node> &_left, std::unique_ptr<Node> &_right)
+    {
+      if (!_node)
+      {
+        _left.reset();
+        _right.reset();
+        return;
+      }
+
+      const std::string &key = _node->iter->first;
+      bool before = _inclusive ? !(_key < key) : key < _key;
+      if (before)
+      {
+        std::unique_ptr<Node> right;
+        Split(std::move(_node->right), _key, _inclusive, _node->right, right);
+        Update(_node.get());
+        _left = std::move(_node);
+        _right = std::move(right);
+      }
+      else
+      {
+        std::unique_ptr<Node> left;
+        Split(std::move(_node->left), _key, _inclusive, left, _node->left);
+        Update(_node.get());
+        _left = std::move(left);
+        _right = std::move(_node);
+      }
+    }
+
+    //////////////////////////////////////////////////
+    template <class Iter>
+    std::unique_ptr<typename BaseStorageIndex<Iter>::Node>
+    BaseStorageIndex<Iter>::Merge(std::unique_ptr<Node> _left,
+        std::unique_ptr<Node> _right)
+    {
+      if (!_left)
+        return _right;
+      if (!_right)
+        return _left;
+
+      if (_left->priority > _right->priority)
+      {
+        _left->right = Merge(std::move(_left->right), std::move(_right));
+        Update(_left.get());
+        return _left;
+      }
+
+      _right->left = Merge(std::move(_left), std::move(_right->left));
+      Update(_right.get());
+      return _right;
+    }
+
     //////////////////////////////////////////////////
     template <class T, class U>
     BaseMap<T, U>::BaseMap()
@@ -409,7 +659,7 @@ namespace gz
     template <class T, class U>
     bool BaseMap<T, U>::ContainsKey(const std::string &_key) const
     {
-      return this->map.count(_key) > 0;
+      return this->keyIndex.count(_key) > 0;
     }
 
     //////////////////////////////////////////////////
@@ -472,7 +722,10 @@ namespace gz
         return false;
       }
 
-      this->map[_key] = derived;
+      UIter iter = this->map.emplace(_key, derived).first;
+      this->keyIndex[_key] = iter;
+      this->orderIndex.Insert(iter);
+
       return true;
     }
 
@@ -480,11 +733,11 @@ namespace gz
     template <class T, class U>
     void BaseMap<T, U>::Remove(const std::string &_key)
     {
-      auto iter = this->map.find(_key);
+      auto iter = this->keyIndex.find(_key);
 
-      if (this->IsValidIter(iter))
+      if (iter != this->keyIndex.end())
       {
-        this->map.erase(iter);
+        this->EraseImpl(iter->second);
       }
     }
 
@@ -498,7 +751,7 @@ namespace gz
       {
         if (iter->second == _value)
         {
-          this->map.erase(iter);
+          iter = this->EraseImpl(iter);
           continue;
         }
 
@@ -511,6 +764,8 @@ namespace gz
     void BaseMap<T, U>::RemoveAll()
     {
       this->map.clear();
+      this->keyIndex.clear();
+      this->orderIndex.Clear();
     }
 
     //////////////////////////////////////////////////
@@ -518,8 +773,8 @@ namespace gz
     typename BaseMap<T, U>::UPtr
     BaseMap<T, U>::Derived(const std::string &_key) const
     {
-      auto iter = this->map.find(_key);
-      return (this->IsValidIter(iter)) ? iter->second : nullptr;
+      auto iter = this->keyIndex.find(_key);
+      return (iter != this->keyIndex.end()) ? iter->second->second : nullptr;
     }
 
     //////////////////////////////////////////////////
@@ -533,9 +788,7 @@ namespace gz
         return nullptr;
       }
 
-      auto iter = this->map.begin();
-      std::advance(iter, _index);
-      return iter->second;
+      return this->orderIndex.At(_index)->second;
     }
 
     //////////////////////////////////////////////////
@@ -545,6 +798,16 @@ namespace gz
       return _iter != this->map.end();
     }
 
+    //////////////////////////////////////////////////
+    template <class T, class U>
+    typename BaseMap<T, U>::UIter
+    BaseMap<T, U>::EraseImpl(UIter _iter)
+    {
+      this->orderIndex.Erase(_iter->first);
+      this->keyIndex.erase(_iter->first);
+      return this->map.erase(_iter);
+    }
+
     //////////////////////////////////////////////////
     template <class T, class U>
     BaseStore<T, U>::BaseStore()
@@ -689,6 +952,9 @@ namespace gz
     void BaseStore<T, U>::RemoveAll()
     {
       this->store.clear();
+      this->nameIndex.clear();
+      this->idIndex.clear();
+      this->orderIndex.Clear();
     }
 
     //////////////////////////////////////////////////
@@ -816,18 +1082,16 @@ namespace gz
     typename BaseStore<T, U>::ConstUIter
     BaseStore<T, U>::ConstIter(ConstTPtr _object) const
     {
-      auto begin = this->store.begin();
-      auto end = this->store.end();
+      if (!_object)
+        return this->store.end();
 
-      for (auto iter = begin; iter != end; ++iter)
-      {
-        if (iter->second == _object)
-        {
-          return iter;
-        }
-      }
+      // object names are unique within a store so look the object up by
+      // name and make sure it is the same instance
+      auto iter = this->ConstIterByName(_object->Name());
+      if (this->IsValidIter(iter) && iter->second == _object)
+        return iter;
 
-      return end;
+      return this->store.end();
     }
 
     //////////////////////////////////////////////////
@@ -835,18 +1099,10 @@ namespace gz
     typename BaseStore<T, U>::ConstUIter
     BaseStore<T, U>::ConstIterById(unsigned int _id) const
     {
-      auto begin = this->store.begin();
-      auto end = this->store.end();
-
-      for (auto iter = begin; iter != end; ++iter)
-      {
-        if (iter->second->Id() == _id)
-        {
-          return iter;
-        }
-      }
-
-      return end;
+      auto iter = this->idIndex.find(_id);
+      if (iter == this->idIndex.end())
+        return this->store.end();
+      return iter->second;
     }
 
     //////////////////////////////////////////////////
@@ -854,7 +1110,10 @@ namespace gz
     typename BaseStore<T, U>::ConstUIter
     BaseStore<T, U>::ConstIterByName(const std::string &_name) const
     {
-      return this->store.find(_name);
+      auto iter = this->nameIndex.find(_name);
+      if (iter == this->nameIndex.end())
+        return this->store.end();
+      return iter->second;
     }
 
     //////////////////////////////////////////////////
@@ -868,9 +1127,7 @@ namespace gz
         return this->store.end();
       }
 
-      auto iter = this->store.begin();
-      std::advance(iter, _index);
-      return iter;
+      return this->orderIndex.At(_index);
     }
 
     //////////////////////////////////////////////////
@@ -929,7 +1186,11 @@ namespace gz
         return false;
       }
 
-      this->store[name] = _object;
+      UIter iter = this->store.emplace(name, _object).first;
+      this->nameIndex[name] = iter;
+      this->idIndex[id] = iter;
+      this->orderIndex.Insert(iter);
+
       return true;
     }
 
@@ -944,6 +1205,9 @@ namespace gz
       }
 
       UPtr result = _iter->second;
+      this->orderIndex.Erase(_iter->first);
+      this->nameIndex.erase(_iter->first);
+      this->idIndex.erase(result->Id());
       this->store.erase(_iter);
       return result;
     }
@@ -972,6 +1236,7 @@ namespace gz
           this->store.erase(_iter, _iter) : this->store.end();
     }
 
+
     //////////////////////////////////////////////////
     template <class T>
     BaseCompositeStore<T>::BaseCompositeStore()
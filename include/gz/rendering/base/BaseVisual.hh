@@ -44,8 +44,6 @@ namespace gz
 
       public: virtual math::Pose3d LocalPose() const override;
 
-      public: virtual void SetLocalPose(const math::Pose3d &_pose) override;
-
       public: virtual unsigned int GeometryCount() const override;
 
       public: virtual bool HasGeometry(ConstGeometryPtr _geometry) const
@@ -118,6 +116,10 @@ namespace gz
       public: virtual VisualPtr Clone(const std::string &_name,
                   NodePtr _newParent) const override;
 
+      // Documentation inherited.
+      protected: virtual bool ComputeRawLocalPose(const math::Pose3d &_pose,
+                     math::Pose3d &_rawPose) override;
+
       protected: virtual void PreRenderChildren() override;
 
       protected: virtual void PreRenderGeometries();
@@ -165,20 +167,20 @@ namespace gz
 
     //////////////////////////////////////////////////
     template <class T>
-    void BaseVisual<T>::SetLocalPose(const math::Pose3d &_pose)
+    bool BaseVisual<T>::ComputeRawLocalPose(const math::Pose3d &_pose,
+        math::Pose3d &_rawPose)
     {
-      math::Pose3d rawPose = _pose;
+      _rawPose = _pose;
       math::Vector3d scale = this->LocalScale();
-      rawPose.Pos() -= rawPose.Rot() * (scale * this->origin);
+      _rawPose.Pos() -= _rawPose.Rot() * (scale * this->origin);
 
-      if (!rawPose.IsFinite())
+      if (!_rawPose.IsFinite())
       {
         gzerr << "Unable to set pose of a node: "
                << "non-finite (nan, inf) values detected." << std::endl;
-        return;
+        return false;
       }
-
-      this->SetRawLocalPose(rawPose);
+      return true;
     }
 
     //////////////////////////////////////////////////
@@ -246,6 +246,7 @@ void OgreNode::SetInheritScale(bool _inherit)
     return;
 
   this->ogreNode->setInheritScale(_inherit);
+  this->MarkWorldTransformDirty();
 }
 
 //////////////////////////////////////////////////
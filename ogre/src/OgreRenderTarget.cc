@@ -96,7 +96,9 @@ void OgreRenderTarget::Copy(Image &_image) const
         this->width, this->height, 1, imageFormat, data);
     this->RenderTarget()->copyContentsToMemory(ogrePixelBox);
     // convert color image to bayer image
-    _image = gz::rendering::convertRGBToBayer(colorImage, _image.Format());
+    gz::rendering::convertRGBToBayer(colorImage.Data<unsigned char>(),
+        this->width, this->height, _image.Format(),
+        _image.Data<unsigned char>());
   }
   else
   {
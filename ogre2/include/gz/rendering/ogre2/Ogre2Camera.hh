@@ -18,6 +18,7 @@
 #define GZ_RENDERING_OGRE2_OGRE2CAMERA_HH_
 
 #include <memory>
+#include <vector>
 
 #include "gz/rendering/base/BaseCamera.hh"
 #include "gz/rendering/ogre2/Ogre2RenderTypes.hh"
@@ -115,6 +116,15 @@ namespace gz
       public: virtual VisualPtr VisualAt(const gz::math::Vector2i
                   &_mousePos) override;
 
+      // Documentation inherited.
+      public: virtual std::vector<VisualAreaResult> VisualsInRectangle(
+                  const gz::math::Vector2i &_min,
+                  const gz::math::Vector2i &_max) override;
+
+      // Documentation inherited.
+      public: virtual std::vector<VisualAreaResult> VisualsInPolygon(
+                  const std::vector<gz::math::Vector2i> &_polygon) override;
+
       // Documentation Inherited.
       // \sa Camera::SetMaterial(const MaterialPtr &)
       public: virtual void SetMaterial(
@@ -140,6 +150,21 @@ namespace gz
       /// \return the selection buffer object
       public: Ogre2SelectionBuffer *SelectionBuffer() const;
 
+      /// \brief Set whether the selection buffer used by VisualAt and ray
+      /// queries renders the whole camera view once per frame and answers
+      /// all queries of that frame from one read back, instead of rendering
+      /// a 1x1 buffer for every query. Enable when many pixels are queried
+      /// per frame, e.g. for hover highlighting. Disabled by default.
+      /// \param[in] _fullFrame True to render the whole camera view
+      /// \sa Ogre2SelectionBuffer::SetFullFrame
+      public: void SetSelectionBufferFullFrame(bool _fullFrame);
+
+      /// \brief Get whether the selection buffer renders the whole camera
+      /// view
+      /// \return True if the selection buffer is in full frame mode
+      /// \sa SetSelectionBufferFullFrame
+      public: bool SelectionBufferFullFrame() const;
+
       // Documentation inherited.
       public: virtual Ogre::Camera *OgreCamera() const override;
 
@@ -163,6 +188,22 @@ namespace gz
       /// \brief Create internal camera object
       private: void CreateCamera();
 
+      /// \brief Create the selection buffer if needed and match its size to
+      /// the camera image
+      /// \return False if the selection buffer could not be created
+      private: bool UpdateSelectionBuffer();
+
+      /// \brief Get the visuals seen in an area of the image
+      /// \param[in] _min Top left corner of the area in pixels
+      /// \param[in] _max Bottom right corner of the area in pixels
+      /// \param[in] _polygon Polygon restricting the area, in pixels. Empty
+      /// to use the whole rectangle.
+      /// \return Visuals seen in the area, closest first
+      private: std::vector<VisualAreaResult> VisualsInArea(
+                   const gz::math::Vector2i &_min,
+                   const gz::math::Vector2i &_max,
+                   const std::vector<gz::math::Vector2i> &_polygon);
+
       /// \brief Notifies us that the shadow node definition is about to be
       /// updated. This means our compositor workspace must be destroyed
       /// because the shadow node definition it's using will become a
@@ -85,7 +85,9 @@ namespace gz
       /// \brief Render the camera
       public: virtual void PostRender() override;
 
-      /// \brief All things needed to get back z buffer for depth data
+      /// \brief All things needed to get back z buffer for depth data.
+      /// Not updated while only depth data is read back, see
+      /// SetDepthOnlyReadback.
       /// \return The z-buffer as a float array
       public: virtual const float *DepthData() const override;
 
@@ -103,6 +105,25 @@ namespace gz
           std::function<void(const float *, unsigned int, unsigned int,
           unsigned int, const std::string &)>  _subscriber) override;
 
+      // Documentation inherited.
+      public: virtual void SetReadbackLatency(unsigned int _frames) override;
+
+      // Documentation inherited.
+      public: virtual unsigned int ReadbackLatency() const override;
+
+      /// \brief Allow the camera to render and read back only depth data
+      /// when there are subscribers to ConnectNewDepthFrame but none to
+      /// ConnectNewRgbPointCloud. A single channel texture is then
+      /// transferred instead of the xyz and color channels, but DepthData
+      /// is not updated. Disabled by default.
+      /// \param[in] _enabled True to allow depth only readback
+      public: void SetDepthOnlyReadback(bool _enabled);
+
+      /// \brief Get whether the camera may read back only depth data
+      /// \return True if depth only readback is allowed
+      /// \sa SetDepthOnlyReadback
+      public: bool DepthOnlyReadback() const;
+
       /// \brief Implementation of the render call
       public: virtual void Render() override;
 
@@ -17,6 +17,7 @@
 #ifndef GZ_RENDERING_OGRE2_OGRE2DYNAMICRENDERABLE_HH_
 #define GZ_RENDERING_OGRE2_OGRE2DYNAMICRENDERABLE_HH_
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -89,6 +90,28 @@ namespace gz
       public: void AddPoint(const double _x, const double _y, const double _z,
             const gz::math::Color &_color = gz::math::Color::White);
 
+      /// \brief Replace all points with points read from packed float
+      /// arrays. The positions are written straight into the layout of the
+      /// vertex buffer, which is much faster than adding points one by one
+      /// for large point sets such as point clouds.
+      /// \param[in] _xyz Point positions, 3 floats per point
+      /// \param[in] _rgba Point colors, 4 floats per point. Null to make all
+      /// points white.
+      /// \param[in] _count Number of points
+      /// \param[in] _borrow True to read the arrays on the next Update
+      /// instead of copying them now. The arrays must then stay valid and
+      /// unchanged until Update is called.
+      public: void SetPoints(const float *_xyz, const float *_rgba,
+                  std::size_t _count, bool _borrow = false);
+
+      /// \brief Replace all points, taking ownership of the arrays. The
+      /// points are copied into the vertex buffer layout on the next Update.
+      /// \param[in] _xyz Point positions, 3 floats per point
+      /// \param[in] _rgba Point colors, 4 floats per point. Empty to make all
+      /// points white.
+      public: void SetPoints(std::vector<float> &&_xyz,
+                  std::vector<float> &&_rgba);
+
       /// \brief Change the location of an existing point in the point list
       /// \param[in] _index Index of the point to set
       /// \param[in] _value Position of the point
@@ -127,23 +150,30 @@ namespace gz
       /// \brief Create the dynamic mesh
       private: void CreateDynamicMesh();
 
-      /// \brief Update vertex buffer if vertices have changes
+      /// \brief Update vertex buffer if vertices have changes. Only the
+      /// vertices that changed since the last update are uploaded.
       private: void UpdateBuffer();
 
       /// \brief Helper function to generate normals
       /// \param[in] _opType Ogre render operation type
-      /// \param[in] _vertices a list of vertices
+      /// \param[in] _vertexCount Number of vertices
       /// \param[in,out] _vbuffer vertex buffer to be filled
+      /// \param[in,out] _begin First vertex that changed. Set to the first
+      /// vertex whose normal was written.
+      /// \param[in,out] _end One past the last vertex that changed. Set to
+      /// one past the last vertex whose normal was written.
       private: void GenerateNormals(Ogre::OperationType _opType,
-          const std::vector<math::Vector3d> &_vertices, float *_vbuffer);
+          unsigned int _vertexCount, float *_vbuffer,
+          unsigned int &_begin, unsigned int &_end);
 
       /// \brief Helper function to generate colors per-vertex. Only applies
       /// to points. The colors fill the normal slots on the vertex buffer.
       /// \param[in] _opType Ogre render operation type
-      /// \param[in] _vertices a list of vertices
       /// \param[in,out] _vbuffer vertex buffer to be filled
+      /// \param[in] _begin First vertex to fill
+      /// \param[in] _end One past the last vertex to fill
       private: void GenerateColors(Ogre::OperationType _opType,
-          const std::vector<math::Vector3d> &_vertices, float *_vbuffer);
+          float *_vbuffer, unsigned int _begin, unsigned int _end);
 
       /// \brief Destroy the vertex buffer
       private: void DestroyBuffer();
@@ -92,6 +92,15 @@ namespace gz
       // Documentation inherited.
       public: virtual void Copy(float *_data) override;
 
+      // Documentation inherited.
+      public: virtual void SetOutputBuffer(float *_buffer) override;
+
+      // Documentation inherited.
+      public: virtual float *OutputBuffer() const override;
+
+      // Documentation inherited.
+      public: virtual void SetChannels(unsigned int _channels) override;
+
       // Documentation inherited.
       public: virtual common::ConnectionPtr ConnectNewGpuRaysFrame(
                   std::function<void(const float *_frame, unsigned int _width,
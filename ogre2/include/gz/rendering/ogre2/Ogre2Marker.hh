@@ -18,7 +18,10 @@
 #ifndef GZ_RENDERING_OGRE2_OGREMARKER_HH_
 #define GZ_RENDERING_OGRE2_OGREMARKER_HH_
 
+#include <cstddef>
 #include <memory>
+#include <vector>
+
 #include "gz/rendering/base/BaseMarker.hh"
 #include "gz/rendering/ogre2/Ogre2Geometry.hh"
 
@@ -68,6 +71,14 @@ namespace gz
       public: virtual void AddPoint(const gz::math::Vector3d &_pt,
                            const gz::math::Color &_color) override;
 
+      // Documentation inherited
+      public: virtual void SetPoints(const float *_xyz, const float *_rgba,
+                           std::size_t _count, bool _borrow = false) override;
+
+      // Documentation inherited
+      public: virtual void SetPoints(std::vector<float> &&_xyz,
+                           std::vector<float> &&_rgba) override;
+
       // Documentation inherited
       public: virtual void ClearPoints() override;
 
@@ -64,6 +64,10 @@ namespace gz
       // Documentation inherited.
       public: virtual void SetInheritScale(bool _inherit) override;
 
+      // Documentation inherited.
+      public: virtual void SetUserData(const std::string &_key,
+                  Variant _value) override;
+
       // Documentation inherited.
       protected: virtual void SetLocalScaleImpl(
                      const math::Vector3d &_scale) override;
@@ -126,6 +130,10 @@ namespace gz
 
       // TODO(anyone): remove the need for a visual friend class
       private: friend class Ogre2Visual;
+
+      /// \brief Make ogre scene our friend so it is able to update the
+      /// poses of many nodes at once
+      private: friend class Ogre2Scene;
     };
     }
   }
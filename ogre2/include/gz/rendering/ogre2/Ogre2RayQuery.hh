@@ -18,6 +18,7 @@
 #define GZ_RENDERING_OGRE2_OGRE2RAYQUERY_HH_
 
 #include <memory>
+#include <vector>
 
 #include "gz/rendering/base/BaseRayQuery.hh"
 #include "gz/rendering/ogre2/Ogre2Object.hh"
@@ -52,6 +53,21 @@ namespace gz
       public: virtual RayQueryResult ClosestPoint(
             bool _forceSceneUpdate = true);
 
+      /// \brief Compute the closest intersection of many rays in one call.
+      /// Rays are always tested on the CPU by ray triangle intersection,
+      /// even if the query was set up from a camera. The mesh items in the
+      /// scene are collected once and large batches are split across
+      /// worker threads.
+      /// \param[in] _origins Ray origins
+      /// \param[in] _directions Ray directions
+      /// \param[in] _forceSceneUpdate True to update the scene graph once
+      /// before testing the rays
+      /// \return One result per ray
+      public: virtual std::vector<RayQueryResult> ClosestPoints(
+            const std::vector<math::Vector3d> &_origins,
+            const std::vector<math::Vector3d> &_directions,
+            bool _forceSceneUpdate = true) override;
+
       /// \brief Get closest point by selection buffer.
       /// This is executed on the GPU.
       private: RayQueryResult ClosestPointBySelectionBuffer();
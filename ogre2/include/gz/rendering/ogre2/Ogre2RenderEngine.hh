@@ -224,6 +224,30 @@ namespace gz
       public: Ogre::CompositorWorkspaceListener
           *TerraWorkspaceListener() const;
 
+      /// \internal
+      /// \brief Get the directory of the on-disk mesh cache, set with the
+      /// "meshCachePath" engine parameter. Meshes loaded from files are
+      /// stored there in GPU ready form so later runs can skip building them.
+      /// \return Cache directory or an empty string if caching is disabled
+      public: std::string MeshCachePath() const;
+
+      /// \internal
+      /// \brief Check if meshes are built with compact vertex and index
+      /// formats, set with the "compactMeshes" engine parameter. Compact
+      /// meshes use 16 bit indices where possible and pack normals and
+      /// tangents into QTangents.
+      /// \return True if compact formats are used
+      public: bool CompactMeshes() const;
+
+      /// \internal
+      /// \brief Get the directory of the persistent shader cache, set with
+      /// the "shaderCachePath" engine parameter. The shaders generated by the
+      /// Hlms and their compiled microcode are saved there when the engine is
+      /// destroyed and restored on the next start. Entries are only used by
+      /// the same engine version, render system and GPU driver.
+      /// \return Cache directory or an empty string if caching is disabled
+      public: std::string ShaderCachePath() const;
+
       /// \brief Get a pointer to the render engine
       /// \todo(anyone) Remove inheritance from Singleton base class
       /// \return a pointer to the render engine
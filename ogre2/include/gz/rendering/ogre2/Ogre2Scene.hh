@@ -17,6 +17,8 @@
 #ifndef GZ_RENDERING_OGRE2_OGRE2SCENE_HH_
 #define GZ_RENDERING_OGRE2_OGRE2SCENE_HH_
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -109,6 +111,13 @@ namespace gz
       // Documentation inherited.
       public: virtual bool LegacyAutoGpuFlush() const override;
 
+      // Documentation inherited.
+      // Poses are written straight into the ogre scene nodes, from multiple
+      // threads if _parallel is true.
+      public: virtual std::size_t SetNodeLocalPoses(const unsigned int *_ids,
+                  const math::Pose3d *_poses, std::size_t _count,
+                  bool _parallel = false) override;
+
       /// \brief Get a pointer to the ogre scene manager
       /// \return Pointer to the ogre scene manager
       public: virtual Ogre::SceneManager *OgreSceneManager() const;
@@ -191,6 +200,29 @@ namespace gz
       /// \return True if the number of shadow casting lights changed
       /// \sa ShadowsDirty
       public: bool ShadowsDirty() const;
+
+      /// \internal
+      /// \brief Mark the visual state read by sensor material switchers
+      /// (e.g. thermal and segmentation cameras) as changed. This is called
+      /// when user data is set or when nodes and geometries are attached or
+      /// detached, so switchers can keep per item state across frames.
+      /// \sa SensorStateVersion
+      public: void SetSensorStateDirty();
+
+      /// \internal
+      /// \brief Get the version of the visual state read by sensor material
+      /// switchers. It is incremented every time the state is marked dirty.
+      /// \return Sensor state version
+      /// \sa SetSensorStateDirty
+      public: uint64_t SensorStateVersion() const;
+
+      /// \internal
+      /// \brief Get the number of frames started on this scene, i.e. the
+      /// number of calls to PreRender, or of camera renders when in legacy
+      /// mode. Used to tell whether data read back from the GPU is still
+      /// valid.
+      /// \return Frame number
+      public: uint64_t FrameNumber() const;
       /// \endcond
 
       // Documentation inherited
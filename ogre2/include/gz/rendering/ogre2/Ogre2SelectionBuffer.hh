@@ -19,8 +19,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+
+#include <gz/math/Vector2.hh>
 
 #include "gz/rendering/config.hh"
+#include "gz/rendering/Camera.hh"
 #include "gz/rendering/ogre2/Export.hh"
 
 namespace Ogre
@@ -44,6 +48,9 @@ namespace gz
     /// color is assigned to each entity. Whenever a selection request is made,
     /// the selection buffer camera renders to a 1x1 sized offscreen buffer.
     /// The color value of that pixel gives the identity of the entity.
+    /// In full frame mode, the whole camera view is rendered once per frame
+    /// instead and all queries made during that frame are answered from one
+    /// read back.
     class GZ_RENDERING_OGRE2_VISIBLE Ogre2SelectionBuffer
     {
       /// \brief Constructor
@@ -75,6 +82,24 @@ namespace gz
       public: bool ExecuteQuery(const int _x, const int _y, Ogre::Item *&_item,
           math::Vector3d &_point);
 
+      /// \brief Get the visuals seen in an area of the camera view. The
+      /// whole view is rendered once and the area is read from the copy kept
+      /// on the CPU, as in full frame mode. The mode used by point queries
+      /// is not changed.
+      /// \param[in] _min Top left corner of the area in pixels
+      /// \param[in] _max Bottom right corner of the area in pixels. The area
+      /// includes both corners.
+      /// \param[in] _polygon Optional polygon, in pixels, restricting the
+      /// area to the pixels whose centers are inside it. Empty to use the
+      /// whole rectangle.
+      /// \param[out] _results Visuals seen in the area, closest first
+      /// \return True if the query was executed, false otherwise
+      /// \sa SetFullFrame
+      public: bool ExecuteAreaQuery(const math::Vector2i &_min,
+          const math::Vector2i &_max,
+          const std::vector<math::Vector2i> &_polygon,
+          std::vector<VisualAreaResult> &_results);
+
       /// \brief Set dimension of the selection buffer
       /// \param[in] _width X dimension in pixels.
       /// \param[in] _height Y dimension in pixels.
@@ -83,6 +108,26 @@ namespace gz
       /// \brief Call this to update the selection buffer contents
       public: void Update();
 
+      /// \brief Set whether to render the whole camera view into the
+      /// selection buffer. When enabled, the first query made in a frame
+      /// renders the selection buffer at the camera resolution and copies it
+      /// to the CPU. Later queries are answered from that copy until the
+      /// scene starts a new frame, the scene graph changes or the camera
+      /// moves. This costs one render per frame instead of one per query,
+      /// which pays off when many pixels are queried, e.g. for hover
+      /// highlighting. Disabled by default.
+      /// \param[in] _fullFrame True to enable full frame mode
+      public: void SetFullFrame(bool _fullFrame);
+
+      /// \brief Get whether the whole camera view is rendered into the
+      /// selection buffer
+      /// \return True if full frame mode is enabled
+      /// \sa SetFullFrame
+      public: bool FullFrame() const;
+
+      /// \brief Render the whole camera view and copy it to the CPU
+      private: void UpdateFullFrame();
+
       /// \brief Delete the render texture
       private: void DeleteRTTBuffer();
 
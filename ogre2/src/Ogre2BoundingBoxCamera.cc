@@ -15,7 +15,11 @@
  *
  */
 
+#include <algorithm>
+#include <array>
 #include <limits>
+#include <memory>
+#include <unordered_map>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -27,6 +31,7 @@
 #endif
 
 #include <gz/common/Console.hh>
+#include <gz/common/WorkerPool.hh>
 
 #include <gz/math/Color.hh>
 #include <gz/math/Vector4.hh>
@@ -46,12 +51,152 @@
 #include "gz/rendering/ogre2/Ogre2Visual.hh"
 
 #include "Ogre2BoundingBoxMaterialSwitcher.hh"
+#include "Ogre2TextureReadback.hh"
 
 using namespace gz;
 using namespace rendering;
 
+/// \brief Min number of pixels in a band of the id image. Each band is
+/// scanned by one worker when extracting the visible boxes.
+static const uint32_t kPixelsPerThread = 65536u;
+
+/// \brief Label and pixel space bounds of an item in the id image
+struct PixelBounds
+{
+  /// \brief Label of the first pixel of the item in row major order
+  uint32_t label;
+
+  /// \brief Min x pixel coordinate
+  uint32_t minX;
+
+  /// \brief Min y pixel coordinate
+  uint32_t minY;
+
+  /// \brief Max x pixel coordinate
+  uint32_t maxX;
+
+  /// \brief Max y pixel coordinate
+  uint32_t maxY;
+};
+
+/// \brief Reduce the id image to the label and pixel bounds of every
+/// visible item. The image is split in bands of rows that are scanned in
+/// parallel, each into its own map, and the maps are merged in band order
+/// so the label of an item is the one of its first pixel.
+/// \param[in] _buffer RGBA id image. Blue holds the label and red, green
+/// and alpha hold the low, middle and high bytes of the ogre id.
+/// \param[in] _width Image width
+/// \param[in] _height Image height
+/// \param[in] _backgroundLabel Label of pixels not covered by any item
+/// \param[in,out] _pool Workers scanning the bands. Created the first time
+/// the image is large enough to be split and kept for the next frames.
+/// \return Bounds of the visible items, keyed by ogre id
+static std::unordered_map<uint32_t, PixelBounds> visiblePixelBounds(
+    const uint8_t *_buffer, uint32_t _width, uint32_t _height,
+    uint32_t _backgroundLabel, std::unique_ptr<common::WorkerPool> &_pool)
+{
+  // the band count only depends on the image size so the result does not
+  // depend on the number of cores
+  const uint32_t threadCount = std::max(1u, std::min(_height,
+      _width * _height / kPixelsPerThread));
+  const uint32_t rowsPerThread = (_height + threadCount - 1) / threadCount;
+
+  std::vector<std::unordered_map<uint32_t, PixelBounds>> bands(threadCount);
+  auto scanRows = [&](uint32_t _t)
+  {
+    auto &bounds = bands[_t];
+    const uint32_t rowStart = _t * rowsPerThread;
+    const uint32_t rowEnd = std::min(_height, rowStart + rowsPerThread);
+
+    // items usually cover runs of pixels, so remember the last item to
+    // skip most of the map lookups
+    uint32_t lastId = 0;
+    PixelBounds *last = nullptr;
+    for (uint32_t y = rowStart; y < rowEnd; ++y)
+    {
+      const uint8_t *row = _buffer + static_cast<size_t>(y) * _width * 4u;
+      for (uint32_t x = 0; x < _width; ++x)
+      {
+        const uint8_t *pixel = row + x * 4u;
+        const uint32_t label = pixel[2];
+        if (label == _backgroundLabel)
+          continue;
+
+        const uint32_t ogreId = pixel[0] | (pixel[1] << 8) | (pixel[3] << 16);
+        if (!last || ogreId != lastId)
+        {
+          auto inserted = bounds.emplace(ogreId,
+              PixelBounds{label, x, y, x, y});
+          last = &inserted.first->second;
+          lastId = ogreId;
+        }
+        last->minX = std::min(last->minX, x);
+        last->minY = std::min(last->minY, y);
+        last->maxX = std::max(last->maxX, x);
+        last->maxY = std::max(last->maxY, y);
+      }
+    }
+  };
+
+  if (threadCount > 1u && !_pool)
+    _pool = std::make_unique<common::WorkerPool>();
+  for (uint32_t t = 1; t < threadCount; ++t)
+    _pool->AddWork([&scanRows, t]() { scanRows(t); });
+  scanRows(0u);
+  if (threadCount > 1u)
+    _pool->WaitForResults();
+
+  // merge the bands in order
+  std::unordered_map<uint32_t, PixelBounds> result = std::move(bands[0]);
+  for (uint32_t t = 1; t < threadCount; ++t)
+  {
+    for (const auto &band : bands[t])
+    {
+      auto inserted = result.emplace(band.first, band.second);
+      if (inserted.second)
+        continue;
+      PixelBounds &bounds = inserted.first->second;
+      bounds.minX = std::min(bounds.minX, band.second.minX);
+      bounds.minY = std::min(bounds.minY, band.second.minY);
+      bounds.maxX = std::max(bounds.maxX, band.second.maxX);
+      bounds.maxY = std::max(bounds.maxY, band.second.maxY);
+    }
+  }
+  return result;
+}
+
 class gz::rendering::Ogre2BoundingBoxCameraPrivate
 {
+  /// \brief Vertex positions of a mesh in mesh local space, stored as
+  /// separate x, y and z arrays so they can be transformed in batches.
+  public: struct MeshPositions
+  {
+    /// \brief All vertex positions, in vertex buffer order
+    std::array<std::vector<float>, 3> all;
+
+    /// \brief Positions with duplicates removed. Enough to find the extent
+    /// of the projected mesh, and usually much smaller since vertices are
+    /// split along normal and texture seams.
+    std::array<std::vector<float>, 3> unique;
+
+    /// \brief True if all position buffers of the mesh are immutable, in
+    /// which case the positions are kept across frames. Dynamic buffers,
+    /// e.g. the ones of dynamic renderables, are rewritten in place without
+    /// changing the mesh handle, so their positions are read every frame.
+    bool cacheable = true;
+  };
+
+  /// \brief Get the vertex positions of a mesh. They are read back from the
+  /// GPU the first time the mesh is seen in a frame, and cached across
+  /// frames if the mesh vertex buffers are immutable.
+  /// \param[in] _mesh Mesh to get the positions of
+  /// \return Cached positions of the mesh
+  public: const MeshPositions &Positions(const Ogre::MeshPtr &_mesh);
+
+  /// \brief Remove the cached positions of meshes that no longer exist and
+  /// of meshes with dynamic vertex buffers
+  public: void EvictPositions();
+
   /// \brief Merge a vector of 2D boxes. Used in multi-links model.
   /// \param[in] _boxes Vector of 2D boxes
   /// \return Merged bounding box
@@ -122,6 +267,9 @@ class gz::rendering::Ogre2BoundingBoxCameraPrivate
   /// \brief Texture to create the render texture from.
   public: Ogre::TextureGpu *ogreRenderTexture {nullptr};
 
+  /// \brief Reads the render texture back to the CPU
+  public: Ogre2TextureReadback readback;
+
   /// \brief Buffer to store render texture data & to be sent to listeners
   public: uint8_t *buffer = nullptr;
 
@@ -157,6 +305,11 @@ class gz::rendering::Ogre2BoundingBoxCameraPrivate
   /// Key: ogre id, value: vector of it's 3d vertices(pointcloud or mesh points)
   public: std::map<uint32_t, std::vector<math::Vector3d>> itemVertices;
 
+  /// \brief Cached vertex positions of the meshes seen by the camera
+  /// Key: ogre mesh handle, value: positions in mesh local space
+  public: std::unordered_map<Ogre::ResourceHandle, MeshPositions>
+      meshPositions;
+
   /// \brief Map ogre id to Ogre::Item (used in multi-link models)
   /// Key: ogre id, value: ogre item pointer
   public: std::map<uint32_t, Ogre::Item *> ogreIdToItem;
@@ -167,6 +320,10 @@ class gz::rendering::Ogre2BoundingBoxCameraPrivate
   /// \brief Bounding Box type
   public: BoundingBoxType type {BoundingBoxType::BBT_VISIBLEBOX2D};
 
+  /// \brief Workers scanning the id image, kept across frames so no
+  /// threads are started on every PostRender
+  public: std::unique_ptr<common::WorkerPool> workerPool;
+
   /// \brief Alias variable that's used in the ClipToViewPort and
   /// LocationRelativeToViewPort methods.
   /// Binary representation of 0000
@@ -584,39 +741,20 @@ void Ogre2BoundingBoxCamera::PostRender()
   unsigned int width = this->ImageWidth();
   unsigned int height = this->ImageHeight();
 
-  PixelFormat format = PF_R8G8B8;
-  unsigned int channelCount = PixelUtil::ChannelCount(format);
-  unsigned int bytesPerChannel = PixelUtil::BytesPerChannel(format);
-  // raw gpu texture format is RGBA8
-  unsigned int rawChannelCount = 4u;
-
-  Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->ogreRenderTexture, 0u, 0u);
-  Ogre::TextureBox box = image.getData(0);
-  uint8_t *imgBufferTmp = static_cast<uint8_t *>(box.data);
+  // keep all 4 channels, alpha holds the high byte of the ogre id
+  PixelFormat format = PF_R8G8B8A8;
   if (!this->dataPtr->buffer)
   {
     auto bufferSize = PixelUtil::MemorySize(format, width, height);
     this->dataPtr->buffer = new uint8_t[bufferSize];
   }
 
-  for (unsigned int row = 0; row < height; ++row)
-  {
-    // the texture box step size could be larger than our image buffer step
-    // size
-    unsigned int rawDataRowIdx = row * box.bytesPerRow / bytesPerChannel;
-    for (unsigned int column = 0; column < width; ++column)
-    {
-      unsigned int idx = (row * width * channelCount) +
-          column * channelCount;
-      unsigned int rawIdx = rawDataRowIdx +
-          column * rawChannelCount;
-
-      this->dataPtr->buffer[idx] = imgBufferTmp[rawIdx];
-      this->dataPtr->buffer[idx + 1] = imgBufferTmp[rawIdx + 1];
-      this->dataPtr->buffer[idx + 2] = imgBufferTmp[rawIdx + 2];
-    }
-  }
+  // copy straight from the mapped staging memory into the buffer
+  Ogre::TextureBox box =
+      this->dataPtr->readback.Map(this->dataPtr->ogreRenderTexture);
+  Ogre2TextureReadback::CopyRows(box,
+      static_cast<std::size_t>(width) * 4u, height, this->dataPtr->buffer);
+  this->dataPtr->readback.Unmap();
 
   if (this->dataPtr->type == BoundingBoxType::BBT_VISIBLEBOX2D)
     this->VisibleBoundingBoxes();
@@ -632,6 +770,7 @@ void Ogre2BoundingBoxCamera::PostRender()
   this->dataPtr->itemVertices.clear();
   this->dataPtr->ogreIdToItem.clear();
   this->dataPtr->materialSwitcher->ogreIdName.clear();
+  this->dataPtr->EvictPositions();
 
   this->dataPtr->newBoundingBoxes(this->dataPtr->outputBoxes);
 }
@@ -645,31 +784,164 @@ void Ogre2BoundingBoxCamera::MarkVisibleBoxes()
     return;
   }
 
-  uint32_t width = this->ImageWidth();
-  uint32_t height = this->ImageHeight();
-  uint32_t channelCount = 3;
+  // Filter bounding boxes by reducing the ogre ids map to the visible ids
+  auto visible = visiblePixelBounds(this->dataPtr->buffer,
+      this->ImageWidth(), this->ImageHeight(),
+      this->dataPtr->materialSwitcher->backgroundLabel,
+      this->dataPtr->workerPool);
+
+  // mark the ogreIds as visible not to filter their bbox
+  for (const auto &bounds : visible)
+    this->dataPtr->visibleBoxesLabel[bounds.first] = bounds.second.label;
+}
 
-  // Filter bounding boxes by looping over all pixels in ogre ids map
-  for (uint32_t y = 0; y < height; ++y)
+/// \brief Transform points by a matrix, divide x and y by w and accumulate
+/// the min & max of the result. The loop has no branches and works on
+/// separate coordinate arrays so the compiler can vectorize it.
+/// \param[in] _matrix Transform from point space to clip space
+/// \param[in] _points x, y and z coordinates of the points
+/// \param[in,out] _min Min of the projected x, y and z
+/// \param[in,out] _max Max of the projected x, y and z
+static void projectMinMax(const Ogre::Matrix4 &_matrix,
+    const std::array<std::vector<float>, 3> &_points,
+    Ogre::Vector3 &_min, Ogre::Vector3 &_max)
+{
+  const float m00 = _matrix[0][0], m01 = _matrix[0][1],
+      m02 = _matrix[0][2], m03 = _matrix[0][3];
+  const float m10 = _matrix[1][0], m11 = _matrix[1][1],
+      m12 = _matrix[1][2], m13 = _matrix[1][3];
+  const float m20 = _matrix[2][0], m21 = _matrix[2][1],
+      m22 = _matrix[2][2], m23 = _matrix[2][3];
+  const float m30 = _matrix[3][0], m31 = _matrix[3][1],
+      m32 = _matrix[3][2], m33 = _matrix[3][3];
+
+  const float *px = _points[0].data();
+  const float *py = _points[1].data();
+  const float *pz = _points[2].data();
+  const std::size_t count = _points[0].size();
+
+  float minX = _min.x, minY = _min.y, minZ = _min.z;
+  float maxX = _max.x, maxY = _max.y, maxZ = _max.z;
+  for (std::size_t i = 0; i < count; ++i)
   {
-    for (uint32_t x = 0; x < width; ++x)
-    {
-      auto index = (y * width + x) * channelCount;
+    const float w = m30 * px[i] + m31 * py[i] + m32 * pz[i] + m33;
+    const float invW = 1.0f / w;
+    const float x = (m00 * px[i] + m01 * py[i] + m02 * pz[i] + m03) * invW;
+    const float y = (m10 * px[i] + m11 * py[i] + m12 * pz[i] + m13) * invW;
+    const float z = m20 * px[i] + m21 * py[i] + m22 * pz[i] + m23;
+    minX = std::min(minX, x);
+    minY = std::min(minY, y);
+    minZ = std::min(minZ, z);
+    maxX = std::max(maxX, x);
+    maxY = std::max(maxY, y);
+    maxZ = std::max(maxZ, z);
+  }
+  _min = Ogre::Vector3(minX, minY, minZ);
+  _max = Ogre::Vector3(maxX, maxY, maxZ);
+}
 
-      uint32_t label = this->dataPtr->buffer[index + 2];
+/////////////////////////////////////////////////
+const Ogre2BoundingBoxCameraPrivate::MeshPositions &
+    Ogre2BoundingBoxCameraPrivate::Positions(const Ogre::MeshPtr &_mesh)
+{
+  auto it = this->meshPositions.find(_mesh->getHandle());
+  if (it != this->meshPositions.end())
+    return it->second;
 
-      if (label == this->dataPtr->materialSwitcher->backgroundLabel)
-        continue;
+  MeshPositions &positions = this->meshPositions[_mesh->getHandle()];
+  std::vector<std::array<float, 3>> points;
 
-      // get the ogre id encoded in 16 bit value
-      uint32_t ogreId1 = this->dataPtr->buffer[index + 1];
-      uint32_t ogreId2 = this->dataPtr->buffer[index + 0];
-      uint32_t ogreId = ogreId1 * 256 + ogreId2;
+  for (const auto &subMesh : _mesh->getSubMeshes())
+  {
+    Ogre::VertexArrayObjectArray vaos = subMesh->mVao[0];
+    if (vaos.empty())
+      continue;
+
+    // Get the first LOD level
+    Ogre::VertexArrayObject *vao = vaos[0];
+
+    // request async read from buffer
+    Ogre::VertexArrayObject::ReadRequestsArray requests;
+    requests.push_back(Ogre::VertexArrayObject::ReadRequests(
+      Ogre::VES_POSITION));
+    vao->readRequests(requests);
+    vao->mapAsyncTickets(requests);
+
+    const Ogre::BufferType bufferType =
+        requests[0].vertexBuffer->getBufferType();
+    if (bufferType != Ogre::BT_IMMUTABLE && bufferType != Ogre::BT_DEFAULT)
+      positions.cacheable = false;
+
+    unsigned int subMeshVerticiesNum =
+      requests[0].vertexBuffer->getNumElements();
+    points.reserve(points.size() + subMeshVerticiesNum);
+    for (size_t i = 0; i < subMeshVerticiesNum; ++i)
+    {
+      std::array<float, 3> vec{0.0f, 0.0f, 0.0f};
+      if (requests[0].type == Ogre::VET_HALF4)
+      {
+        const Ogre::uint16* vertex = reinterpret_cast<const Ogre::uint16*>
+          (requests[0].data);
+        vec[0] = Ogre::Bitwise::halfToFloat(vertex[0]);
+        vec[1] = Ogre::Bitwise::halfToFloat(vertex[1]);
+        vec[2] = Ogre::Bitwise::halfToFloat(vertex[2]);
+      }
+      else if (requests[0].type == Ogre::VET_FLOAT3)
+      {
+        const float* vertex =
+          reinterpret_cast<const float*>(requests[0].data);
+        vec[0] = vertex[0];
+        vec[1] = vertex[1];
+        vec[2] = vertex[2];
+      }
+      else
+      {
+        gzerr << "Vertex Buffer type error" << std::endl;
+        break;
+      }
+      points.push_back(vec);
 
-      // mark the ogreId as visible not to filter its bbox
-      if (!this->dataPtr->visibleBoxesLabel.count(ogreId))
-        this->dataPtr->visibleBoxesLabel[ogreId] = label;
+      // get the next element
+      requests[0].data += requests[0].vertexBuffer->getBytesPerElement();
     }
+    vao->unmapAsyncTickets(requests);
+  }
+
+  for (unsigned int c = 0; c < 3u; ++c)
+    positions.all[c].reserve(points.size());
+  for (const auto &p : points)
+  {
+    for (unsigned int c = 0; c < 3u; ++c)
+      positions.all[c].push_back(p[c]);
+  }
+
+  std::sort(points.begin(), points.end());
+  points.erase(std::unique(points.begin(), points.end()), points.end());
+  for (unsigned int c = 0; c < 3u; ++c)
+    positions.unique[c].reserve(points.size());
+  for (const auto &p : points)
+  {
+    for (unsigned int c = 0; c < 3u; ++c)
+      positions.unique[c].push_back(p[c]);
+  }
+
+  return positions;
+}
+
+/////////////////////////////////////////////////
+void Ogre2BoundingBoxCameraPrivate::EvictPositions()
+{
+  Ogre::MeshManager &meshManager = Ogre::MeshManager::getSingleton();
+  for (auto it = this->meshPositions.begin();
+       it != this->meshPositions.end();)
+  {
+    // handles are never reused, so a mesh that is recreated with the same
+    // name gets a new entry. Meshes with dynamic buffers keep their handle
+    // when their vertices change, so they are read again next frame.
+    if (!it->second.cacheable || !meshManager.getByHandle(it->first))
+      it = this->meshPositions.erase(it);
+    else
+      ++it;
   }
 }
 
@@ -683,75 +955,24 @@ void Ogre2BoundingBoxCameraPrivate::MeshVertices(
   for (auto ogreId : _ogreIds)
   {
     Ogre::Item *item = this->ogreIdToItem[ogreId];
-    Ogre::MeshPtr mesh = item->getMesh();
     Ogre::Node *node = item->getParentNode();
 
-    Ogre::Vector3 position = node->_getDerivedPosition();
-    Ogre::Quaternion oreintation = node->_getDerivedOrientation();
-    Ogre::Vector3 scale = node->_getDerivedScale();
-
-    auto subMeshes = mesh->getSubMeshes();
-
-    for (const auto &subMesh : subMeshes)
+    // mesh to camera view coordinates
+    Ogre::Matrix4 worldMatrix;
+    worldMatrix.makeTransform(node->_getDerivedPosition(),
+        node->_getDerivedScale(), node->_getDerivedOrientation());
+    const Ogre::Matrix4 matrix = viewMatrix * worldMatrix;
+
+    // Add the vertices to the vertices of all items that
+    // belongs to the same parent
+    const auto &points = this->Positions(item->getMesh()).all;
+    const std::size_t count = points[0].size();
+    _vertices.reserve(_vertices.size() + count);
+    for (std::size_t i = 0; i < count; ++i)
     {
-      Ogre::VertexArrayObjectArray vaos = subMesh->mVao[0];
-
-      if (!vaos.empty())
-      {
-        // Get the first LOD level
-        Ogre::VertexArrayObject *vao = vaos[0];
-
-        // request async read from buffer
-        Ogre::VertexArrayObject::ReadRequestsArray requests;
-        requests.push_back(Ogre::VertexArrayObject::ReadRequests(
-          Ogre::VES_POSITION));
-        vao->readRequests(requests);
-        vao->mapAsyncTickets(requests);
-
-        unsigned int subMeshVerticiesNum =
-          requests[0].vertexBuffer->getNumElements();
-        for (size_t i = 0; i < subMeshVerticiesNum; ++i)
-        {
-          Ogre::Vector3 vec;
-          if (requests[0].type == Ogre::VET_HALF4)
-          {
-            const Ogre::uint16* vertex = reinterpret_cast<const Ogre::uint16*>
-              (requests[0].data);
-            vec.x = Ogre::Bitwise::halfToFloat(vertex[0]);
-            vec.y = Ogre::Bitwise::halfToFloat(vertex[1]);
-            vec.z = Ogre::Bitwise::halfToFloat(vertex[2]);
-          }
-          else if (requests[0].type == Ogre::VET_FLOAT3)
-          {
-            const float* vertex =
-              reinterpret_cast<const float*>(requests[0].data);
-            vec.x = *vertex++;
-            vec.y = *vertex++;
-            vec.z = *vertex++;
-          }
-          else
-            gzerr << "Vertex Buffer type error" << std::endl;
-
-          // Convert to world coordinates
-          vec = (oreintation * (vec * scale)) + position;
-
-          // Convert to camera view coordiantes
-          Ogre::Vector4 vec4(vec.x, vec.y, vec.z, 1);
-          vec4 = viewMatrix * vec4;
-
-          vec.x = vec4.x;
-          vec.y = vec4.y;
-          vec.z = vec4.z;
-
-          // Add the vertex to the vertices of all items that
-          // belongs to the same parent
-          _vertices.push_back(Ogre2Conversions::Convert(vec));
-
-          // get the next element
-          requests[0].data += requests[0].vertexBuffer->getBytesPerElement();
-        }
-        vao->unmapAsyncTickets(requests);
-      }
+      Ogre::Vector3 vec = matrix * Ogre::Vector3(
+          points[0][i], points[1][i], points[2][i]);
+      _vertices.push_back(Ogre2Conversions::Convert(vec));
     }
   }
 }
@@ -960,79 +1181,25 @@ void Ogre2BoundingBoxCamera::VisibleBoundingBoxes()
     return;
   }
 
-  uint32_t width = this->ImageWidth();
-  uint32_t height = this->ImageHeight();
-  uint32_t channelCount = 3;
-
-  struct BoxBoundary
-  {
-    uint32_t minX;
-    uint32_t minY;
-    uint32_t maxX;
-    uint32_t maxY;
-  };
-
-  std::unordered_map<uint32_t, std::shared_ptr<BoxBoundary>> boxesBoundary;
-
   // find item's boundaries from panoptic BoundingBox
-  for (uint32_t y = 0; y < height; y++)
-  {
-    for (uint32_t x = 0; x < width; x++)
-    {
-      auto index = (y * width + x) * channelCount;
-
-      uint32_t label = this->dataPtr->buffer[index + 2];
-      uint32_t ogreId1 = this->dataPtr->buffer[index + 1];
-      uint32_t ogreId2 = this->dataPtr->buffer[index + 0];
-
-      if (label != this->dataPtr->materialSwitcher->backgroundLabel)
-      {
-        // get the OGRE id of 16 bit value
-        uint32_t ogreId = ogreId1 * 256 + ogreId2;
+  auto visible = visiblePixelBounds(this->dataPtr->buffer,
+      this->ImageWidth(), this->ImageHeight(),
+      this->dataPtr->materialSwitcher->backgroundLabel,
+      this->dataPtr->workerPool);
 
-        std::shared_ptr<BoundingBox> box;
-        std::shared_ptr<BoxBoundary> boundary;
-
-        // create new boxes when its first pixel appears
-        if (!this->dataPtr->boundingboxes.count(ogreId))
-        {
-          box = std::make_shared<BoundingBox>();
-          box->SetLabel(label);
-
-          boundary = std::make_shared<BoxBoundary>();
-          boundary->minX = width;
-          boundary->minY = height;
-          boundary->maxX = 0;
-          boundary->maxY = 0;
-
-          boxesBoundary[ogreId] = boundary;
-          this->dataPtr->boundingboxes[ogreId] = box;
-        }
-        else
-        {
-          boundary = boxesBoundary[ogreId];
-        }
-
-        boundary->minX = std::min<uint32_t>(boundary->minX, x);
-        boundary->minY = std::min<uint32_t>(boundary->minY, y);
-        boundary->maxX = std::max<uint32_t>(boundary->maxX, x);
-        boundary->maxY = std::max<uint32_t>(boundary->maxY, y);
-      }
-    }
-  }
-
-  for (const auto &box : this->dataPtr->boundingboxes)
+  for (const auto &bounds : visible)
   {
-    // Get the box's boundary
-    auto ogreId = box.first;
-    auto boundary = boxesBoundary[ogreId];
-    auto boxWidth = boundary->maxX - boundary->minX;
-    auto boxHeight = boundary->maxY - boundary->minY;
+    const PixelBounds &boundary = bounds.second;
+    auto boxWidth = boundary.maxX - boundary.minX;
+    auto boxHeight = boundary.maxY - boundary.minY;
 
-    box.second->SetCenter({boundary->minX + boxWidth * 0.5,
-        boundary->minY + boxHeight * 0.5, 0});
-    box.second->SetSize(
+    auto box = std::make_shared<BoundingBox>();
+    box->SetLabel(boundary.label);
+    box->SetCenter({boundary.minX + boxWidth * 0.5,
+        boundary.minY + boxHeight * 0.5, 0});
+    box->SetSize(
         {static_cast<double>(boxWidth), static_cast<double>(boxHeight), 0.0});
+    this->dataPtr->boundingboxes[bounds.first] = box;
   }
 
   // Combine boxes of multi-links model if exists
@@ -1151,72 +1318,13 @@ void Ogre2BoundingBoxCamera::MeshMinimalBox(
   _maxVertex.y = -std::numeric_limits<float>::max();
   _maxVertex.z = -std::numeric_limits<float>::max();
 
-  auto subMeshes = _mesh->getSubMeshes();
+  // single mesh to clip space transform for all vertices
+  Ogre::Matrix4 worldMatrix;
+  worldMatrix.makeTransform(_position, _scale, _orientation);
+  const Ogre::Matrix4 matrix = _projMatrix * _viewMatrix * worldMatrix;
 
-  for (auto subMesh : subMeshes)
-  {
-    Ogre::VertexArrayObjectArray vaos = subMesh->mVao[0];
-
-    if (!vaos.empty())
-    {
-      // Get the first LOD level
-      Ogre::VertexArrayObject *vao = vaos[0];
-
-      // request async read from buffer
-      Ogre::VertexArrayObject::ReadRequestsArray requests;
-      requests.push_back(Ogre::VertexArrayObject::ReadRequests(
-        Ogre::VES_POSITION));
-      vao->readRequests(requests);
-      vao->mapAsyncTickets(requests);
-
-      unsigned int subMeshVerticiesNum =
-        requests[0].vertexBuffer->getNumElements();
-      for (size_t i = 0; i < subMeshVerticiesNum; ++i)
-      {
-        Ogre::Vector3 vec;
-        if (requests[0].type == Ogre::VET_HALF4)
-        {
-          const Ogre::uint16* vertex = reinterpret_cast<const Ogre::uint16*>
-            (requests[0].data);
-          vec.x = Ogre::Bitwise::halfToFloat(vertex[0]);
-          vec.y = Ogre::Bitwise::halfToFloat(vertex[1]);
-          vec.z = Ogre::Bitwise::halfToFloat(vertex[2]);
-        }
-        else if (requests[0].type == Ogre::VET_FLOAT3)
-        {
-          const float* vertex =
-            reinterpret_cast<const float*>(requests[0].data);
-          vec.x = *vertex++;
-          vec.y = *vertex++;
-          vec.z = *vertex++;
-        }
-        else
-          gzerr << "Vertex Buffer type error" << std::endl;
-
-        vec = (_orientation * (vec * _scale)) + _position;
-
-        Ogre::Vector4 vec4(vec.x, vec.y, vec.z, 1);
-        vec4 =  _projMatrix * _viewMatrix * vec4;
-
-        // homogenous
-        vec.x = vec4.x / vec4.w;
-        vec.y = vec4.y / vec4.w;
-        vec.z = vec4.z;
-
-        _minVertex.x = std::min(_minVertex.x, vec.x);
-        _minVertex.y = std::min(_minVertex.y, vec.y);
-        _minVertex.z = std::min(_minVertex.z, vec.z);
-
-        _maxVertex.x = std::max(_maxVertex.x, vec.x);
-        _maxVertex.y = std::max(_maxVertex.y, vec.y);
-        _maxVertex.z = std::max(_maxVertex.z, vec.z);
-
-        // get the next element
-        requests[0].data += requests[0].vertexBuffer->getBytesPerElement();
-      }
-      vao->unmapAsyncTickets(requests);
-    }
-  }
+  projectMinMax(matrix, this->dataPtr->Positions(_mesh).unique,
+      _minVertex, _maxVertex);
 }
 
 /////////////////////////////////////////////////
@@ -34,6 +34,9 @@
 using namespace gz;
 using namespace rendering;
 
+/// \brief Largest ogre id that can be encoded in the 3 id channels
+static const uint32_t kMaxOgreId = 0xFFFFFF;
+
 /////////////////////////////////////////////////
 Ogre2BoundingBoxMaterialSwitcher::Ogre2BoundingBoxMaterialSwitcher(
     Ogre2ScenePtr _scene)
@@ -127,16 +130,27 @@ void Ogre2BoundingBoxMaterialSwitcher::cameraPreRenderScene(
         label = this->backgroundLabel;
       }
 
-      // for full bbox, each pixel contains 1 channel for label
-      // and 2 channels stores ogreId
+      // each pixel contains 1 channel for label and 3 channels storing
+      // the ogreId as a 24 bit value. The plain material does not blend so
+      // the alpha channel is written as is.
       uint32_t ogreId = item->getId();
+      static bool overflowWarned = false;
+      if (ogreId > kMaxOgreId && !overflowWarned)
+      {
+        overflowWarned = true;
+        gzwarn << "Ogre id [" << ogreId << "] of item [" << item->getName()
+               << "] does not fit in 24 bits. Its bounding box may be "
+               << "merged with another item's box." << std::endl;
+      }
 
       float labelColor = label / 255.0;
-      float ogreId1 = (ogreId / 256) / 255.0;
-      float ogreId2 = (ogreId % 256) / 255.0;
+      float ogreId1 = ((ogreId >> 8) & 0xFF) / 255.0;
+      float ogreId2 = (ogreId & 0xFF) / 255.0;
+      float ogreId3 = ((ogreId >> 16) & 0xFF) / 255.0;
 
       // Material color
-      auto customParameter = Ogre::Vector4(ogreId2, ogreId1, labelColor, 1.0);
+      auto customParameter =
+          Ogre::Vector4(ogreId2, ogreId1, labelColor, ogreId3);
 
       // Multi-links models handeling
       auto itemName = visual->Name();
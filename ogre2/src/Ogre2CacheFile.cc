@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+
+#include "Ogre2CacheFile.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreException.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+using namespace gz;
+using namespace rendering;
+
+//////////////////////////////////////////////////
+Ogre::DataStreamPtr Ogre2CacheFile::Read(const std::string &_path)
+{
+  std::ifstream in(_path, std::ios::binary | std::ios::ate);
+  if (!in)
+    return Ogre::DataStreamPtr();
+
+  const std::streamoff size = in.tellg();
+  if (size <= 0)
+    return Ogre::DataStreamPtr();
+  in.seekg(0);
+  Ogre::MemoryDataStream *memStream = OGRE_NEW Ogre::MemoryDataStream(
+      _path, static_cast<size_t>(size), true, true);
+  Ogre::DataStreamPtr stream(memStream);
+  if (!in.read(reinterpret_cast<char *>(memStream->getPtr()), size))
+    return Ogre::DataStreamPtr();
+  return stream;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2CacheFile::Write(const std::string &_path,
+    const std::function<bool(const std::string &)> &_write)
+{
+  std::random_device rd;
+  const std::string tmp = _path + ".tmp" + std::to_string(rd());
+
+  bool written = false;
+  try
+  {
+    written = _write(tmp);
+  }
+  catch (Ogre::Exception &e)
+  {
+    gzwarn << "Unable to write cache entry [" << _path << "]: "
+           << e.getDescription() << std::endl;
+  }
+  if (!written)
+  {
+    std::remove(tmp.c_str());
+    return false;
+  }
+
+  if (std::rename(tmp.c_str(), _path.c_str()) != 0)
+  {
+    // another process may have written the same entry in the meantime
+    std::remove(tmp.c_str());
+    return common::isFile(_path);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2CacheFile::WriteStream(const std::string &_path,
+    const std::function<void(Ogre::DataStreamPtr &)> &_write)
+{
+  return Write(_path, [&_path, &_write](const std::string &_tmp)
+  {
+    std::fstream *out =
+        OGRE_NEW_T(std::fstream, Ogre::MEMCATEGORY_GENERAL)();
+    out->open(_tmp.c_str(), std::ios::out | std::ios::binary);
+    Ogre::DataStreamPtr stream(
+        OGRE_NEW Ogre::FileStreamDataStream(_tmp, out, true));
+    if (!out->is_open())
+    {
+      gzwarn << "Unable to write cache entry [" << _path << "]"
+             << std::endl;
+      return false;
+    }
+
+    try
+    {
+      _write(stream);
+    }
+    catch (...)
+    {
+      // close the file before Write removes it
+      stream->close();
+      throw;
+    }
+    stream->close();
+    return true;
+  });
+}
+
+//////////////////////////////////////////////////
+bool Ogre2CacheFile::WriteText(const std::string &_path,
+    const std::string &_content)
+{
+  return Write(_path, [&_content](const std::string &_tmp)
+  {
+    std::ofstream out(_tmp, std::ios::binary);
+    return static_cast<bool>(out << _content);
+  });
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2CACHEFILE_HH_
+#define GZ_RENDERING_OGRE2_OGRE2CACHEFILE_HH_
+
+#include <functional>
+#include <string>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Export.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreDataStream.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief File helpers shared by the on-disk caches. Several processes
+    /// may use the same cache directory, so entries are always written to a
+    /// uniquely named temporary file that is moved in place once complete
+    /// and readers never see a partial entry.
+    class GZ_RENDERING_OGRE2_HIDDEN Ogre2CacheFile
+    {
+      /// \brief Read a whole cache file into memory with a single call
+      /// \param[in] _path File path
+      /// \return Read only stream over the file content, or null if the
+      /// file does not exist, is empty or could not be read
+      public: static Ogre::DataStreamPtr Read(const std::string &_path);
+
+      /// \brief Write a cache file
+      /// \param[in] _path File path
+      /// \param[in] _write Function writing the whole content to the
+      /// temporary file path it is given. Returns false on failure. Ogre
+      /// exceptions it throws are caught and reported as failures.
+      /// \return True if the file exists once done, including when another
+      /// process wrote the same entry in the meantime
+      public: static bool Write(const std::string &_path,
+                  const std::function<bool(const std::string &)> &_write);
+
+      /// \brief Write a cache file through an Ogre data stream
+      /// \param[in] _path File path
+      /// \param[in] _write Function writing the whole content to the
+      /// stream it is given
+      /// \return True on success
+      /// \sa Write
+      public: static bool WriteStream(const std::string &_path,
+                  const std::function<void(Ogre::DataStreamPtr &)> &_write);
+
+      /// \brief Write a small text cache file
+      /// \param[in] _path File path
+      /// \param[in] _content File content
+      /// \return True on success
+      /// \sa Write
+      public: static bool WriteText(const std::string &_path,
+                  const std::string &_content);
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "Ogre2CacheHash.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief FNV-1a 64 bit prime
+static const uint64_t kFnvPrime = 1099511628211ull;
+
+/// \brief Size of the chunks files are hashed in
+static const std::size_t kHashChunkSize = 1u << 20;
+
+//////////////////////////////////////////////////
+void Ogre2CacheHash::Add(const void *_data, std::size_t _size)
+{
+  const unsigned char *data = static_cast<const unsigned char *>(_data);
+  for (std::size_t i = 0u; i < _size; ++i)
+  {
+    this->hash ^= data[i];
+    this->hash *= kFnvPrime;
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2CacheHash::Add(const std::string &_str)
+{
+  this->Add(_str.data(), _str.size());
+}
+
+//////////////////////////////////////////////////
+bool Ogre2CacheHash::AddFile(const std::string &_path)
+{
+  std::ifstream in(_path, std::ios::binary);
+  if (!in)
+    return false;
+
+  std::vector<char> chunk(kHashChunkSize);
+  while (in)
+  {
+    in.read(chunk.data(), chunk.size());
+    this->Add(chunk.data(), static_cast<std::size_t>(in.gcount()));
+  }
+  return in.eof();
+}
+
+//////////////////////////////////////////////////
+uint64_t Ogre2CacheHash::Value() const
+{
+  return this->hash;
+}
+
+//////////////////////////////////////////////////
+std::string Ogre2CacheHash::Hex() const
+{
+  std::stringstream ss;
+  ss << std::hex << std::setfill('0') << std::setw(16) << this->hash;
+  return ss.str();
+}
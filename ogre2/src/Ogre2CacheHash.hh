@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_RENDERING_OGRE2_OGRE2CACHEHASH_HH_
+#define GZ_RENDERING_OGRE2_OGRE2CACHEHASH_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Export.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief 64 bit FNV-1a hash used to name the entries of the on-disk
+    /// caches. Unlike std::hash, its value is the same across processes,
+    /// standard libraries and platforms, so entries written by one build can
+    /// be found by another.
+    class GZ_RENDERING_OGRE2_HIDDEN Ogre2CacheHash
+    {
+      /// \brief Add bytes to the hash
+      /// \param[in] _data Bytes to hash
+      /// \param[in] _size Number of bytes
+      public: void Add(const void *_data, std::size_t _size);
+
+      /// \brief Add the characters of a string to the hash
+      /// \param[in] _str String to hash
+      public: void Add(const std::string &_str);
+
+      /// \brief Add the content of a file to the hash
+      /// \param[in] _path File path
+      /// \return False if the file could not be read
+      public: bool AddFile(const std::string &_path);
+
+      /// \brief Get the hash value
+      /// \return Hash of the data added so far
+      public: uint64_t Value() const;
+
+      /// \brief Get the hash value as a fixed width hexadecimal string
+      /// \return 16 character hexadecimal hash
+      public: std::string Hex() const;
+
+      /// \brief Running hash, starts at the FNV-1a 64 bit offset basis
+      private: uint64_t hash = 14695981039346656037ull;
+    };
+    }
+  }
+}
+#endif
@@ -35,6 +35,8 @@
 /// \brief Private data for the Ogre2Camera class
 class gz::rendering::Ogre2CameraPrivate
 {
+  /// \brief True to render the whole camera view into the selection buffer
+  public: bool selectionBufferFullFrame = false;
 };
 
 using namespace gz;
@@ -280,6 +282,8 @@ void Ogre2Camera::SetSelectionBuffer()
 {
   this->selectionBuffer = new Ogre2SelectionBuffer(this->name, this->scene,
     this->ImageWidth(), this->ImageHeight());
+  this->selectionBuffer->SetFullFrame(
+      this->dataPtr->selectionBufferFullFrame);
 }
 
 //////////////////////////////////////////////////
@@ -288,25 +292,27 @@ Ogre2SelectionBuffer *Ogre2Camera::SelectionBuffer() const
   return this->selectionBuffer;
 }
 
+//////////////////////////////////////////////////
+void Ogre2Camera::SetSelectionBufferFullFrame(bool _fullFrame)
+{
+  this->dataPtr->selectionBufferFullFrame = _fullFrame;
+  if (this->selectionBuffer)
+    this->selectionBuffer->SetFullFrame(_fullFrame);
+}
+
+//////////////////////////////////////////////////
+bool Ogre2Camera::SelectionBufferFullFrame() const
+{
+  return this->dataPtr->selectionBufferFullFrame;
+}
+
 //////////////////////////////////////////////////
 VisualPtr Ogre2Camera::VisualAt(const math::Vector2i &_mousePos)
 {
   VisualPtr result;
 
-  if (!this->selectionBuffer)
-  {
-    this->SetSelectionBuffer();
-
-    if (!this->selectionBuffer)
-    {
-      return result;
-    }
-  }
-  else
-  {
-    this->selectionBuffer->SetDimensions(
-      this->ImageWidth(), this->ImageHeight());
-  }
+  if (!this->UpdateSelectionBuffer())
+    return result;
 
   float ratio = screenScalingFactor();
   math::Vector2i mousePos(
@@ -336,6 +342,71 @@ VisualPtr Ogre2Camera::VisualAt(const math::Vector2i &_mousePos)
   return result;
 }
 
+//////////////////////////////////////////////////
+std::vector<VisualAreaResult> Ogre2Camera::VisualsInRectangle(
+    const math::Vector2i &_min, const math::Vector2i &_max)
+{
+  return this->VisualsInArea(_min, _max, {});
+}
+
+//////////////////////////////////////////////////
+std::vector<VisualAreaResult> Ogre2Camera::VisualsInPolygon(
+    const std::vector<math::Vector2i> &_polygon)
+{
+  if (_polygon.size() < 3u)
+    return {};
+
+  math::Vector2i min = _polygon[0];
+  math::Vector2i max = _polygon[0];
+  for (const auto &vertex : _polygon)
+  {
+    min.Min(vertex);
+    max.Max(vertex);
+  }
+  return this->VisualsInArea(min, max, _polygon);
+}
+
+//////////////////////////////////////////////////
+std::vector<VisualAreaResult> Ogre2Camera::VisualsInArea(
+    const math::Vector2i &_min, const math::Vector2i &_max,
+    const std::vector<math::Vector2i> &_polygon)
+{
+  std::vector<VisualAreaResult> results;
+  if (!this->UpdateSelectionBuffer())
+    return results;
+
+  float ratio = screenScalingFactor();
+  auto scale = [ratio](const math::Vector2i &_pos)
+  {
+    return math::Vector2i(
+        static_cast<int>(std::rint(ratio * _pos.X())),
+        static_cast<int>(std::rint(ratio * _pos.Y())));
+  };
+
+  std::vector<math::Vector2i> polygon;
+  polygon.reserve(_polygon.size());
+  for (const auto &vertex : _polygon)
+    polygon.push_back(scale(vertex));
+
+  this->selectionBuffer->ExecuteAreaQuery(scale(_min), scale(_max), polygon,
+      results);
+  return results;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2Camera::UpdateSelectionBuffer()
+{
+  if (!this->selectionBuffer)
+  {
+    this->SetSelectionBuffer();
+    return this->selectionBuffer != nullptr;
+  }
+
+  this->selectionBuffer->SetDimensions(
+    this->ImageWidth(), this->ImageHeight());
+  return true;
+}
+
 //////////////////////////////////////////////////
 RenderWindowPtr Ogre2Camera::CreateRenderWindow()
 {
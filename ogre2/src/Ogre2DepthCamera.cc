@@ -24,6 +24,8 @@
 #endif
 
 #include <math.h>
+#include <memory>
+#include <vector>
 #include <gz/math/Helpers.hh>
 
 #include "gz/rendering/RenderTypes.hh"
@@ -39,6 +41,7 @@
 #include "gz/rendering/ogre2/Ogre2Sensor.hh"
 
 #include "Ogre2ParticleNoiseListener.hh"
+#include "Ogre2TextureReadback.hh"
 
 namespace gz
 {
@@ -147,11 +150,343 @@ class gz::rendering::Ogre2DepthCameraPrivate
 
   /// \brief Name of shadow compositor node
   public: const std::string kShadowNodeName = "PbsMaterialsShadowNode";
+
+  /// \brief Number of frames by which the published data lags behind
+  /// rendering. 0 means the data is read back synchronously.
+  public: unsigned int readbackLatency = 0u;
+
+  /// \brief Ring of texture readbacks. Holds readbackLatency + 1
+  /// readbacks once the first frame has been read back.
+  public: std::vector<std::unique_ptr<Ogre2TextureReadback>> readbacks;
+
+  /// \brief Index of the readback in readbacks that the next frame will
+  /// be downloaded into.
+  public: unsigned int nextReadback = 0u;
+
+  /// \brief Number of downloads in flight that have not been published
+  /// yet, not counting the one issued in the current frame.
+  public: unsigned int pendingReadbacks = 0u;
+
+  /// \brief True if the caller allows reading back only depth data, in
+  /// which case DepthData() is not updated while depthOnly is true
+  public: bool depthOnlyReadback = false;
+
+  /// \brief True if only depth data is rendered and read back because
+  /// nobody is subscribed to the point cloud. The xyz and color channels
+  /// are then not transferred to the CPU.
+  public: bool depthOnly = false;
+
+  /// \brief Single channel texture holding the depth data when depthOnly
+  /// is true. Stores the float bits as PFG_R32_UINT
+  public: Ogre::TextureGpu *ogreDepthOnlyTexture = nullptr;
+
+  /// \brief Compositor workspace that extracts depth from the final
+  /// output into ogreDepthOnlyTexture
+  public: Ogre::CompositorWorkspace *ogreDepthOnlyWorkspace = nullptr;
+
+  /// \brief Compositor workspace definition for ogreDepthOnlyWorkspace
+  public: std::string ogreDepthOnlyWorkspaceDef;
+
+  /// \brief Compositor node definition for ogreDepthOnlyWorkspace
+  public: std::string ogreDepthOnlyNodeDef;
+
+  /// \brief Texture that ogreDepthOnlyWorkspace reads from. The render
+  /// pass chain may swap the output textures, in which case the workspace
+  /// needs to be recreated.
+  public: Ogre::TextureGpu *depthOnlyInput = nullptr;
+
+  /// \brief Check which outputs have subscribers.
+  /// \return True if depth frames are the only output being consumed
+  public: bool DepthOnlyOutput() const;
+
+  /// \brief Create the depth only texture and workspace if needed and
+  /// make sure the workspace reads from the current output texture
+  /// \param[in] _sceneManager Scene manager of the depth camera
+  /// \param[in] _camera Ogre camera of the depth camera
+  /// \param[in] _width Image width
+  /// \param[in] _height Image height
+  public: void UpdateDepthOnlyWorkspace(Ogre::SceneManager *_sceneManager,
+              Ogre::Camera *_camera, unsigned int _width,
+              unsigned int _height);
+
+  /// \brief Destroy the depth only texture and workspace
+  public: void DestroyDepthOnlyWorkspace();
+
+  /// \brief Destroy all readbacks and discard any data in flight
+  public: void DestroyReadbacks();
+
+  /// \brief Copy depth data from a mapped texture box into the output
+  /// buffers and emit the new depth frame and point cloud events.
+  /// \param[in] _box Mapped texture data in PF_FLOAT32_RGBA format, or in
+  /// PF_FLOAT32_R format if depthOnly is true
+  /// \param[in] _width Image width
+  /// \param[in] _height Image height
+  public: void PublishDepthData(const Ogre::TextureBox &_box,
+              unsigned int _width, unsigned int _height);
 };
 
 using namespace gz;
 using namespace rendering;
 
+//////////////////////////////////////////////////
+bool Ogre2DepthCameraPrivate::DepthOnlyOutput() const
+{
+  // The color data is packed into the same texture as xyz so a point cloud
+  // subscriber always needs the full buffer. The depth only output does not
+  // fill the buffer returned by DepthData() so the caller has to opt in.
+  return this->depthOnlyReadback &&
+      this->newRgbPointCloud.ConnectionCount() == 0u &&
+      this->newDepthFrame.ConnectionCount() > 0u;
+}
+
+//////////////////////////////////////////////////
+void Ogre2DepthCameraPrivate::UpdateDepthOnlyWorkspace(
+    Ogre::SceneManager *_sceneManager, Ogre::Camera *_camera,
+    unsigned int _width, unsigned int _height)
+{
+  if (this->ogreDepthOnlyWorkspace &&
+      this->depthOnlyInput == this->ogreDepthTexture[1])
+  {
+    return;
+  }
+
+  auto engine = Ogre2RenderEngine::Instance();
+  auto ogreRoot = engine->OgreRoot();
+  Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
+
+  if (this->ogreDepthOnlyWorkspace)
+  {
+    ogreCompMgr->removeWorkspace(this->ogreDepthOnlyWorkspace);
+    this->ogreDepthOnlyWorkspace = nullptr;
+  }
+
+  if (!ogreCompMgr->hasWorkspaceDefinition(this->ogreDepthOnlyWorkspaceDef))
+  {
+    // The compositor node definition is equivalent to the following:
+    //
+    // compositor_node DepthCameraDepthOnly
+    // {
+    //   in 0 rt_input
+    //   in 1 rt_output
+    //
+    //   target rt_output
+    //   {
+    //     pass render_quad
+    //     {
+    //       material DepthCameraFinal // Use copy instead of original
+    //       input 0 rt_input
+    //     }
+    //   }
+    // }
+    //
+    // rt_output is a single channel texture so only the x (depth) channel
+    // of the final material output is written.
+    Ogre::CompositorNodeDef *nodeDef =
+        ogreCompMgr->addNodeDefinition(this->ogreDepthOnlyNodeDef);
+    nodeDef->addTextureSourceName("rt_input", 0,
+        Ogre::TextureDefinitionBase::TEXTURE_INPUT);
+    nodeDef->addTextureSourceName("rt_output", 1,
+        Ogre::TextureDefinitionBase::TEXTURE_INPUT);
+
+    nodeDef->setNumTargetPass(1);
+    Ogre::CompositorTargetDef *outputTargetDef =
+        nodeDef->addTargetPass("rt_output");
+    outputTargetDef->setNumPasses(1);
+    {
+      // quad pass
+      Ogre::CompositorPassQuadDef *passQuad =
+          static_cast<Ogre::CompositorPassQuadDef *>(
+          outputTargetDef->addPass(Ogre::PASS_QUAD));
+      passQuad->setAllLoadActions(Ogre::LoadAction::DontCare);
+      passQuad->mMaterialName = this->depthFinalMaterial->getName();
+      passQuad->addQuadTextureSource(0, "rt_input");
+    }
+    nodeDef->mapOutputChannel(0, "rt_output");
+
+    Ogre::CompositorWorkspaceDef *workDef =
+        ogreCompMgr->addWorkspaceDefinition(this->ogreDepthOnlyWorkspaceDef);
+    workDef->connectExternal(0, this->ogreDepthOnlyNodeDef, 0);
+    workDef->connectExternal(1, this->ogreDepthOnlyNodeDef, 1);
+  }
+
+  if (!this->ogreDepthOnlyTexture)
+  {
+    Ogre::TextureGpuManager *textureMgr =
+        ogreRoot->getRenderSystem()->getTextureGpuManager();
+    this->ogreDepthOnlyTexture = textureMgr->createTexture(
+        this->ogreDepthOnlyWorkspaceDef + "_depth",
+        Ogre::GpuPageOutStrategy::SaveToSystemRam,
+        Ogre::TextureFlags::RenderToTexture,
+        Ogre::TextureTypes::Type2D);
+    this->ogreDepthOnlyTexture->setResolution(_width, _height);
+    this->ogreDepthOnlyTexture->setNumMipmaps(1u);
+    // same encoding as the final output: float bits stored as uint
+    this->ogreDepthOnlyTexture->setPixelFormat(Ogre::PFG_R32_UINT);
+    this->ogreDepthOnlyTexture->scheduleTransitionTo(
+        Ogre::GpuResidency::Resident);
+  }
+
+  Ogre::CompositorChannelVec externalTargets(2u);
+  externalTargets[0] = this->ogreDepthTexture[1];
+  externalTargets[1] = this->ogreDepthOnlyTexture;
+  this->ogreDepthOnlyWorkspace = ogreCompMgr->addWorkspace(
+      _sceneManager, externalTargets, _camera,
+      this->ogreDepthOnlyWorkspaceDef, false);
+  this->depthOnlyInput = this->ogreDepthTexture[1];
+}
+
+//////////////////////////////////////////////////
+void Ogre2DepthCameraPrivate::DestroyDepthOnlyWorkspace()
+{
+  auto engine = Ogre2RenderEngine::Instance();
+  auto ogreRoot = engine->OgreRoot();
+  Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
+
+  if (this->ogreDepthOnlyWorkspace)
+  {
+    ogreCompMgr->removeWorkspace(this->ogreDepthOnlyWorkspace);
+    this->ogreDepthOnlyWorkspace = nullptr;
+  }
+  this->depthOnlyInput = nullptr;
+
+  if (this->ogreDepthOnlyTexture)
+  {
+    ogreRoot->getRenderSystem()->getTextureGpuManager()->destroyTexture(
+        this->ogreDepthOnlyTexture);
+    this->ogreDepthOnlyTexture = nullptr;
+  }
+
+  if (!this->ogreDepthOnlyWorkspaceDef.empty() &&
+      ogreCompMgr->hasWorkspaceDefinition(this->ogreDepthOnlyWorkspaceDef))
+  {
+    ogreCompMgr->removeWorkspaceDefinition(this->ogreDepthOnlyWorkspaceDef);
+    ogreCompMgr->removeNodeDefinition(this->ogreDepthOnlyNodeDef);
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2DepthCameraPrivate::DestroyReadbacks()
+{
+  this->readbacks.clear();
+  this->nextReadback = 0u;
+  this->pendingReadbacks = 0u;
+}
+
+//////////////////////////////////////////////////
+void Ogre2DepthCameraPrivate::PublishDepthData(const Ogre::TextureBox &_box,
+    unsigned int _width, unsigned int _height)
+{
+  int len = _width * _height;
+
+  if (!this->depthImage)
+  {
+    this->depthImage = new float[len];
+  }
+
+  if (this->depthOnly)
+  {
+    // the texture already holds just the depth values. Copy row by row
+    // since the texture box may not be a contiguous region of a texture
+    const uint8_t *src = static_cast<const uint8_t *>(_box.data);
+    for (unsigned int i = 0; i < _height; ++i)
+    {
+      memcpy(&this->depthImage[i * _width], src + i * _box.bytesPerRow,
+          _width * sizeof(float));
+    }
+    this->newDepthFrame(this->depthImage, _width, _height, 1, "FLOAT32");
+    return;
+  }
+
+  PixelFormat format = PF_FLOAT32_RGBA;
+  unsigned int channelCount = PixelUtil::ChannelCount(format);
+  unsigned int bytesPerChannel = PixelUtil::BytesPerChannel(format);
+
+  const float *depthBufferTmp = static_cast<const float *>(_box.data);
+  if (!this->depthBuffer)
+  {
+    this->depthBuffer = new float[len * channelCount];
+  }
+
+  // copy data row by row. The texture box may not be a contiguous region of
+  // a texture
+  for (unsigned int i = 0; i < _height; ++i)
+  {
+    unsigned int rawDataRowIdx = i * _box.bytesPerRow / bytesPerChannel;
+    unsigned int rowIdx = i * _width * channelCount;
+    memcpy(&this->depthBuffer[rowIdx], &depthBufferTmp[rawDataRowIdx],
+        _width * channelCount * bytesPerChannel);
+  }
+
+  if (!this->pointCloudImage)
+  {
+    this->pointCloudImage = new float[len * channelCount];
+  }
+
+  // fill depth data
+  for (unsigned int i = 0; i < _height; ++i)
+  {
+    unsigned int step = i*_width*channelCount;
+    for (unsigned int j = 0; j < _width; ++j)
+    {
+      float x = this->depthBuffer[step + j*channelCount];
+      this->depthImage[i*_width + j] = x;
+    }
+  }
+  this->newDepthFrame(this->depthImage, _width, _height, 1, "FLOAT32");
+
+  // point cloud data
+  if (this->newRgbPointCloud.ConnectionCount() > 0u)
+  {
+    memcpy(this->pointCloudImage,
+      this->depthBuffer, len * channelCount * sizeof(float));
+    this->newRgbPointCloud(
+        this->pointCloudImage, _width, _height, channelCount,
+        "PF_FLOAT32_RGBA");
+
+    // Uncomment to debug color output
+    // for (unsigned int i = 0; i < _height; ++i)
+    // {
+    //   unsigned int step = i*_width*channelCount;
+    //   for (unsigned int j = 0; j < _width; ++j)
+    //   {
+    //     float color =
+    //         this->pointCloudImage[step + j*channelCount + 3];
+    //     // unpack rgb data
+    //     uint32_t *rgba = reinterpret_cast<uint32_t *>(&color);
+    //     unsigned int r = *rgba >> 24 & 0xFF;
+    //     unsigned int g = *rgba >> 16 & 0xFF;
+    //     unsigned int b = *rgba >> 8 & 0xFF;
+    //     gzdbg << "[" << r << "]" << "[" << g << "]" << "[" << b << "],";
+    //   }
+    //   gzdbg << std::endl;
+    // }
+
+    // Uncomment to debug xyz output
+    // gzdbg << "wxh: " << _width << " x " << _height << std::endl;
+    // for (unsigned int i = 0; i < _height; ++i)
+    // {
+    //   for (unsigned int j = 0; j < _width; ++j)
+    //   {
+    //     gzdbg << "[" << this->pointCloudImage[i*_width*4+j*4] << "]"
+    //       << "[" << this->pointCloudImage[i*_width*4+j*4+1] << "]"
+    //       << "[" << this->pointCloudImage[i*_width*4+j*4+2] << "],";
+    //   }
+    //   gzdbg << std::endl;
+    // }
+  }
+
+  // Uncomment to debug depth output
+  // gzdbg << "wxh: " << _width << " x " << _height << std::endl;
+  // for (unsigned int i = 0; i < _height; ++i)
+  // {
+  //   for (unsigned int j = 0; j < _width; ++j)
+  //   {
+  //     gzdbg << "[" << this->depthImage[i*_width + j] << "]";
+  //   }
+  //   gzdbg << std::endl;
+  // }
+}
+
 //////////////////////////////////////////////////
 void Ogre2DepthGaussianNoisePass::PreRender()
 {
@@ -294,6 +629,9 @@ void Ogre2DepthCamera::Destroy()
   if (!this->ogreCamera)
     return;
 
+  this->dataPtr->DestroyReadbacks();
+  this->dataPtr->DestroyDepthOnlyWorkspace();
+
   auto engine = Ogre2RenderEngine::Instance();
   auto ogreRoot = engine->OgreRoot();
   Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
@@ -522,6 +860,10 @@ void Ogre2DepthCamera::CreateDepthTexture()
 
   std::string wsDefName = "DepthCameraWorkspace_" + this->Name();
   this->dataPtr->ogreCompositorWorkspaceDef = wsDefName;
+  this->dataPtr->ogreDepthOnlyWorkspaceDef =
+      "DepthCameraDepthOnlyWorkspace_" + this->Name();
+  this->dataPtr->ogreDepthOnlyNodeDef =
+      this->dataPtr->ogreDepthOnlyWorkspaceDef + "/Node";
   if (!ogreCompMgr->hasWorkspaceDefinition(wsDefName))
   {
     // The depth camera compositor does a few passes in order to simulate
@@ -988,6 +1330,18 @@ void Ogre2DepthCamera::Render()
   swappedTargets.reserve(2u);
   this->dataPtr->ogreCompositorWorkspace->_swapFinalTarget(swappedTargets);
 
+  // extract the depth channel so that only a quarter of the data needs
+  // to be read back
+  if (this->dataPtr->depthOnly)
+  {
+    this->dataPtr->ogreDepthOnlyWorkspace->_validateFinalTarget();
+    this->dataPtr->ogreDepthOnlyWorkspace->_beginUpdate(false);
+    this->dataPtr->ogreDepthOnlyWorkspace->_update();
+    this->dataPtr->ogreDepthOnlyWorkspace->_endUpdate(false);
+    swappedTargets.clear();
+    this->dataPtr->ogreDepthOnlyWorkspace->_swapFinalTarget(swappedTargets);
+  }
+
   this->scene->FlushGpuCommandsAndStartNewFrame(1u, false);
 
   this->ogreCamera->_setNeedsDepthClamp(bOldDepthClamp);
@@ -1042,6 +1396,21 @@ void Ogre2DepthCamera::PreRender()
   }
 
   this->dataPtr->renderPassDirty = false;
+
+  // select the outputs to render and read back based on subscribers
+  const bool depthOnly = this->dataPtr->DepthOnlyOutput();
+  if (depthOnly != this->dataPtr->depthOnly)
+  {
+    // data in flight has the format of the previous output selection
+    this->dataPtr->DestroyReadbacks();
+    this->dataPtr->depthOnly = depthOnly;
+  }
+  if (this->dataPtr->depthOnly)
+  {
+    this->dataPtr->UpdateDepthOnlyWorkspace(
+        this->scene->OgreSceneManager(), this->ogreCamera,
+        this->ImageWidth(), this->ImageHeight());
+  }
 }
 
 //////////////////////////////////////////////////
@@ -1050,104 +1419,80 @@ void Ogre2DepthCamera::PostRender()
   unsigned int width = this->ImageWidth();
   unsigned int height = this->ImageHeight();
 
-  PixelFormat format = PF_FLOAT32_RGBA;
-
-  int len = width * height;
-  unsigned int channelCount = PixelUtil::ChannelCount(format);
-  unsigned int bytesPerChannel = PixelUtil::BytesPerChannel(format);
-
-  Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->ogreDepthTexture[1], 0u, 0u);
-  Ogre::TextureBox box = image.getData(0);
-  float *depthBufferTmp = static_cast<float *>(box.data);
-  if (!this->dataPtr->depthBuffer)
+  Ogre::TextureGpu *texture = this->dataPtr->depthOnly ?
+      this->dataPtr->ogreDepthOnlyTexture :
+      this->dataPtr->ogreDepthTexture[1];
+
+  // Readbacks are created once and reused every frame. This avoids
+  // creating and destroying a staging buffer per frame like Ogre::Image2
+  // does. The ring holds readbackLatency + 1 readbacks: the one we
+  // download the current frame into plus the ones still in flight from
+  // previous frames. Data in flight has the old size if the texture was
+  // resized, so the whole ring is dropped in that case.
+  const unsigned int readbackCount = this->dataPtr->readbackLatency + 1u;
+  if (this->dataPtr->readbacks.size() != readbackCount ||
+      (this->dataPtr->pendingReadbacks > 0u &&
+      !this->dataPtr->readbacks[0]->Compatible(texture)))
   {
-    this->dataPtr->depthBuffer = new float[len * channelCount];
+    this->dataPtr->DestroyReadbacks();
+    for (unsigned int i = 0u; i < readbackCount; ++i)
+    {
+      this->dataPtr->readbacks.push_back(
+          std::make_unique<Ogre2TextureReadback>());
+    }
   }
 
-  // copy data row by row. The texture box may not be a contiguous region of
-  // a texture
-  for (unsigned int i = 0; i < height; ++i)
-  {
-    unsigned int rawDataRowIdx = i * box.bytesPerRow / bytesPerChannel;
-    unsigned int rowIdx = i * width * channelCount;
-    memcpy(&this->dataPtr->depthBuffer[rowIdx], &depthBufferTmp[rawDataRowIdx],
-        width * channelCount * bytesPerChannel);
-  }
+  // queue the download of the frame that was just rendered
+  this->dataPtr->readbacks[this->dataPtr->nextReadback]->Download(
+      texture);
+  this->dataPtr->nextReadback =
+      (this->dataPtr->nextReadback + 1u) % readbackCount;
 
-  if (!this->dataPtr->depthImage)
-  {
-    this->dataPtr->depthImage = new float[len];
-  }
-  if (!this->dataPtr->pointCloudImage)
+  // wait until the ring is full before publishing anything
+  if (this->dataPtr->pendingReadbacks < this->dataPtr->readbackLatency)
   {
-    this->dataPtr->pointCloudImage = new float[len * channelCount];
+    ++this->dataPtr->pendingReadbacks;
+    return;
   }
 
-  // fill depth data
-  for (unsigned int i = 0; i < height; ++i)
-  {
-    unsigned int step = i*width*channelCount;
-    for (unsigned int j = 0; j < width; ++j)
-    {
-      float x = this->dataPtr->depthBuffer[step + j*channelCount];
-      this->dataPtr->depthImage[i*width + j] = x;
-    }
-  }
-  this->dataPtr->newDepthFrame(
-        this->dataPtr->depthImage, width, height, 1, "FLOAT32");
+  // The oldest download is in the readback that the next frame will be
+  // downloaded into. It was issued readbackLatency frames ago so it has
+  // most likely finished by now. If not, Map() waits for it to finish.
+  Ogre2TextureReadback &readback =
+      *this->dataPtr->readbacks[this->dataPtr->nextReadback];
+  Ogre::TextureBox box = readback.Map();
+  this->dataPtr->PublishDepthData(box, width, height);
+  readback.Unmap();
+}
 
-  // point cloud data
-  if (this->dataPtr->newRgbPointCloud.ConnectionCount() > 0u)
-  {
-    memcpy(this->dataPtr->pointCloudImage,
-      this->dataPtr->depthBuffer, len * channelCount * sizeof(float));
-    this->dataPtr->newRgbPointCloud(
-        this->dataPtr->pointCloudImage, width, height, channelCount,
-        "PF_FLOAT32_RGBA");
+//////////////////////////////////////////////////
+void Ogre2DepthCamera::SetReadbackLatency(unsigned int _frames)
+{
+  if (this->dataPtr->readbackLatency == _frames)
+    return;
 
-    // Uncomment to debug color output
-    // for (unsigned int i = 0; i < height; ++i)
-    // {
-    //   unsigned int step = i*width*channelCount;
-    //   for (unsigned int j = 0; j < width; ++j)
-    //   {
-    //     float color =
-    //         this->dataPtr->pointCloudImage[step + j*channelCount + 3];
-    //     // unpack rgb data
-    //     uint32_t *rgba = reinterpret_cast<uint32_t *>(&color);
-    //     unsigned int r = *rgba >> 24 & 0xFF;
-    //     unsigned int g = *rgba >> 16 & 0xFF;
-    //     unsigned int b = *rgba >> 8 & 0xFF;
-    //     gzdbg << "[" << r << "]" << "[" << g << "]" << "[" << b << "],";
-    //   }
-    //   gzdbg << std::endl;
-    // }
+  // data in flight was requested with the old latency. Drop it so that
+  // subscribers never receive frames out of order.
+  this->dataPtr->DestroyReadbacks();
+  this->dataPtr->readbackLatency = _frames;
+}
 
-    // Uncomment to debug xyz output
-    // gzdbg << "wxh: " << width << " x " << height << std::endl;
-    // for (unsigned int i = 0; i < height; ++i)
-    // {
-    //   for (unsigned int j = 0; j < width; ++j)
-    //   {
-    //     gzdbg << "[" << this->dataPtr->pointCloudImage[i*width*4+j*4] << "]"
-    //       << "[" << this->dataPtr->pointCloudImage[i*width*4+j*4+1] << "]"
-    //       << "[" << this->dataPtr->pointCloudImage[i*width*4+j*4+2] << "],";
-    //   }
-    //   gzdbg << std::endl;
-    // }
-  }
+//////////////////////////////////////////////////
+unsigned int Ogre2DepthCamera::ReadbackLatency() const
+{
+  return this->dataPtr->readbackLatency;
+}
 
-  // Uncomment to debug depth output
-  // gzdbg << "wxh: " << width << " x " << height << std::endl;
-  // for (unsigned int i = 0; i < height; ++i)
-  // {
-  //   for (unsigned int j = 0; j < width; ++j)
-  //   {
-  //     gzdbg << "[" << this->dataPtr->depthImage[i*width + j] << "]";
-  //   }
-  //   gzdbg << std::endl;
-  // }
+//////////////////////////////////////////////////
+void Ogre2DepthCamera::SetDepthOnlyReadback(bool _enabled)
+{
+  this->dataPtr->depthOnlyReadback = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2DepthCamera::DepthOnlyReadback() const
+{
+  return this->dataPtr->depthOnlyReadback;
 }
 
 //////////////////////////////////////////////////
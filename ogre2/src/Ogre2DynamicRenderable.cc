@@ -26,6 +26,11 @@
 #pragma warning(pop)
 #endif
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
 #include "gz/common/Console.hh"
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
 #include "gz/rendering/ogre2/Ogre2DynamicRenderable.hh"
@@ -42,6 +47,7 @@
 #include <OgreSceneManager.h>
 #include <OgreSubMesh2.h>
 #include <Vao/OgreVaoManager.h>
+#include <Vao/OgreVertexArrayObject.h>
 #ifdef _MSC_VER
   #pragma warning(pop)
 #endif
@@ -49,11 +55,34 @@
 /// \brief Private implementation
 class gz::rendering::Ogre2DynamicRenderablePrivate
 {
-  /// \brief list of colors at each point
-  public: std::vector<gz::math::Color> colors;
+  /// \brief Colors of the vertices, 4 floats (rgba) per vertex
+  public: std::vector<float> colors;
+
+  /// \brief Vertex data in the layout of the vertex buffer, 6 floats per
+  /// vertex: the position followed by the normal, or by the color for
+  /// points. Only the ranges that changed are rewritten and uploaded on
+  /// update.
+  public: std::vector<float> vertexData;
+
+  /// \brief Positions of points set in bulk and not yet copied into
+  /// vertexData, 3 floats per point. Either borrowed from the caller or
+  /// pointing into ownedXyz.
+  public: const float *pendingXyz = nullptr;
+
+  /// \brief Colors of the pending points, 4 floats per point. May be null.
+  public: const float *pendingRgba = nullptr;
 
-  /// \brief List of vertices for the mesh
-  public: std::vector<gz::math::Vector3d> vertices;
+  /// \brief Number of pending points
+  public: std::size_t pendingCount = 0u;
+
+  /// \brief True if points were set in bulk and not yet copied
+  public: bool pending = false;
+
+  /// \brief Positions moved in by the caller
+  public: std::vector<float> ownedXyz;
+
+  /// \brief Colors moved in by the caller
+  public: std::vector<float> ownedRgba;
 
   /// \brief Used to indicate if the lines require an update
   public: bool dirty = false;
@@ -73,8 +102,54 @@ class gz::rendering::Ogre2DynamicRenderablePrivate
   /// \brief Ogre item created from the dynamic geometry
   public: Ogre::Item *ogreItem = nullptr;
 
-  /// \brief raw vertex buffer
-  public: float *vbuffer = nullptr;
+  /// \brief First vertex that changed since the last update
+  public: unsigned int dirtyBegin = 0u;
+
+  /// \brief One past the last vertex that changed since the last update
+  public: unsigned int dirtyEnd = 0u;
+
+  /// \brief Vertex range, [first, second), that is out of date in each
+  /// copy of the dynamic vertex buffer. Ogre keeps one copy per frame in
+  /// flight and each map() moves on to the next copy, so a copy has to
+  /// catch up on all changes made since it was last written.
+  public: std::vector<std::pair<unsigned int, unsigned int>> staleRanges;
+
+  /// \brief Min corner of the bounds of the vertices
+  public: Ogre::Vector3 boundsMin = Ogre::Vector3::ZERO;
+
+  /// \brief Max corner of the bounds of the vertices
+  public: Ogre::Vector3 boundsMax = Ogre::Vector3::ZERO;
+
+  /// \brief True if the bounds need to be recomputed from all vertices,
+  /// e.g. after moving a point that was on the boundary.
+  public: bool boundsDirty = false;
+
+  /// \brief Mark a range of vertices as changed
+  /// \param[in] _begin First vertex that changed
+  /// \param[in] _end One past the last vertex that changed
+  public: void MarkDirty(unsigned int _begin, unsigned int _end);
+
+  /// \brief Grow the bounds to include a point
+  /// \param[in] _pt Point to include
+  /// \param[in] _first True if this is the first point
+  public: void MergeBounds(const Ogre::Vector3 &_pt, bool _first);
+
+  /// \brief Get the number of vertices
+  /// \return Number of vertices in vertexData
+  public: unsigned int VertexCount() const;
+
+  /// \brief Replace all vertices with points read from packed arrays
+  /// \param[in] _xyz Positions, 3 floats per point
+  /// \param[in] _rgba Colors, 4 floats per point. Null for white.
+  /// \param[in] _count Number of points
+  public: void CopyPoints(const float *_xyz, const float *_rgba,
+              std::size_t _count);
+
+  /// \brief Copy points set in bulk into vertexData, if there are any
+  public: void ApplyPendingPoints();
+
+  /// \brief Drop points set in bulk that were not copied yet
+  public: void ClearPendingPoints();
 
   /// \brief Maximum capacity of the currently allocated vertex buffer.
   public: size_t vertexBufferCapacity = 0;
@@ -97,6 +172,110 @@ class gz::rendering::Ogre2DynamicRenderablePrivate
 using namespace gz;
 using namespace rendering;
 
+//////////////////////////////////////////////////
+void Ogre2DynamicRenderablePrivate::MarkDirty(unsigned int _begin,
+    unsigned int _end)
+{
+  if (this->dirtyBegin >= this->dirtyEnd)
+  {
+    this->dirtyBegin = _begin;
+    this->dirtyEnd = _end;
+  }
+  else
+  {
+    this->dirtyBegin = std::min(this->dirtyBegin, _begin);
+    this->dirtyEnd = std::max(this->dirtyEnd, _end);
+  }
+  this->dirty = true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2DynamicRenderablePrivate::MergeBounds(const Ogre::Vector3 &_pt,
+    bool _first)
+{
+  if (this->boundsDirty)
+    return;
+
+  if (_first)
+  {
+    this->boundsMin = _pt;
+    this->boundsMax = _pt;
+    return;
+  }
+  this->boundsMin.makeFloor(_pt);
+  this->boundsMax.makeCeil(_pt);
+}
+
+//////////////////////////////////////////////////
+unsigned int Ogre2DynamicRenderablePrivate::VertexCount() const
+{
+  return static_cast<unsigned int>(this->vertexData.size() / 6u);
+}
+
+//////////////////////////////////////////////////
+void Ogre2DynamicRenderablePrivate::CopyPoints(const float *_xyz,
+    const float *_rgba, std::size_t _count)
+{
+  // positions go straight into the vertex buffer layout. Normals or point
+  // colors are filled in on update.
+  this->vertexData.resize(_count * 6u);
+  this->colors.resize(_count * 4u);
+  float *dst = this->vertexData.data();
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const float *src = _xyz + i * 3u;
+    float *v = dst + i * 6u;
+    v[0] = src[0];
+    v[1] = src[1];
+    v[2] = src[2];
+    v[3] = 0.0f;
+    v[4] = 0.0f;
+    v[5] = 0.0f;
+  }
+
+  if (_rgba)
+    std::copy(_rgba, _rgba + _count * 4u, this->colors.begin());
+  else
+    std::fill(this->colors.begin(), this->colors.end(), 1.0f);
+
+  this->boundsDirty = true;
+  this->dirtyBegin = 0u;
+  this->dirtyEnd = static_cast<unsigned int>(_count);
+  this->dirty = true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2DynamicRenderablePrivate::ApplyPendingPoints()
+{
+  if (!this->pending)
+    return;
+
+  this->CopyPoints(this->pendingXyz, this->pendingRgba, this->pendingCount);
+  this->ClearPendingPoints();
+}
+
+//////////////////////////////////////////////////
+void Ogre2DynamicRenderablePrivate::ClearPendingPoints()
+{
+  this->pending = false;
+  this->pendingXyz = nullptr;
+  this->pendingRgba = nullptr;
+  this->pendingCount = 0u;
+  this->ownedXyz = std::vector<float>();
+  this->ownedRgba = std::vector<float>();
+}
+
+/// \brief Get the position of a vertex from packed vertex data
+/// \param[in] _vbuffer Vertex data, 6 floats per vertex
+/// \param[in] _index Index of the vertex
+/// \return Position of the vertex
+static math::Vector3d VertexPosition(const float *_vbuffer,
+    unsigned int _index)
+{
+  const float *v = _vbuffer + _index * 6u;
+  return math::Vector3d(v[0], v[1], v[2]);
+}
+
 //////////////////////////////////////////////////
 Ogre2DynamicRenderable::Ogre2DynamicRenderable(
     ScenePtr _scene)
@@ -152,9 +331,6 @@ void Ogre2DynamicRenderable::Destroy()
 //////////////////////////////////////////////////
 void Ogre2DynamicRenderable::DestroyBuffer()
 {
-  if (this->dataPtr->vbuffer)
-    delete [] this->dataPtr->vbuffer;
-
   Ogre::RenderSystem *renderSystem =
       this->dataPtr->sceneManager->getDestinationRenderSystem();
   Ogre::VaoManager *vaoManager = renderSystem->getVaoManager();
@@ -175,7 +351,6 @@ void Ogre2DynamicRenderable::DestroyBuffer()
 
   this->dataPtr->vertexBuffer = nullptr;
   this->dataPtr->vao = nullptr;
-  this->dataPtr->vbuffer = nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -213,6 +388,8 @@ void Ogre2DynamicRenderable::CreateDynamicMesh()
 //////////////////////////////////////////////////
 void Ogre2DynamicRenderable::UpdateBuffer()
 {
+  this->dataPtr->ApplyPendingPoints();
+
   if (!this->dataPtr->dirty)
     return;
 
@@ -226,7 +403,7 @@ void Ogre2DynamicRenderable::UpdateBuffer()
   // Prepare vertex buffer
   unsigned int newVertCapacity = this->dataPtr->vertexBufferCapacity;
 
-  unsigned int vertexCount = this->dataPtr->vertices.size();
+  unsigned int vertexCount = this->dataPtr->VertexCount();
   if ((vertexCount > this->dataPtr->vertexBufferCapacity) ||
       (!this->dataPtr->vertexBufferCapacity))
   {
@@ -253,16 +430,13 @@ void Ogre2DynamicRenderable::UpdateBuffer()
   }
 
   // recreate vao if needed
+  bool recreated = false;
   if (newVertCapacity != this->dataPtr->vertexBufferCapacity)
   {
     this->dataPtr->vertexBufferCapacity = newVertCapacity;
 
     this->DestroyBuffer();
 
-    unsigned int size = this->dataPtr->vertexBufferCapacity * 6;
-    this->dataPtr->vbuffer = new float[size];
-    memset(this->dataPtr->vbuffer, 0, size * sizeof(float));
-
     this->dataPtr->subMesh->mVao[Ogre::VpNormal].clear();
     this->dataPtr->subMesh->mVao[Ogre::VpShadow].clear();
 
@@ -276,7 +450,7 @@ void Ogre2DynamicRenderable::UpdateBuffer()
     // create vertex buffer
     this->dataPtr->vertexBuffer = vaoManager->createVertexBuffer(
         vertexElements, this->dataPtr->vertexBufferCapacity,
-        Ogre::BT_DYNAMIC_PERSISTENT, this->dataPtr->vbuffer, false);
+        Ogre::BT_DYNAMIC_PERSISTENT, nullptr, false);
 
     Ogre::VertexBufferPackedVec vertexBuffers;
     vertexBuffers.push_back(this->dataPtr->vertexBuffer);
@@ -290,62 +464,85 @@ void Ogre2DynamicRenderable::UpdateBuffer()
     this->dataPtr->subMesh->mVao[Ogre::VpNormal].push_back(this->dataPtr->vao);
     // Use the same geometry for shadow casting.
     this->dataPtr->subMesh->mVao[Ogre::VpShadow].push_back(this->dataPtr->vao);
+
+    // every copy of the new buffer needs all vertices
+    this->dataPtr->dirtyBegin = 0u;
+    this->dataPtr->dirtyEnd = vertexCount;
+    this->dataPtr->staleRanges.assign(
+        vaoManager->getDynamicBufferMultiplier(), {0u, 0u});
+    recreated = true;
   }
 
-  // map buffer and update the geometry
-  Ogre::Aabb bbox;
-  float * RESTRICT_ALIAS vertices = reinterpret_cast<float * RESTRICT_ALIAS>(
-      this->dataPtr->vertexBuffer->map(
-      0, this->dataPtr->vertexBuffer->getNumElements()));
+  // positions of changed vertices are already in place
+  unsigned int begin = std::min(this->dataPtr->dirtyBegin, vertexCount);
+  unsigned int end = std::min(this->dataPtr->dirtyEnd, vertexCount);
+  float *vbuffer = this->dataPtr->vertexData.data();
 
-  // fill vertices
-  for (unsigned int i = 0; i < vertexCount; ++i)
-  {
-    unsigned int idx = i*6;
-    Ogre::Vector3 v = Ogre2Conversions::Convert(this->dataPtr->vertices[i]);
-    vertices[idx] = v.x;
-    vertices[idx+1] = v.y;
-    vertices[idx+2] = v.z;
+  // fill normals. This may widen the range, e.g. to whole triangles
+  this->GenerateNormals(this->dataPtr->operationType, vertexCount,
+      vbuffer, begin, end);
 
-    bbox.merge(v);
-  }
+  // fill colors for points
+  this->GenerateColors(this->dataPtr->operationType, vbuffer, begin, end);
 
-  // fill the rest of the buffer with the position of the last vertex to avoid
-  // the geometry connecting back to 0, 0, 0
-  if (vertexCount > 0 && vertexCount < this->dataPtr->vertexBufferCapacity)
+  if (begin < end)
   {
-    math::Vector3d lastVertex = this->dataPtr->vertices[vertexCount-1];
-    for (unsigned int i = vertexCount; i < this->dataPtr->vertexBufferCapacity;
-        ++i)
+    for (auto &range : this->dataPtr->staleRanges)
     {
-      unsigned int idx = i * 6;
-      vertices[idx] = lastVertex.X();
-      vertices[idx+1] = lastVertex.Y();
-      vertices[idx+2] = lastVertex.Z();
-
-      vertices[idx+3] = 0;
-      vertices[idx+4] = 0;
-      vertices[idx+5] = 1;
+      if (range.first >= range.second)
+        range = {begin, end};
+      else
+        range = {std::min(range.first, begin), std::max(range.second, end)};
     }
   }
 
-  // fill normals
-  this->GenerateNormals(this->dataPtr->operationType, this->dataPtr->vertices,
-      vertices);
-
-  // fill colors for points
-  this->GenerateColors(this->dataPtr->operationType, this->dataPtr->vertices,
-      vertices);
+  // upload the stale part of the buffer copy that map() hands out next,
+  // which is the one after the copy currently drawn. The vertex buffer is
+  // persistently mapped so this only copies memory.
+  Ogre::VertexBufferPacked *vertexBuffer = this->dataPtr->vertexBuffer;
+  size_t drawnCopy = (vertexBuffer->_getFinalBufferStart() -
+      vertexBuffer->_getInternalBufferStart()) /
+      vertexBuffer->_getInternalNumElements();
+  auto &range = this->dataPtr->staleRanges[
+      (drawnCopy + 1u) % this->dataPtr->staleRanges.size()];
+  range.second = std::min(range.second, vertexCount);
+  if (range.first < range.second)
+  {
+    unsigned int count = range.second - range.first;
+    float * RESTRICT_ALIAS vertices = reinterpret_cast<float * RESTRICT_ALIAS>(
+        vertexBuffer->map(range.first, count));
+    memcpy(vertices, vbuffer + range.first * 6, count * 6 * sizeof(float));
+    vertexBuffer->unmap(Ogre::UO_KEEP_PERSISTENT);
+  }
+  range = {0u, 0u};
 
-  // unmap buffer
-  this->dataPtr->vertexBuffer->unmap(Ogre::UO_KEEP_PERSISTENT);
+  // only draw the vertices in use instead of padding the rest of the buffer
+  this->dataPtr->vao->setPrimitiveRange(0u, vertexCount);
 
   // Set the bounds to get frustum culling and LOD to work correctly.
+  if (this->dataPtr->boundsDirty)
+  {
+    this->dataPtr->boundsDirty = false;
+    for (unsigned int i = 0; i < vertexCount; ++i)
+    {
+      this->dataPtr->MergeBounds(Ogre::Vector3(vbuffer + i * 6u), i == 0u);
+    }
+  }
+  Ogre::Aabb bbox;
+  if (vertexCount > 0u)
+  {
+    bbox = Ogre::Aabb::newFromExtents(
+        this->dataPtr->boundsMin, this->dataPtr->boundsMax);
+  }
   Ogre::Mesh *mesh = this->dataPtr->subMesh->mParent;
   mesh->_setBounds(bbox, true);
 
   // update item aabb
-  if (this->dataPtr->ogreItem)
+  if (this->dataPtr->ogreItem && !recreated)
+  {
+    this->dataPtr->ogreItem->setLocalAabb(bbox);
+  }
+  else if (this->dataPtr->ogreItem)
   {
     bool castShadows = this->dataPtr->ogreItem->getCastShadows();
     auto lowLevelMat = this->dataPtr->ogreItem->getSubItem(0)->getMaterial();
@@ -373,6 +570,8 @@ void Ogre2DynamicRenderable::UpdateBuffer()
     }
   }
 
+  this->dataPtr->dirtyBegin = 0u;
+  this->dataPtr->dirtyEnd = 0u;
   this->dataPtr->dirty = false;
 }
 
@@ -409,6 +608,9 @@ void Ogre2DynamicRenderable::SetOperationType(MarkerType _opType)
       gzerr << "Unknown render operation type[" << _opType << "]\n";
       return;
   }
+
+  // normals and colors depend on the operation type
+  this->dataPtr->MarkDirty(0u, this->dataPtr->VertexCount());
 }
 
 //////////////////////////////////////////////////
@@ -450,15 +652,23 @@ MarkerType Ogre2DynamicRenderable::OperationType() const
 void Ogre2DynamicRenderable::AddPoint(const math::Vector3d &_pt,
                                       const math::Color &_color)
 {
-  this->dataPtr->vertices.push_back(_pt);
+  this->dataPtr->ApplyPendingPoints();
+
+  Ogre::Vector3 v = Ogre2Conversions::Convert(_pt);
+  unsigned int index = this->dataPtr->VertexCount();
+  this->dataPtr->MergeBounds(v, index == 0u);
+  this->dataPtr->vertexData.insert(this->dataPtr->vertexData.end(),
+      {v.x, v.y, v.z, 0.0f, 0.0f, 0.0f});
 
   // todo(anyone)
   // setting material works but vertex coloring only works for points
   // It requires using an unlit datablock:
   // https://forums.ogre3d.org/viewtopic.php?t=93627#p539276
-  this->dataPtr->colors.push_back(_color);
+  this->dataPtr->colors.insert(this->dataPtr->colors.end(),
+      {_color.R(), _color.G(), _color.B(), _color.A()});
 
-  this->dataPtr->dirty = true;
+  // appending only needs the new vertex to be uploaded
+  this->dataPtr->MarkDirty(index, index + 1u);
 }
 
 /////////////////////////////////////////////////
@@ -468,30 +678,100 @@ void Ogre2DynamicRenderable::AddPoint(double _x, double _y, double _z,
   this->AddPoint(math::Vector3d(_x, _y, _z), _color);
 }
 
+/////////////////////////////////////////////////
+void Ogre2DynamicRenderable::SetPoints(const float *_xyz, const float *_rgba,
+    std::size_t _count, bool _borrow)
+{
+  if (!_xyz && _count > 0u)
+  {
+    gzerr << "Null point positions given for [" << _count << "] points\n";
+    return;
+  }
+
+  this->dataPtr->ClearPendingPoints();
+  if (_borrow)
+  {
+    // copied into the vertex buffer layout on the next update
+    this->dataPtr->pendingXyz = _xyz;
+    this->dataPtr->pendingRgba = _rgba;
+    this->dataPtr->pendingCount = _count;
+    this->dataPtr->pending = true;
+    this->dataPtr->dirty = true;
+    return;
+  }
+
+  this->dataPtr->CopyPoints(_xyz, _rgba, _count);
+}
+
+/////////////////////////////////////////////////
+void Ogre2DynamicRenderable::SetPoints(std::vector<float> &&_xyz,
+    std::vector<float> &&_rgba)
+{
+  if (_xyz.size() % 3u != 0u ||
+      (!_rgba.empty() && _rgba.size() != _xyz.size() / 3u * 4u))
+  {
+    gzerr << "Point array sizes do not match. Expected 3 floats per "
+          << "position and 4 floats per color, got [" << _xyz.size()
+          << "] and [" << _rgba.size() << "]\n";
+    return;
+  }
+
+  this->dataPtr->ClearPendingPoints();
+  this->dataPtr->ownedXyz = std::move(_xyz);
+  this->dataPtr->ownedRgba = std::move(_rgba);
+  this->dataPtr->pendingXyz = this->dataPtr->ownedXyz.data();
+  this->dataPtr->pendingRgba = this->dataPtr->ownedRgba.empty() ?
+      nullptr : this->dataPtr->ownedRgba.data();
+  this->dataPtr->pendingCount = this->dataPtr->ownedXyz.size() / 3u;
+  this->dataPtr->pending = true;
+  this->dataPtr->dirty = true;
+}
+
 /////////////////////////////////////////////////
 void Ogre2DynamicRenderable::SetPoint(unsigned int _index,
                                       const math::Vector3d &_value)
 {
-  if (_index >= this->dataPtr->vertices.size())
+  this->dataPtr->ApplyPendingPoints();
+
+  if (_index >= this->dataPtr->VertexCount())
   {
     gzerr << "Point index[" << _index << "] is out of bounds[0-"
-           << this->dataPtr->vertices.size()-1 << "]\n";
+           << static_cast<int>(this->dataPtr->VertexCount()) - 1 << "]\n";
     return;
   }
 
-  this->dataPtr->vertices[_index] = _value;
+  // the bounds can only shrink if the old point was on the boundary
+  float *v = this->dataPtr->vertexData.data() + _index * 6u;
+  for (unsigned int i = 0; i < 3u; ++i)
+  {
+    if (v[i] == this->dataPtr->boundsMin[i] ||
+        v[i] == this->dataPtr->boundsMax[i])
+    {
+      this->dataPtr->boundsDirty = true;
+      break;
+    }
+  }
 
-  this->dataPtr->dirty = true;
+  Ogre::Vector3 value = Ogre2Conversions::Convert(_value);
+  this->dataPtr->MergeBounds(value, false);
+  v[0] = value.x;
+  v[1] = value.y;
+  v[2] = value.z;
+
+  this->dataPtr->MarkDirty(_index, _index + 1u);
 }
 
 /////////////////////////////////////////////////
 void Ogre2DynamicRenderable::SetColor(unsigned int _index,
                                       const math::Color &_color)
 {
-  if (_index >= this->dataPtr->colors.size())
+  this->dataPtr->ApplyPendingPoints();
+
+  if (_index >= this->dataPtr->colors.size() / 4u)
   {
     gzerr << "Point color index[" << _index << "] is out of bounds[0-"
-           << this->dataPtr->colors.size()-1 << "]\n";
+           << static_cast<int>(this->dataPtr->colors.size() / 4u) - 1
+           << "]\n";
     return;
   }
 
@@ -500,42 +780,55 @@ void Ogre2DynamicRenderable::SetColor(unsigned int _index,
   // vertex coloring only works for points.
   // Full implementation requires using an unlit datablock:
   // https://forums.ogre3d.org/viewtopic.php?t=93627#p539276
-  this->dataPtr->colors[_index] = _color;
+  float *color = this->dataPtr->colors.data() + _index * 4u;
+  color[0] = _color.R();
+  color[1] = _color.G();
+  color[2] = _color.B();
+  color[3] = _color.A();
 
-  this->dataPtr->dirty = true;
+  this->dataPtr->MarkDirty(_index, _index + 1u);
 }
 
 /////////////////////////////////////////////////
 math::Vector3d Ogre2DynamicRenderable::Point(
     const unsigned int _index) const
 {
-  if (_index >= this->dataPtr->vertices.size())
+  this->dataPtr->ApplyPendingPoints();
+
+  if (_index >= this->dataPtr->VertexCount())
   {
     gzerr << "Point index[" << _index << "] is out of bounds[0-"
-           << this->dataPtr->vertices.size()-1 << "]\n";
+           << static_cast<int>(this->dataPtr->VertexCount()) - 1 << "]\n";
 
     return math::Vector3d(math::INF_D,
                                     math::INF_D,
                                     math::INF_D);
   }
 
-  return this->dataPtr->vertices[_index];
+  return VertexPosition(this->dataPtr->vertexData.data(), _index);
 }
 
 /////////////////////////////////////////////////
 unsigned int Ogre2DynamicRenderable::PointCount() const
 {
-  return this->dataPtr->vertices.size();
+  if (this->dataPtr->pending)
+    return static_cast<unsigned int>(this->dataPtr->pendingCount);
+  return this->dataPtr->VertexCount();
 }
 
 /////////////////////////////////////////////////
 void Ogre2DynamicRenderable::Clear()
 {
-  if (this->dataPtr->vertices.empty() && this->dataPtr->colors.empty())
+  if (this->dataPtr->vertexData.empty() && this->dataPtr->colors.empty() &&
+      !this->dataPtr->pending)
+  {
     return;
+  }
 
-  this->dataPtr->vertices.clear();
+  this->dataPtr->ClearPendingPoints();
+  this->dataPtr->vertexData.clear();
   this->dataPtr->colors.clear();
+  this->dataPtr->boundsDirty = false;
   this->dataPtr->dirty = true;
 }
 
@@ -571,9 +864,12 @@ void Ogre2DynamicRenderable::SetMaterial(MaterialPtr _material, bool _unique)
 
 //////////////////////////////////////////////////
 void Ogre2DynamicRenderable::GenerateNormals(Ogre::OperationType _opType,
-  const std::vector<math::Vector3d> &_vertices, float *_vbuffer)
+  unsigned int _vertexCount, float *_vbuffer,
+  unsigned int &_begin, unsigned int &_end)
 {
-  unsigned int vertexCount = _vertices.size();
+  if (_begin >= _end)
+    return;
+
   // Each vertex occupies 6 elements in the vbuffer float array:
   // vbuffer[i]   : position x
   // vbuffer[i+1] : position y
@@ -589,18 +885,26 @@ void Ogre2DynamicRenderable::GenerateNormals(Ogre::OperationType _opType,
       return;
     case Ogre::OperationType::OT_TRIANGLE_LIST:
     {
-      if (vertexCount < 3)
+      if (_vertexCount < 3)
         return;
 
-      for (unsigned int i = 0; i < vertexCount / 3; ++i)
+      // only the triangles that contain a changed vertex
+      unsigned int first = _begin / 3;
+      unsigned int last = std::min((_end + 2) / 3, _vertexCount / 3);
+      if (first >= last)
+        return;
+      _begin = first * 3;
+      _end = last * 3;
+
+      for (unsigned int i = first; i < last; ++i)
       {
         unsigned int idx = i*3;
         unsigned int idx1 = idx * 6;
         unsigned int idx2 = idx1 + 6;
         unsigned int idx3 = idx2 + 6;
-        math::Vector3d v1 = _vertices[idx];
-        math::Vector3d v2 = _vertices[idx+1];
-        math::Vector3d v3 = _vertices[idx+2];
+        math::Vector3d v1 = VertexPosition(_vbuffer, idx);
+        math::Vector3d v2 = VertexPosition(_vbuffer, idx+1);
+        math::Vector3d v3 = VertexPosition(_vbuffer, idx+2);
         math::Vector3d n = (v1 - v2).Cross((v1 - v3));
 
         _vbuffer[idx1+3] = n.X();
@@ -618,15 +922,22 @@ void Ogre2DynamicRenderable::GenerateNormals(Ogre::OperationType _opType,
     }
     case Ogre::OperationType::OT_TRIANGLE_STRIP:
     {
-      if (vertexCount < 3)
+      if (_vertexCount < 3)
         return;
 
+      // normals are averaged with the neighbouring triangles so moving one
+      // vertex affects the whole strip
+      _begin = 0;
+      _end = _vertexCount;
+      for (unsigned int i = 0; i < _vertexCount; ++i)
+        std::fill(_vbuffer + i * 6 + 3, _vbuffer + i * 6 + 6, 0.0f);
+
       bool even = false;
-      for (unsigned int i = 0; i < vertexCount - 2; ++i)
+      for (unsigned int i = 0; i < _vertexCount - 2; ++i)
       {
         math::Vector3d v1;
         math::Vector3d v2;
-        math::Vector3d v3 = _vertices[i+2];
+        math::Vector3d v3 = VertexPosition(_vbuffer, i+2);
 
         // For odd n, vertices n, n+1, and n+2 define triangle n.
         // For even n, vertices n+1, n, and n+2 define triangle n.
@@ -635,15 +946,15 @@ void Ogre2DynamicRenderable::GenerateNormals(Ogre::OperationType _opType,
         unsigned int idx3 = (i+2) * 6;
         if (even)
         {
-          v1 = _vertices[i+1];
-          v2 = _vertices[i];
+          v1 = VertexPosition(_vbuffer, i+1);
+          v2 = VertexPosition(_vbuffer, i);
           idx1 = (i+1) * 6;
           idx2 = i*6;
         }
         else
         {
-          v1 = _vertices[i];
-          v2 = _vertices[i+1];
+          v1 = VertexPosition(_vbuffer, i);
+          v2 = VertexPosition(_vbuffer, i+1);
           idx1 = i*6;
           idx2 = (i+1) * 6;
         }
@@ -676,18 +987,25 @@ void Ogre2DynamicRenderable::GenerateNormals(Ogre::OperationType _opType,
     }
     case Ogre::OperationType::OT_TRIANGLE_FAN:
     {
-      if (vertexCount < 3)
+      if (_vertexCount < 3)
         return;
 
+      // all triangles share the first vertex so its normal depends on
+      // every vertex of the fan
+      _begin = 0;
+      _end = _vertexCount;
+      for (unsigned int i = 0; i < _vertexCount; ++i)
+        std::fill(_vbuffer + i * 6 + 3, _vbuffer + i * 6 + 6, 0.0f);
+
       unsigned int idx1 = 0;
-      math::Vector3d v1 = _vertices[0];
+      math::Vector3d v1 = VertexPosition(_vbuffer, 0);
 
-      for (unsigned int i = 0; i < vertexCount - 2; ++i)
+      for (unsigned int i = 0; i < _vertexCount - 2; ++i)
       {
         unsigned int idx2 = (i+1) * 6;
         unsigned int idx3 = idx2 + 6;
-        math::Vector3d v2 = _vertices[i+1];
-        math::Vector3d v3 = _vertices[i+2];
+        math::Vector3d v2 = VertexPosition(_vbuffer, i+1);
+        math::Vector3d v3 = VertexPosition(_vbuffer, i+2);
         math::Vector3d n = (v1 - v2).Cross((v1 - v3));
 
         math::Vector3d n1(_vbuffer[idx1+3], _vbuffer[idx1+4], _vbuffer[idx1+5]);
@@ -721,10 +1039,10 @@ void Ogre2DynamicRenderable::GenerateNormals(Ogre::OperationType _opType,
 
 //////////////////////////////////////////////////
 void Ogre2DynamicRenderable::GenerateColors(Ogre::OperationType _opType,
-  const std::vector<math::Vector3d> &_vertices, float *_vbuffer)
+  float *_vbuffer, unsigned int _begin, unsigned int _end)
 {
   // Skip if colors haven't been setup per-vertex correctly.
-  if (_vertices.size() != this->dataPtr->colors.size())
+  if (this->dataPtr->colors.size() / 4u != this->dataPtr->VertexCount())
     return;
 
   // Each vertex occupies 6 elements in the vbuffer float array. Normally,
@@ -740,15 +1058,14 @@ void Ogre2DynamicRenderable::GenerateColors(Ogre::OperationType _opType,
   {
     case Ogre::OperationType::OT_POINT_LIST:
     {
-      for (unsigned int i = 0; i < this->dataPtr->vertexBufferCapacity; ++i)
+      for (unsigned int i = _begin; i < _end; ++i)
       {
-        math::Color color = i < this->dataPtr->colors.size() ?
-            this->dataPtr->colors[i] : this->dataPtr->colors.back();
+        const float *color = this->dataPtr->colors.data() + i * 4;
 
         unsigned int idx = i * 6;
-        _vbuffer[idx+3] = color.R();
-        _vbuffer[idx+4] = color.G();
-        _vbuffer[idx+5] = color.B();
+        _vbuffer[idx+3] = color[0];
+        _vbuffer[idx+4] = color[1];
+        _vbuffer[idx+5] = color[2];
       }
 
       break;
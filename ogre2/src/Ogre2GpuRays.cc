@@ -15,6 +15,15 @@
  *
 */
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <vector>
+
 #include <gz/math/Vector2.hh>
 #include <gz/math/Vector3.hh>
 
@@ -36,6 +45,7 @@
 
 #include "Ogre2GzHlmsSphericalClipMinDistance.hh"
 #include "Ogre2ParticleNoiseListener.hh"
+#include "Ogre2TextureReadback.hh"
 #include "Terra/Hlms/PbsListener/OgreHlmsPbsTerraShadows.h"
 
 #include "Terra/Terra.h"
@@ -127,18 +137,28 @@ class GZ_RENDERING_OGRE2_HIDDEN gz::rendering::Ogre2GpuRaysPrivate
                unsigned int, unsigned int, unsigned int,
                const std::string &)> newGpuRaysFrame;
 
-  /// \brief Raw buffer of gpu rays data.
-  public: float *gpuRaysBuffer = nullptr;
-
   /// \brief Outgoing gpu rays data, used by newGpuRaysFrame event.
   public: float *gpuRaysScan = nullptr;
 
+  /// \brief Caller-owned buffer that gpu rays data is written to instead
+  /// of gpuRaysScan. Not owned by us.
+  public: float *outputBuffer = nullptr;
+
+  /// \brief Reads back the 2nd pass texture. Reused across frames to
+  /// avoid allocating a staging buffer on every update.
+  public: Ogre2TextureReadback readback;
+
   /// \brief Cubemap cameras
   public: Ogre::Camera *cubeCam[6];
 
-  /// \brief Texture packed with cubemap face and uv data
+  /// \brief Texture packed with cubemap face and uv data. Shared with all
+  /// gpu rays that have the same angle ranges and resolution.
   public: Ogre::TextureGpu *cubeUVTexture = nullptr;
 
+  /// \brief Key of cubeUVTexture in the sampler texture cache
+  public: std::tuple<double, double, double, double, unsigned int,
+      unsigned int> samplerKey;
+
   /// \brief Temporary texture where to render a side of the cubemap
   /// during GpuRays1stPass. Shared across all active faces to save memory
   public: Ogre::TextureGpu *colorTexture = nullptr;
@@ -217,6 +237,30 @@ static const uint32_t kLaserRetro1stPassQuad = 9526u;
 /// \brief standard deviation of particle noise
 static const double kParticleStddev = 0.01;
 
+/// \brief Min number of texels computed per thread when filling the
+/// cubemap sampler texture
+static const unsigned int kSamplerTexelsPerThread = 16384u;
+
+/// \brief Cubemap sampler texture shared by all gpu rays with the same
+/// angle ranges and resolution
+struct Ogre2GpuRaysSamplerTexture
+{
+  /// \brief The texture
+  Ogre::TextureGpu *texture = nullptr;
+
+  /// \brief Cubemap faces sampled by the texture
+  std::set<unsigned int> faces;
+
+  /// \brief Number of gpu rays using the texture
+  unsigned int refCount = 0u;
+};
+
+/// \brief Sampler textures keyed by min and max horizontal angle, min and
+/// max vertical angle, width and height. All rendering happens on one
+/// thread so this is not locked.
+static std::map<std::tuple<double, double, double, double, unsigned int,
+    unsigned int>, Ogre2GpuRaysSamplerTexture> g_samplerTextures;
+
 //////////////////////////////////////////////////
 Ogre2LaserRetroMaterialSwitcher::Ogre2LaserRetroMaterialSwitcher(
   Ogre2ScenePtr _scene, Ogre2GpuRays *_gpuRays, Ogre::Camera *_ogreCamera)
@@ -588,12 +632,6 @@ void Ogre2GpuRays::Destroy()
   if (!this->dataPtr->ogreCamera)
     return;
 
-  if (this->dataPtr->gpuRaysBuffer)
-  {
-    delete [] this->dataPtr->gpuRaysBuffer;
-    this->dataPtr->gpuRaysBuffer = nullptr;
-  }
-
   if (this->dataPtr->gpuRaysScan)
   {
     delete [] this->dataPtr->gpuRaysScan;
@@ -604,6 +642,8 @@ void Ogre2GpuRays::Destroy()
   auto ogreRoot = engine->OgreRoot();
   auto textureGpuManager = ogreRoot->getRenderSystem()->getTextureGpuManager();
 
+  this->dataPtr->readback.Destroy();
+
   Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
 
   // remove 1st pass textures, material, compositors
@@ -637,7 +677,13 @@ void Ogre2GpuRays::Destroy()
 
   if (this->dataPtr->cubeUVTexture)
   {
-    textureGpuManager->destroyTexture(this->dataPtr->cubeUVTexture);
+    // the sampler texture is shared, only destroy it with its last user
+    auto it = g_samplerTextures.find(this->dataPtr->samplerKey);
+    if (it != g_samplerTextures.end() && --it->second.refCount == 0u)
+    {
+      textureGpuManager->destroyTexture(it->second.texture);
+      g_samplerTextures.erase(it);
+    }
     this->dataPtr->cubeUVTexture = nullptr;
   }
   if (this->dataPtr->colorTexture)
@@ -830,16 +876,31 @@ void Ogre2GpuRays::CreateSampleTexture()
   double max = this->AngleMax().Radian();
   double vmin = this->VerticalAngleMin().Radian();
   double vmax = this->VerticalAngleMax().Radian();
+  const unsigned int width = this->dataPtr->w2nd;
+  const unsigned int height = this->dataPtr->h2nd;
+
+  // reuse the texture of gpu rays with the same ray pattern
+  this->dataPtr->samplerKey = std::make_tuple(min, max, vmin, vmax,
+      width, height);
+  auto cached = g_samplerTextures.find(this->dataPtr->samplerKey);
+  if (cached != g_samplerTextures.end())
+  {
+    cached->second.refCount++;
+    this->dataPtr->cubeUVTexture = cached->second.texture;
+    this->dataPtr->cubeFaceIdx.insert(cached->second.faces.begin(),
+        cached->second.faces.end());
+    return;
+  }
 
   double hAngle = std::max(this->dataPtr->kMinAllowedAngle.Radian(), max - min);
   double vAngle = std::max(this->dataPtr->kMinAllowedAngle.Radian(),
       vmax - vmin);
 
-  double hStep = hAngle / static_cast<double>(this->dataPtr->w2nd-1);
+  double hStep = hAngle / static_cast<double>(width-1);
   double vStep = 1.0;
   // non-planar case
-  if (this->dataPtr->h2nd > 1)
-    vStep = vAngle / static_cast<double>(this->dataPtr->h2nd-1);
+  if (height > 1)
+    vStep = vAngle / static_cast<double>(height-1);
 
   // create an RGB texture (cubeUVTex) to pack info that tells the shaders how
   // to sample from the cubemap textures.
@@ -853,7 +914,9 @@ void Ogre2GpuRays::CreateSampleTexture()
   auto ogreRoot = engine->OgreRoot();
   Ogre::TextureGpuManager *textureMgr =
     ogreRoot->getRenderSystem()->getTextureGpuManager();
-  std::string texName = this->Name() + "_samplerTex";
+  static unsigned int samplerTextureId = 0u;
+  std::string texName = "GpuRaysSamplerTex_" +
+      std::to_string(samplerTextureId++);
   this->dataPtr->cubeUVTexture =
     textureMgr->createOrRetrieveTexture(
       texName,
@@ -864,8 +927,7 @@ void Ogre2GpuRays::CreateSampleTexture()
       0u);
 
   this->dataPtr->cubeUVTexture->setTextureType(Ogre::TextureTypes::Type2D);
-  this->dataPtr->cubeUVTexture->setResolution(
-    this->dataPtr->w2nd, this->dataPtr->h2nd);
+  this->dataPtr->cubeUVTexture->setResolution(width, height);
   this->dataPtr->cubeUVTexture->setNumMipmaps(1u);
   this->dataPtr->cubeUVTexture->setPixelFormat(Ogre::PFG_RGBA32_FLOAT);
 
@@ -883,36 +945,72 @@ void Ogre2GpuRays::CreateSampleTexture()
   float *pDest = reinterpret_cast<float*>(
     OGRE_MALLOC_SIMD(dataSize, Ogre::MEMCATEGORY_RESOURCE));
 
-  double v = vmin;
-  int index = 0;
-  for (unsigned int i = 0; i < this->dataPtr->h2nd; ++i)
+  // The sample direction is a Y up cubemap direction (0, 0, 1) rotated by
+  // a pitch of -v around X then a yaw of -h around Y, which simplifies to
+  // (-cos(v) sin(h), sin(v), cos(v) cos(h)). Sines and cosines only depend
+  // on the column or the row so they are computed once.
+  std::vector<double> sinH(width);
+  std::vector<double> cosH(width);
+  for (unsigned int j = 0; j < width; ++j)
+  {
+    double h = min + j * hStep;
+    sinH[j] = std::sin(h);
+    cosH[j] = std::cos(h);
+  }
+
+  // fill rows in parallel for large textures. Each thread records the
+  // faces it sampled separately.
+  unsigned int threadCount = std::max(1u, std::min(
+      std::thread::hardware_concurrency(),
+      width * height / kSamplerTexelsPerThread));
+  std::vector<std::array<bool, 6>> faces(threadCount);
+  auto fillRows = [&](unsigned int _t)
   {
-    double h = min;
-    for (unsigned int j = 0; j < this->dataPtr->w2nd; ++j)
+    faces[_t].fill(false);
+    for (unsigned int i = _t; i < height; i += threadCount)
     {
-      // set up dir vector to sample from a standard Y up cubemap
-      math::Vector3d ray(0, 0, 1);
-      ray.Normalize();
-      math::Quaterniond pitch(math::Vector3d(1, 0, 0), -v);
-      math::Quaterniond yaw(math::Vector3d(0, 1, 0), -h);
-      math::Vector3d dir = yaw * pitch * ray;
-      unsigned int faceIdx;
-      math::Vector2d uv = this->SampleCubemap(dir, faceIdx);
-      this->dataPtr->cubeFaceIdx.insert(faceIdx);
-      // gzdbg << "p(" << pitch << ") y(" << yaw << "): " << dir << " | "
-      //       << uv << " | " << faceIdx << std::endl;
-      // u
-      pDest[index++] = uv.X();
-      // v
-      pDest[index++] = uv.Y();
-      // face
-      pDest[index++] = static_cast<float>(faceIdx);
-      // unused
-      pDest[index++] = 1.0;
-      h += hStep;
+      double v = vmin + i * vStep;
+      double sinV = std::sin(v);
+      double cosV = std::cos(v);
+      float *row = pDest + static_cast<size_t>(i) * width * 4u;
+      for (unsigned int j = 0; j < width; ++j)
+      {
+        math::Vector3d dir(-cosV * sinH[j], sinV, cosV * cosH[j]);
+        unsigned int faceIdx;
+        math::Vector2d uv = this->SampleCubemap(dir, faceIdx);
+        faces[_t][faceIdx] = true;
+        // u
+        row[j * 4u] = uv.X();
+        // v
+        row[j * 4u + 1u] = uv.Y();
+        // face
+        row[j * 4u + 2u] = static_cast<float>(faceIdx);
+        // unused
+        row[j * 4u + 3u] = 1.0;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned int t = 1; t < threadCount; ++t)
+    threads.emplace_back(fillRows, t);
+  fillRows(0u);
+  for (auto &thread : threads)
+    thread.join();
+
+  Ogre2GpuRaysSamplerTexture &entry =
+      g_samplerTextures[this->dataPtr->samplerKey];
+  entry.texture = this->dataPtr->cubeUVTexture;
+  entry.refCount = 1u;
+  for (const auto &threadFaces : faces)
+  {
+    for (unsigned int f = 0; f < threadFaces.size(); ++f)
+    {
+      if (threadFaces[f])
+        entry.faces.insert(f);
     }
-    v += vStep;
   }
+  this->dataPtr->cubeFaceIdx.insert(entry.faces.begin(), entry.faces.end());
+
   this->dataPtr->cubeUVTexture->_transitionTo(
     Ogre::GpuResidency::Resident,
     reinterpret_cast<Ogre::uint8*>(pDest) );
@@ -1279,67 +1377,61 @@ void Ogre2GpuRays::PostRender()
   unsigned int width = this->dataPtr->w2nd;
   unsigned int height = this->dataPtr->h2nd;
 
+  // blit data from gpu to cpu
+  Ogre::TextureBox box =
+      this->dataPtr->readback.Map(this->dataPtr->secondPassTexture);
+
+  // Metal does not support RGB32_FLOAT so the internal texture format is
+  // RGBA32_FLOAT. For backward compatibility, output data is kept in RGB
+  // format instead of RGBA unless 4 channels are requested
   PixelFormat format = PF_FLOAT32_RGBA;
   unsigned int rawChannelCount = PixelUtil::ChannelCount(format);
   unsigned int bytesPerChannel = PixelUtil::BytesPerChannel(format);
-  int rawLen = width * height * rawChannelCount;
+  unsigned int channels = this->Channels();
 
-  if (!this->dataPtr->gpuRaysBuffer)
+  float *output = this->dataPtr->outputBuffer;
+  if (!output)
   {
-    this->dataPtr->gpuRaysBuffer = new float[rawLen];
+    if (!this->dataPtr->gpuRaysScan)
+      this->dataPtr->gpuRaysScan = new float[width * height * channels];
+    output = this->dataPtr->gpuRaysScan;
   }
 
-  // blit data from gpu to cpu
-  Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->secondPassTexture, 0u, 0u);
-  Ogre::TextureBox box = image.getData(0u);
-  float *bufferTmp = static_cast<float *>(box.data);
-
-  // TODO(anyone): It seems wasteful to have gpuRaysBuffer at all
-  // We should be able to convert directly from bufferTmp to gpuRaysScan
-
-  // copy data row by row. The texture box may not be a contiguous region of
-  // a texture
-  for (unsigned int i = 0; i < height; ++i)
+  // convert data row by row straight from the mapped texture into the
+  // output buffer. The texture box may not be a contiguous region of a
+  // texture
+  const unsigned char *src = static_cast<const unsigned char *>(box.data);
+  if (channels == rawChannelCount &&
+      box.bytesPerRow == width * rawChannelCount * bytesPerChannel)
   {
-    unsigned int rawDataRowIdx = i * box.bytesPerRow / bytesPerChannel;
-    unsigned int rowIdx = i * width * rawChannelCount;
-    memcpy(&this->dataPtr->gpuRaysBuffer[rowIdx], &bufferTmp[rawDataRowIdx],
-        width * rawChannelCount * bytesPerChannel);
+    memcpy(output, src, width * height * rawChannelCount * bytesPerChannel);
   }
-
-  // Metal does not support RGB32_FLOAT so the internal texture format is
-  // RGBA32_FLOAT. For backward compatibility, output data is kept in RGB
-  // format instead of RGBA
-  int outputLen = width * height * this->Channels();
-  if (!this->dataPtr->gpuRaysScan)
-  {
-    this->dataPtr->gpuRaysScan = new float[outputLen];
-  }
-
-  // copy data from RGBA buffer to RGB buffer
-  for (unsigned int row = 0; row < height; ++row)
+  else
   {
-    // the texture box step size could be larger than our image buffer step
-    // size
-    for (unsigned int column = 0; column < width; ++column)
+    for (unsigned int row = 0; row < height; ++row)
     {
-      unsigned int idx = (row * width * this->Channels()) +
-          column * this->Channels();
-      unsigned int rawIdx = (row * width * rawChannelCount) +
-          column * rawChannelCount;
-
-      this->dataPtr->gpuRaysScan[idx] =
-          this->dataPtr->gpuRaysBuffer[rawIdx];
-      this->dataPtr->gpuRaysScan[idx + 1] =
-          this->dataPtr->gpuRaysBuffer[rawIdx + 1];
-      this->dataPtr->gpuRaysScan[idx + 2] =
-          this->dataPtr->gpuRaysBuffer[rawIdx + 2];
+      const float *srcRow =
+          reinterpret_cast<const float *>(src + row * box.bytesPerRow);
+      float *dstRow = output + row * width * channels;
+      if (channels == rawChannelCount)
+      {
+        memcpy(dstRow, srcRow, width * rawChannelCount * bytesPerChannel);
+        continue;
+      }
+      for (unsigned int column = 0; column < width; ++column)
+      {
+        dstRow[0] = srcRow[0];
+        dstRow[1] = srcRow[1];
+        dstRow[2] = srcRow[2];
+        dstRow += channels;
+        srcRow += rawChannelCount;
+      }
     }
   }
+  this->dataPtr->readback.Unmap();
 
-  this->dataPtr->newGpuRaysFrame(this->dataPtr->gpuRaysScan,
-      width, height, this->Channels(), "PF_FLOAT32_RGB");
+  this->dataPtr->newGpuRaysFrame(output, width, height, channels,
+      channels == rawChannelCount ? "PF_FLOAT32_RGBA" : "PF_FLOAT32_RGB");
 
   // Uncomment to debug output
   // std::cerr << "wxh: " << width << " x " << height << std::endl;
@@ -1349,11 +1441,11 @@ void Ogre2GpuRays::PostRender()
   //   {
   //     std::cerr
   //     << "["
-  //     << this->dataPtr->gpuRaysScan[i*width*3 + j*3]
+  //     << output[i*width*channels + j*channels]
   //     <<  " "
-  //     << this->dataPtr->gpuRaysScan[i*width*3 + j*3 + 1]
+  //     << output[i*width*channels + j*channels + 1]
   //     <<  " "
-  //     << this->dataPtr->gpuRaysScan[i*width*3 + j*3 + 2]
+  //     << output[i*width*channels + j*channels + 2]
   //     <<  "]\n";
   //   }
   //   std::cerr << std::endl;
@@ -1363,17 +1455,58 @@ void Ogre2GpuRays::PostRender()
 //////////////////////////////////////////////////
 const float* Ogre2GpuRays::Data() const
 {
+  if (this->dataPtr->outputBuffer)
+    return this->dataPtr->outputBuffer;
   return this->dataPtr->gpuRaysScan;
 }
 
 //////////////////////////////////////////////////
 void Ogre2GpuRays::Copy(float *_dataDest)
 {
+  const float *data = this->Data();
+  if (!data || data == _dataDest)
+    return;
+
   unsigned int width = this->dataPtr->w2nd;
   unsigned int height = this->dataPtr->h2nd;
 
-  memcpy(_dataDest, this->dataPtr->gpuRaysScan,
-    width * height * 3 * sizeof(float));
+  memcpy(_dataDest, data,
+    width * height * this->Channels() * sizeof(float));
+}
+
+//////////////////////////////////////////////////
+void Ogre2GpuRays::SetOutputBuffer(float *_buffer)
+{
+  this->dataPtr->outputBuffer = _buffer;
+}
+
+//////////////////////////////////////////////////
+float *Ogre2GpuRays::OutputBuffer() const
+{
+  return this->dataPtr->outputBuffer;
+}
+
+//////////////////////////////////////////////////
+void Ogre2GpuRays::SetChannels(unsigned int _channels)
+{
+  if (_channels != 3u && _channels != 4u)
+  {
+    gzerr << "Gpu rays only supports 3 or 4 channels, got " << _channels
+          << std::endl;
+    return;
+  }
+
+  if (_channels == this->channels)
+    return;
+
+  this->channels = _channels;
+
+  // internal buffer is reallocated with the new size on next update
+  if (this->dataPtr->gpuRaysScan)
+  {
+    delete [] this->dataPtr->gpuRaysScan;
+    this->dataPtr->gpuRaysScan = nullptr;
+  }
 }
 
 /////////////////////////////////////////////////
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <sstream>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
+
+#include "Ogre2CacheFile.hh"
+#include "Ogre2CacheHash.hh"
+#include "Ogre2HlmsCache.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreGpuProgramManager.h>
+#include <OgreHlmsDiskCache.h>
+#include <OgreHlmsManager.h>
+#include <OgreRenderSystemCapabilities.h>
+#include <OgreRoot.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Version of the cache layout. Bump to invalidate all entries when
+/// the Hlms customizations change in a way their templates do not reflect.
+static const char kHlmsCacheVersion[] = "1";
+
+/// \brief Name of the shader microcode cache entry
+static const char kMicrocodeCacheFile[] = "microcode.cache";
+
+/// \brief Get the name of the disk cache entry of an Hlms
+/// \param[in] _type Hlms type
+/// \return Entry file name
+static std::string hlmsCacheFile(unsigned int _type)
+{
+  return "hlms" + std::to_string(_type) + ".cache";
+}
+
+//////////////////////////////////////////////////
+Ogre2HlmsCache::Ogre2HlmsCache(const std::string &_path)
+  : path(_path)
+{
+}
+
+//////////////////////////////////////////////////
+bool Ogre2HlmsCache::Enabled() const
+{
+  return !this->path.empty();
+}
+
+//////////////////////////////////////////////////
+void Ogre2HlmsCache::Load()
+{
+  Ogre::Root *root = Ogre::Root::getSingletonPtr();
+  if (!this->Enabled() || !root || !root->getRenderSystem())
+    return;
+
+  this->directory = this->EntryDirectory();
+
+  // keep the microcode of the shaders compiled from now on so it can be
+  // saved on shutdown
+  Ogre::GpuProgramManager &programManager =
+      Ogre::GpuProgramManager::getSingleton();
+  programManager.setSaveMicrocodesToCache(true);
+
+  if (!common::isDirectory(this->directory))
+    return;
+
+  Ogre::DataStreamPtr microcode = Ogre2CacheFile::Read(
+      common::joinPaths(this->directory, kMicrocodeCacheFile));
+  if (microcode)
+  {
+    try
+    {
+      programManager.loadMicrocodeCache(microcode);
+    }
+    catch (Ogre::Exception &e)
+    {
+      gzwarn << "Ignoring invalid shader microcode cache in ["
+             << this->directory << "]: " << e.getDescription() << std::endl;
+    }
+  }
+
+  Ogre::HlmsManager *hlmsManager = root->getHlmsManager();
+  Ogre::HlmsDiskCache diskCache(hlmsManager);
+  for (unsigned int i = Ogre::HLMS_LOW_LEVEL + 1u; i < Ogre::HLMS_MAX; ++i)
+  {
+    Ogre::Hlms *hlms = hlmsManager->getHlms(static_cast<Ogre::HlmsTypes>(i));
+    if (!hlms)
+      continue;
+
+    const std::string entry =
+        common::joinPaths(this->directory, hlmsCacheFile(i));
+    Ogre::DataStreamPtr stream = Ogre2CacheFile::Read(entry);
+    if (!stream)
+      continue;
+
+    // entries built from other Hlms templates are regenerated by applyTo
+    try
+    {
+      diskCache.loadFrom(stream);
+      diskCache.applyTo(hlms);
+    }
+    catch (Ogre::Exception &e)
+    {
+      gzwarn << "Ignoring invalid Hlms cache entry [" << entry << "]: "
+             << e.getDescription() << std::endl;
+    }
+  }
+
+  gzdbg << "Loaded shader cache from [" << this->directory << "]"
+        << std::endl;
+}
+
+//////////////////////////////////////////////////
+void Ogre2HlmsCache::Save()
+{
+  Ogre::Root *root = Ogre::Root::getSingletonPtr();
+  if (this->directory.empty() || !root || !root->getRenderSystem() ||
+      !Ogre::GpuProgramManager::getSingletonPtr())
+  {
+    return;
+  }
+
+  if (!common::isDirectory(this->directory) &&
+      !common::createDirectories(this->directory))
+  {
+    gzwarn << "Unable to create shader cache directory ["
+           << this->directory << "]" << std::endl;
+    return;
+  }
+
+  Ogre::HlmsManager *hlmsManager = root->getHlmsManager();
+  Ogre::HlmsDiskCache diskCache(hlmsManager);
+  for (unsigned int i = Ogre::HLMS_LOW_LEVEL + 1u; i < Ogre::HLMS_MAX; ++i)
+  {
+    Ogre::Hlms *hlms = hlmsManager->getHlms(static_cast<Ogre::HlmsTypes>(i));
+    if (!hlms)
+      continue;
+
+    diskCache.copyFrom(hlms);
+    Ogre2CacheFile::WriteStream(
+        common::joinPaths(this->directory, hlmsCacheFile(i)),
+        [&diskCache](Ogre::DataStreamPtr &_stream)
+        {
+          diskCache.saveTo(_stream);
+        });
+  }
+
+  Ogre::GpuProgramManager &programManager =
+      Ogre::GpuProgramManager::getSingleton();
+  if (programManager.isCacheDirty())
+  {
+    Ogre2CacheFile::WriteStream(
+        common::joinPaths(this->directory, kMicrocodeCacheFile),
+        [&programManager](Ogre::DataStreamPtr &_stream)
+        {
+          programManager.saveMicrocodeCache(_stream);
+        });
+  }
+}
+
+//////////////////////////////////////////////////
+std::string Ogre2HlmsCache::EntryDirectory() const
+{
+  Ogre::RenderSystem *renderSystem =
+      Ogre::Root::getSingleton().getRenderSystem();
+
+  // everything the generated and compiled shaders depend on
+  std::stringstream id;
+  id << kHlmsCacheVersion << "::"
+     << GZ_RENDERING_VERSION_FULL << "::"
+     << OGRE_VERSION << "::"
+     << renderSystem->getName();
+  const Ogre::RenderSystemCapabilities *caps =
+      renderSystem->getCapabilities();
+  if (caps)
+  {
+    id << "::"
+       << Ogre::RenderSystemCapabilities::vendorToString(caps->getVendor())
+       << "::" << caps->getDeviceName()
+       << "::" << caps->getDriverVersion().toString();
+  }
+
+  // stable across processes so every run finds the same directory
+  Ogre2CacheHash hash;
+  hash.Add(id.str());
+  return common::joinPaths(this->path, hash.Hex());
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_RENDERING_OGRE2_OGRE2HLMSCACHE_HH_
+#define GZ_RENDERING_OGRE2_OGRE2HLMSCACHE_HH_
+
+#include <string>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Export.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Persistent cache of the shaders generated by the Hlms. It
+    /// saves the Hlms disk caches, i.e. the generated shader permutations,
+    /// and the compiled shader microcode on shutdown, and restores them on
+    /// the next start so shaders do not have to be generated and compiled
+    /// from scratch on first use.
+    ///
+    /// Entries are stored in a subdirectory of the cache directory that
+    /// depends on the gz-rendering and Ogre versions, the render system and
+    /// the GPU vendor, device and driver version, so caches built with a
+    /// different engine or driver are never loaded.
+    class GZ_RENDERING_OGRE2_HIDDEN Ogre2HlmsCache
+    {
+      /// \brief Constructor
+      /// \param[in] _path Cache directory. Caching is disabled if empty.
+      public: explicit Ogre2HlmsCache(const std::string &_path);
+
+      /// \brief Check if caching is enabled
+      /// \return True if a cache directory was given
+      public: bool Enabled() const;
+
+      /// \brief Restore the caches of all registered Hlms and the shader
+      /// microcode cache. Must be called once the render system is
+      /// initialized and the Hlms are registered.
+      public: void Load();
+
+      /// \brief Save the caches of all registered Hlms and the shader
+      /// microcode cache if it changed. Must be called before the Hlms
+      /// and the render system are destroyed.
+      public: void Save();
+
+      /// \brief Get the directory of the entries valid for the current
+      /// engine, render system and GPU driver
+      /// \return Entry directory
+      private: std::string EntryDirectory() const;
+
+      /// \brief Cache directory
+      private: std::string path;
+
+      /// \brief Directory the entries were loaded from. Empty until Load is
+      /// called.
+      private: std::string directory;
+    };
+    }
+  }
+}
+#endif
@@ -25,6 +25,11 @@
 #endif
 #endif
 
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <gz/common/Console.hh>
 
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
@@ -49,28 +54,44 @@
 
 class gz::rendering::Ogre2LidarVisualPrivate
 {
-  /// \brief Non Hitting DynamicLines Object to display
-  public: std::vector<std::shared_ptr<Ogre2DynamicRenderable>> noHitRayStrips;
-
-  /// \brief Hitting DynamicLines Object to display
-  public: std::vector<std::shared_ptr<Ogre2DynamicRenderable>> rayStrips;
-
-  /// \brief Dead Zone Geometry DynamicLines Object to display
-  public: std::vector<std::shared_ptr<Ogre2DynamicRenderable>> deadZoneRayFans;
+  /// \brief Create a dynamic renderable and attach it to the visual's node
+  /// \param[in] _scene Scene to create the renderable in
+  /// \param[in] _node Node to attach the renderable to
+  /// \param[in] _type Render operation type
+  /// \param[in] _material Name of the material to use. Empty to leave the
+  /// material unset.
+  /// \return The new renderable
+  public: std::shared_ptr<Ogre2DynamicRenderable> CreateRenderable(
+              ScenePtr _scene, Ogre::SceneNode *_node, MarkerType _type,
+              const std::string &_material);
+
+  /// \brief Compute the direction of every ray, if the scan pattern or
+  /// the sensor orientation changed since the last call.
+  /// \param[in] _vis The lidar visual
+  public: void UpdateRayAxes(const Ogre2LidarVisual &_vis);
+
+  /// \brief Non Hitting DynamicLines Object to display. Holds the strips
+  /// of all vertical rings as one triangle list.
+  public: std::shared_ptr<Ogre2DynamicRenderable> noHitRayStrips;
+
+  /// \brief Hitting DynamicLines Object to display. Holds the strips of all
+  /// vertical rings as one triangle list.
+  public: std::shared_ptr<Ogre2DynamicRenderable> rayStrips;
+
+  /// \brief Dead Zone Geometry DynamicLines Object to display. Holds the
+  /// fans of all vertical rings as one triangle list.
+  public: std::shared_ptr<Ogre2DynamicRenderable> deadZoneRayFans;
 
   /// \brief Lidar Ray DynamicLines Object to display
-  public: std::vector<std::shared_ptr<Ogre2DynamicRenderable>> rayLines;
+  public: std::shared_ptr<Ogre2DynamicRenderable> rayLines;
 
   /// \brief Lidar Points DynamicLines Object to display
-  public: std::vector<std::shared_ptr<Ogre2DynamicRenderable>> points;
+  public: std::shared_ptr<Ogre2DynamicRenderable> points;
 
   /// \brief Lidar visual type
   public: LidarVisualType lidarVisType =
             LidarVisualType::LVT_TRIANGLE_STRIPS;
 
-  /// \brief Current value of DisplayNonHitting parameter
-  public: bool currentDisplayNonHitting = true;
-
   /// \brief The current lidar points data
   public: std::vector<double> lidarPoints;
 
@@ -83,11 +104,104 @@ class gz::rendering::Ogre2LidarVisualPrivate
   /// \brief Pointer to point cloud material.
   /// Used when LidarVisualType = LVT_POINTS.
   public: Ogre::MaterialPtr pointsMat;
+
+  /// \brief Unit direction of every ray, in the visual's frame, ordered
+  /// like the lidar points.
+  public: std::vector<math::Vector3d> rayAxes;
+
+  /// \brief Scan pattern the ray directions were computed for: min and
+  /// max horizontal angle, min and max vertical angle, horizontal and
+  /// vertical count.
+  public: std::vector<double> rayAxesKey;
+
+  /// \brief Sensor orientation the ray directions were computed for
+  public: math::Quaterniond rayAxesRot;
+
+  /// \brief Scratch positions of the ray lines, 3 floats per vertex
+  public: std::vector<float> lineData;
+
+  /// \brief Scratch positions of the hitting strips, 3 floats per vertex
+  public: std::vector<float> stripData;
+
+  /// \brief Scratch positions of the non hitting strips, 3 floats per
+  /// vertex
+  public: std::vector<float> noHitStripData;
+
+  /// \brief Scratch positions of the dead zone fans, 3 floats per vertex
+  public: std::vector<float> fanData;
+
+  /// \brief Scratch positions of the points, 3 floats per vertex
+  public: std::vector<float> pointData;
+
+  /// \brief Scratch colors of the points, 4 floats per vertex
+  public: std::vector<float> pointColorData;
 };
 
 using namespace gz;
 using namespace rendering;
 
+/// \brief Append a position to a packed float array
+/// \param[in,out] _data Array to append to
+/// \param[in] _pt Position to append
+static void AppendPoint(std::vector<float> &_data, const math::Vector3d &_pt)
+{
+  _data.push_back(static_cast<float>(_pt.X()));
+  _data.push_back(static_cast<float>(_pt.Y()));
+  _data.push_back(static_cast<float>(_pt.Z()));
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<Ogre2DynamicRenderable>
+    Ogre2LidarVisualPrivate::CreateRenderable(ScenePtr _scene,
+    Ogre::SceneNode *_node, MarkerType _type, const std::string &_material)
+{
+  auto renderable = std::make_shared<Ogre2DynamicRenderable>(_scene);
+  renderable->SetOperationType(_type);
+  if (!_material.empty())
+    renderable->SetMaterial(_scene->Material(_material), false);
+  _node->attachObject(renderable->OgreObject());
+  return renderable;
+}
+
+//////////////////////////////////////////////////
+void Ogre2LidarVisualPrivate::UpdateRayAxes(const Ogre2LidarVisual &_vis)
+{
+  std::vector<double> key = {
+      _vis.MinHorizontalAngle(), _vis.MaxHorizontalAngle(),
+      _vis.MinVerticalAngle(), _vis.MaxVerticalAngle(),
+      static_cast<double>(_vis.HorizontalRayCount()),
+      static_cast<double>(_vis.VerticalRayCount())};
+  const math::Quaterniond rot = _vis.Offset().Rot();
+  if (key == this->rayAxesKey && rot == this->rayAxesRot)
+    return;
+
+  this->rayAxesKey = key;
+  this->rayAxesRot = rot;
+
+  const unsigned int hCount = _vis.HorizontalRayCount();
+  const unsigned int vCount = _vis.VerticalRayCount();
+  const double hStep = hCount > 1 ?
+      (_vis.MaxHorizontalAngle() - _vis.MinHorizontalAngle()) / (hCount - 1) :
+      0.0;
+  const double vStep = vCount > 1 ?
+      (_vis.MaxVerticalAngle() - _vis.MinVerticalAngle()) / (vCount - 1) :
+      0.0;
+
+  this->rayAxes.resize(static_cast<std::size_t>(hCount) * vCount);
+  for (unsigned int j = 0; j < vCount; ++j)
+  {
+    const double verticalAngle = _vis.MinVerticalAngle() + j * vStep;
+    for (unsigned int i = 0; i < hCount; ++i)
+    {
+      const double horizontalAngle = _vis.MinHorizontalAngle() + i * hStep;
+      math::Quaterniond ray(
+          math::Vector3d(0.0, -verticalAngle, horizontalAngle));
+      this->rayAxes[j * hCount + i] =
+          rot * ray * math::Vector3d(1.0, 0.0, 0.0);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 Ogre2LidarVisual::Ogre2LidarVisual()
   : dataPtr(new Ogre2LidarVisualPrivate)
@@ -110,34 +224,12 @@ void Ogre2LidarVisual::PreRender()
 void Ogre2LidarVisual::Destroy()
 {
   BaseLidarVisual::Destroy();
-  for (auto ray : this->dataPtr->noHitRayStrips)
-  {
-    ray->Clear();
-    ray.reset();
-  }
-
-  for (auto ray : this->dataPtr->rayStrips)
-  {
-    ray->Clear();
-    ray.reset();
-  }
-
-  for (auto ray : this->dataPtr->rayLines)
-  {
-    ray->Clear();
-    ray.reset();
-  }
-
-  for (auto ray : this->dataPtr->deadZoneRayFans)
-  {
-    ray->Clear();
-    ray.reset();
-  }
-
-  for (auto ray : this->dataPtr->points)
+  for (auto ray : {this->dataPtr->noHitRayStrips, this->dataPtr->rayStrips,
+       this->dataPtr->rayLines, this->dataPtr->deadZoneRayFans,
+       this->dataPtr->points})
   {
-    ray->Clear();
-    ray.reset();
+    if (ray)
+      ray->Clear();
   }
 
   this->dataPtr->lidarPoints.clear();
@@ -187,11 +279,11 @@ void Ogre2LidarVisual::ClearPoints()
 //////////////////////////////////////////////////
 void Ogre2LidarVisual::ClearVisualData()
 {
-  this->dataPtr->noHitRayStrips.clear();
-  this->dataPtr->deadZoneRayFans.clear();
-  this->dataPtr->rayLines.clear();
-  this->dataPtr->rayStrips.clear();
-  this->dataPtr->points.clear();
+  this->dataPtr->noHitRayStrips.reset();
+  this->dataPtr->deadZoneRayFans.reset();
+  this->dataPtr->rayLines.reset();
+  this->dataPtr->rayStrips.reset();
+  this->dataPtr->points.reset();
 }
 
 //////////////////////////////////////////////////
@@ -217,30 +309,15 @@ void Ogre2LidarVisual::Update()
     return;
   }
 
-  bool clearVisuals = false;
-
-  if (this->lidarVisualType != this->dataPtr->lidarVisType
-        || !this->displayNonHitting)
-  {
-    clearVisuals = true;
-  }
-
-  if (this->displayNonHitting != this->dataPtr->currentDisplayNonHitting)
-  {
-    clearVisuals = true;
-    this->dataPtr->currentDisplayNonHitting = this->displayNonHitting;
-  }
-
-  // if visual type is changed, clear all DynamicLines
-  if (clearVisuals)
+  // if visual type is changed, clear all DynamicLines. Every update
+  // replaces all points so nothing else needs clearing.
+  if (this->lidarVisualType != this->dataPtr->lidarVisType)
   {
     this->ClearVisualData();
   }
   this->dataPtr->lidarVisType = this->lidarVisualType;
 
   this->dataPtr->receivedData = false;
-  double horizontalAngle = this->minHorizontalAngle;
-  double verticalAngle = this->minVerticalAngle;
 
   if (this->horizontalCount > 1)
   {
@@ -265,231 +342,169 @@ void Ogre2LidarVisual::Update()
     return;
   }
 
-  // Process each point from received data
-  // Every line segment, and every triangle is saved separately,
-  // as a pointer to a DynamicLine
-  // This initializes and updates only the selected DynamicLine variables
-  for (unsigned int j = 0; j < this->verticalCount; ++j)
+  // The whole scan goes into one renderable per primitive type. Strips and
+  // fans of the vertical rings can not be joined into a single strip or
+  // fan, so they are expanded into triangle lists.
+  const bool strips =
+      this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS;
+  const bool lines = strips ||
+      this->dataPtr->lidarVisType == LidarVisualType::LVT_RAY_LINES;
+  const bool points =
+      this->dataPtr->lidarVisType == LidarVisualType::LVT_POINTS;
+
+  if (lines && !this->dataPtr->rayLines)
   {
-    horizontalAngle = this->minHorizontalAngle;
-
-    if (this->dataPtr->lidarVisType == LidarVisualType::LVT_RAY_LINES ||
-        this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS)
-    {
-      if (j+1 > this->dataPtr->rayLines.size())
-      {
-        std::shared_ptr<Ogre2DynamicRenderable> renderable =
-                        std::shared_ptr<Ogre2DynamicRenderable>(
-                                    new Ogre2DynamicRenderable(this->Scene()));
-
-        renderable->SetOperationType(MT_LINE_LIST);
-        MaterialPtr mat = this->Scene()->Material("Lidar/BlueRay");
-        renderable->SetMaterial(mat, false);
-
-        this->ogreNode->attachObject(renderable->OgreObject());
-        this->dataPtr->rayLines.push_back(renderable);
-
-        if (this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS)
-        {
-          renderable = std::shared_ptr<Ogre2DynamicRenderable>(
-                                  new Ogre2DynamicRenderable(this->Scene()));
-
-          renderable->SetOperationType(MT_TRIANGLE_STRIP);
-          mat = this->Scene()->Material("Lidar/LightBlueStrips");
-
-          renderable->SetMaterial(mat, false);
-
-          this->ogreNode->attachObject(renderable->OgreObject());
-          this->dataPtr->noHitRayStrips.push_back(renderable);
-
-          renderable = std::shared_ptr<Ogre2DynamicRenderable>(
-                                  new Ogre2DynamicRenderable(this->Scene()));
-
-          renderable->SetOperationType(MT_TRIANGLE_FAN);
-          mat = this->Scene()->Material("Lidar/TransBlack");
-
-          renderable->SetMaterial(mat, false);
-
-          this->ogreNode->attachObject(renderable->OgreObject());
-          this->dataPtr->deadZoneRayFans.push_back(renderable);
-          this->dataPtr->deadZoneRayFans[j]->AddPoint(
-                      gz::math::Vector3d::Zero);
-
-          renderable = std::shared_ptr<Ogre2DynamicRenderable>(
-                                  new Ogre2DynamicRenderable(this->Scene()));
-
-          renderable->SetOperationType(MT_TRIANGLE_STRIP);
-          mat = this->Scene()->Material("Lidar/BlueStrips");
-
-          renderable->SetMaterial(mat, false);
-
-          this->ogreNode->attachObject(renderable->OgreObject());
-          this->dataPtr->rayStrips.push_back(renderable);
-        }
-      }
-    }
-
-    else if (this->dataPtr->lidarVisType ==
-                  LidarVisualType::LVT_POINTS)
-    {
-      if (j+1 > this->dataPtr->points.size())
-      {
-        std::shared_ptr<Ogre2DynamicRenderable> renderable =
-                        std::shared_ptr<Ogre2DynamicRenderable>(
-                                    new Ogre2DynamicRenderable(this->Scene()));
-
-        renderable->SetOperationType(MT_POINTS);
-
-        // use low level programmable material so we can customize point size
-        Ogre::Item *item = dynamic_cast<Ogre::Item *>(renderable->OgreObject());
-        item->setCastShadows(false);
-        item->getSubItem(0)->setMaterial(this->dataPtr->pointsMat);
-
-        this->ogreNode->attachObject(renderable->OgreObject());
-        this->dataPtr->points.push_back(renderable);
-      }
-    }
+    this->dataPtr->rayLines = this->dataPtr->CreateRenderable(this->Scene(),
+        this->ogreNode, MT_LINE_LIST, "Lidar/BlueRay");
+  }
+  if (strips && !this->dataPtr->rayStrips)
+  {
+    this->dataPtr->noHitRayStrips = this->dataPtr->CreateRenderable(
+        this->Scene(), this->ogreNode, MT_TRIANGLE_LIST,
+        "Lidar/LightBlueStrips");
+    this->dataPtr->deadZoneRayFans = this->dataPtr->CreateRenderable(
+        this->Scene(), this->ogreNode, MT_TRIANGLE_LIST, "Lidar/TransBlack");
+    this->dataPtr->rayStrips = this->dataPtr->CreateRenderable(
+        this->Scene(), this->ogreNode, MT_TRIANGLE_LIST, "Lidar/BlueStrips");
+  }
+  if (points && !this->dataPtr->points)
+  {
+    this->dataPtr->points = this->dataPtr->CreateRenderable(this->Scene(),
+        this->ogreNode, MT_POINTS, "");
+
+    // use low level programmable material so we can customize point size
+    Ogre::Item *item =
+        dynamic_cast<Ogre::Item *>(this->dataPtr->points->OgreObject());
+    item->setCastShadows(false);
+    item->getSubItem(0)->setMaterial(this->dataPtr->pointsMat);
+  }
 
-    if (this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS)
-    {
-      this->dataPtr->deadZoneRayFans[j]->SetPoint(0, this->offset.Pos());
-    }
+  this->dataPtr->UpdateRayAxes(*this);
+
+  auto &lineData = this->dataPtr->lineData;
+  auto &stripData = this->dataPtr->stripData;
+  auto &noHitStripData = this->dataPtr->noHitStripData;
+  auto &fanData = this->dataPtr->fanData;
+  auto &pointData = this->dataPtr->pointData;
+  auto &pointColorData = this->dataPtr->pointColorData;
+  lineData.clear();
+  stripData.clear();
+  noHitStripData.clear();
+  fanData.clear();
+  pointData.clear();
+  pointColorData.clear();
+
+  const math::Vector3d origin = this->offset.Pos();
+  const math::Color pointColor =
+      this->Scene()->Material("Lidar/BlueRay")->Diffuse();
 
-    auto pointMat = this->Scene()->Material("Lidar/BlueRay");
+  // Process each point from received data
+  for (unsigned int j = 0; j < this->verticalCount; ++j)
+  {
+    math::Vector3d prevStartPt;
+    math::Vector3d prevStripPt;
+    math::Vector3d prevNoHitStripPt;
 
-    unsigned count = this->horizontalCount;
     // Process each ray in current scan
-    for (unsigned int i = 0; i < count; ++i)
+    for (unsigned int i = 0; i < this->horizontalCount; ++i)
     {
+      const unsigned int idx = j * this->horizontalCount + i;
+
       // calculate range of the ray
-      double r = this->dataPtr->lidarPoints[ j * this->horizontalCount + i];
+      double r = this->dataPtr->lidarPoints[idx];
 
       bool inf = (std::isinf(r) || r >= this->maxRange);
-      gz::math::Quaterniond ray(
-        gz::math::Vector3d(0.0, -verticalAngle, horizontalAngle));
-
-      gz::math::Vector3d axis = this->offset.Rot() * ray *
-        gz::math::Vector3d(1.0, 0.0, 0.0);
+      const math::Vector3d &axis = this->dataPtr->rayAxes[idx];
 
       // Check for infinite range, which indicates the ray did not
       // intersect an object.
       double hitRange = inf ? 0 : r;
 
       // Compute the start point of the ray
-      gz::math::Vector3d startPt =
-                  (axis * this->minRange) + this->offset.Pos();
+      math::Vector3d startPt = (axis * this->minRange) + origin;
 
       // Compute the end point of the ray
-      gz::math::Vector3d pt =
-                  (axis * hitRange) + this->offset.Pos();
+      math::Vector3d pt = (axis * hitRange) + origin;
 
       double noHitRange = inf ? this->maxRange : hitRange;
 
       // Compute the end point of the no-hit ray
-      gz::math::Vector3d noHitPt =
-                  (axis * noHitRange) + this->offset.Pos();
-
-      // Update the lines and strips that represent each simulated ray.
+      math::Vector3d noHitPt = (axis * noHitRange) + origin;
 
-      // For TRIANGLE_STRIPS Lidar Visual to be displayed
-      if (this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS
-        || this->dataPtr->lidarVisType == LidarVisualType::LVT_RAY_LINES)
+      if (lines && (this->displayNonHitting || !inf))
       {
-        if (i >= this->dataPtr->rayLines[j]->PointCount()/2)
-        {
-          if (this->displayNonHitting || !inf)
-          {
-            this->dataPtr->rayLines[j]->AddPoint(startPt);
-            this->dataPtr->rayLines[j]->AddPoint(inf ? noHitPt: pt);
-          }
-
-          if (this->dataPtr->lidarVisType ==
-                LidarVisualType::LVT_TRIANGLE_STRIPS)
-          {
-            this->dataPtr->rayStrips[j]->AddPoint(startPt);
-            this->dataPtr->rayStrips[j]->AddPoint(inf ? startPt : pt);
-
-            this->dataPtr->noHitRayStrips[j]->AddPoint(startPt);
-            this->dataPtr->noHitRayStrips[j]->AddPoint(
-                inf ? (this->displayNonHitting? noHitPt: startPt) : pt);
-          }
-        }
-        else
-        {
-          if (this->displayNonHitting || !inf)
-          {
-            this->dataPtr->rayLines[j]->SetPoint(i*2, startPt);
-            this->dataPtr->rayLines[j]->SetPoint(i*2+1, inf ? noHitPt: pt);
-          }
-
-          if (this->dataPtr->lidarVisType ==
-                LidarVisualType::LVT_TRIANGLE_STRIPS)
-          {
-            this->dataPtr->rayStrips[j]->SetPoint(i*2, startPt);
-            this->dataPtr->rayStrips[j]->SetPoint(i*2+1, inf? startPt : pt);
-
-            this->dataPtr->noHitRayStrips[j]->SetPoint(i*2, startPt);
-            this->dataPtr->noHitRayStrips[j]->SetPoint(i*2+1,
-                inf ? (this->displayNonHitting? noHitPt: startPt) : pt);
-          }
-        }
-        if (this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS)
-        {
-          // Draw the triangle fan that indicates the dead zone.
-          if (i+1 >= this->dataPtr->deadZoneRayFans[j]->PointCount())
-            this->dataPtr->deadZoneRayFans[j]->AddPoint(startPt);
-          else
-            this->dataPtr->deadZoneRayFans[j]->SetPoint(i+1, startPt);
-        }
+        AppendPoint(lineData, startPt);
+        AppendPoint(lineData, inf ? noHitPt : pt);
       }
 
-      // For POINTS Lidar Visual to be displayed
-      else if (this->dataPtr->lidarVisType ==
-                LidarVisualType::LVT_POINTS)
+      if (strips)
       {
-        if (i >= this->dataPtr->points[j]->PointCount())
+        math::Vector3d stripPt = inf ? startPt : pt;
+        math::Vector3d noHitStripPt =
+            inf ? (this->displayNonHitting ? noHitPt : startPt) : pt;
+
+        // the two triangles a strip would make between this ray and the
+        // previous one, and the dead zone triangle a fan around the
+        // sensor origin would make.
+        if (i > 0)
         {
-          if (this->displayNonHitting || !inf)
-          {
-            this->dataPtr->points[j]->AddPoint(inf ? noHitPt : pt,
-                pointMat->Diffuse());
-          }
-        }
-        else
-        {
-          if (this->displayNonHitting || !inf)
-          {
-            this->dataPtr->points[j]->SetPoint(i, inf ? noHitPt : pt);
-            this->dataPtr->points[j]->SetColor(i, pointMat->Diffuse());
-          }
+          AppendPoint(stripData, prevStartPt);
+          AppendPoint(stripData, prevStripPt);
+          AppendPoint(stripData, startPt);
+          AppendPoint(stripData, startPt);
+          AppendPoint(stripData, prevStripPt);
+          AppendPoint(stripData, stripPt);
+
+          AppendPoint(noHitStripData, prevStartPt);
+          AppendPoint(noHitStripData, prevNoHitStripPt);
+          AppendPoint(noHitStripData, startPt);
+          AppendPoint(noHitStripData, startPt);
+          AppendPoint(noHitStripData, prevNoHitStripPt);
+          AppendPoint(noHitStripData, noHitStripPt);
+
+          AppendPoint(fanData, origin);
+          AppendPoint(fanData, prevStartPt);
+          AppendPoint(fanData, startPt);
         }
+        prevStripPt = stripPt;
+        prevNoHitStripPt = noHitStripPt;
       }
-      horizontalAngle += this->horizontalAngleStep;
-    }
+      prevStartPt = startPt;
 
-    // Update the DynamicLines pointers after adding points based on type
-    if (this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS
-      || this->dataPtr->lidarVisType == LidarVisualType::LVT_RAY_LINES)
-    {
-      this->dataPtr->rayLines[j]->Update();
-      if (this->dataPtr->lidarVisType ==
-                      LidarVisualType::LVT_TRIANGLE_STRIPS)
+      if (points && (this->displayNonHitting || !inf))
       {
-        this->dataPtr->rayStrips[j]->Update();
-        this->dataPtr->noHitRayStrips[j]->Update();
-        this->dataPtr->deadZoneRayFans[j]->Update();
+        AppendPoint(pointData, inf ? noHitPt : pt);
+        pointColorData.insert(pointColorData.end(), {pointColor.R(),
+            pointColor.G(), pointColor.B(), pointColor.A()});
       }
     }
-    else if (this->dataPtr->lidarVisType == LidarVisualType::LVT_POINTS)
-    {
-      this->dataPtr->points[j]->Update();
-    }
-    verticalAngle += this->verticalAngleStep;
   }
 
-  if (this->dataPtr->lidarVisType == LidarVisualType::LVT_POINTS &&
-      !this->dataPtr->points.empty())
+  // upload the scan. The scratch arrays are borrowed and read by Update.
+  if (lines)
+  {
+    this->dataPtr->rayLines->SetPoints(lineData.data(), nullptr,
+        lineData.size() / 3u, true);
+    this->dataPtr->rayLines->Update();
+  }
+  if (strips)
   {
+    this->dataPtr->rayStrips->SetPoints(stripData.data(), nullptr,
+        stripData.size() / 3u, true);
+    this->dataPtr->rayStrips->Update();
+    this->dataPtr->noHitRayStrips->SetPoints(noHitStripData.data(), nullptr,
+        noHitStripData.size() / 3u, true);
+    this->dataPtr->noHitRayStrips->Update();
+    this->dataPtr->deadZoneRayFans->SetPoints(fanData.data(), nullptr,
+        fanData.size() / 3u, true);
+    this->dataPtr->deadZoneRayFans->Update();
+  }
+  if (points)
+  {
+    this->dataPtr->points->SetPoints(pointData.data(), pointColorData.data(),
+        pointData.size() / 3u, true);
+    this->dataPtr->points->Update();
+
     // point renderables use low level materials
     // get the material and set size uniform variable
     auto pass = this->dataPtr->pointsMat->getTechnique(0)->getPass(0);
@@ -25,6 +25,9 @@
 #endif
 #endif
 
+#include <utility>
+#include <vector>
+
 #include <gz/common/Console.hh>
 
 #include <gz/common/Mesh.hh>
@@ -303,6 +306,21 @@ void Ogre2Marker::AddPoint(const math::Vector3d &_pt,
   this->dataPtr->dynamicRenderable->AddPoint(_pt, _color);
 }
 
+//////////////////////////////////////////////////
+void Ogre2Marker::SetPoints(const float *_xyz, const float *_rgba,
+    std::size_t _count, bool _borrow)
+{
+  this->dataPtr->dynamicRenderable->SetPoints(_xyz, _rgba, _count, _borrow);
+}
+
+//////////////////////////////////////////////////
+void Ogre2Marker::SetPoints(std::vector<float> &&_xyz,
+    std::vector<float> &&_rgba)
+{
+  this->dataPtr->dynamicRenderable->SetPoints(std::move(_xyz),
+      std::move(_rgba));
+}
+
 //////////////////////////////////////////////////
 void Ogre2Marker::ClearPoints()
 {
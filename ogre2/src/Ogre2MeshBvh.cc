@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+
+#include <gz/common/Mesh.hh>
+#include <gz/common/SubMesh.hh>
+
+#include "Ogre2MeshBvh.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Max number of triangles in a leaf node
+static const uint32_t kMaxLeafSize = 4u;
+
+/// \brief Max depth of the hierarchy. Nodes are split at the median so the
+/// depth is log2 of the triangle count, well below this.
+static const uint32_t kMaxDepth = 64u;
+
+/// \brief Mutex protecting the hierarchy cache
+static std::mutex g_bvhCacheMutex;
+
+/// \brief Hierarchies cached per owner, e.g. per scene, and mesh key. Each
+/// owner drops its entries when it is cleared so hierarchies do not outlive
+/// the meshes they were built for.
+static std::unordered_map<const void *,
+    std::unordered_map<uint64_t, std::shared_ptr<const Ogre2MeshBvh>>>
+    g_bvhCache;
+
+//////////////////////////////////////////////////
+Ogre2MeshBvh::Ogre2MeshBvh(const common::Mesh &_mesh)
+{
+  for (unsigned int i = 0; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto submesh = _mesh.SubMeshByIndex(i).lock();
+    if (!submesh || submesh->VertexCount() < 3u)
+      continue;
+
+    unsigned int indexCount = submesh->IndexCount();
+    for (unsigned int k = 0; k + 2 < indexCount; k += 3)
+    {
+      math::Vector3d a = submesh->Vertex(submesh->Index(k));
+      math::Vector3d b = submesh->Vertex(submesh->Index(k+1));
+      math::Vector3d c = submesh->Vertex(submesh->Index(k+2));
+
+      Triangle tri;
+      tri.v0.Set(a.X(), a.Y(), a.Z());
+      tri.e1.Set(b.X() - a.X(), b.Y() - a.Y(), b.Z() - a.Z());
+      tri.e2.Set(c.X() - a.X(), c.Y() - a.Y(), c.Z() - a.Z());
+      this->triangles.push_back(tri);
+    }
+  }
+
+  if (this->triangles.empty())
+    return;
+
+  const uint32_t triCount = static_cast<uint32_t>(this->triangles.size());
+  std::vector<math::Vector3f> centroids(triCount);
+  for (uint32_t i = 0; i < triCount; ++i)
+  {
+    const Triangle &tri = this->triangles[i];
+    centroids[i] = tri.v0 + (tri.e1 + tri.e2) / 3.0f;
+  }
+
+  std::vector<uint32_t> order(triCount);
+  std::iota(order.begin(), order.end(), 0u);
+
+  this->nodes.reserve(2u * triCount / kMaxLeafSize + 1u);
+  this->nodes.emplace_back();
+  this->Build(0u, 0u, triCount, order, centroids);
+
+  // store triangles in leaf order so leaves cover contiguous ranges
+  std::vector<Triangle> ordered(triCount);
+  for (uint32_t i = 0; i < triCount; ++i)
+    ordered[i] = this->triangles[order[i]];
+  this->triangles.swap(ordered);
+}
+
+//////////////////////////////////////////////////
+void Ogre2MeshBvh::Build(uint32_t _nodeIdx, uint32_t _begin, uint32_t _end,
+    std::vector<uint32_t> &_order,
+    const std::vector<math::Vector3f> &_centroids)
+{
+  // compute bounds of the triangles and of their centroids
+  float min[3] = {std::numeric_limits<float>::max(),
+                  std::numeric_limits<float>::max(),
+                  std::numeric_limits<float>::max()};
+  float max[3] = {std::numeric_limits<float>::lowest(),
+                  std::numeric_limits<float>::lowest(),
+                  std::numeric_limits<float>::lowest()};
+  math::Vector3f cMin(std::numeric_limits<float>::max(),
+                      std::numeric_limits<float>::max(),
+                      std::numeric_limits<float>::max());
+  math::Vector3f cMax(std::numeric_limits<float>::lowest(),
+                      std::numeric_limits<float>::lowest(),
+                      std::numeric_limits<float>::lowest());
+  for (uint32_t i = _begin; i < _end; ++i)
+  {
+    const Triangle &tri = this->triangles[_order[i]];
+    const math::Vector3f b = tri.v0 + tri.e1;
+    const math::Vector3f c = tri.v0 + tri.e2;
+    for (unsigned int axis = 0; axis < 3u; ++axis)
+    {
+      min[axis] = std::min({min[axis], tri.v0[axis], b[axis], c[axis]});
+      max[axis] = std::max({max[axis], tri.v0[axis], b[axis], c[axis]});
+    }
+    cMin.Min(_centroids[_order[i]]);
+    cMax.Max(_centroids[_order[i]]);
+  }
+
+  std::copy(min, min + 3, this->nodes[_nodeIdx].min);
+  std::copy(max, max + 3, this->nodes[_nodeIdx].max);
+
+  // split along the longest axis of the centroid bounds
+  const math::Vector3f extent = cMax - cMin;
+  unsigned int axis = 0u;
+  if (extent.Y() > extent[axis])
+    axis = 1u;
+  if (extent.Z() > extent[axis])
+    axis = 2u;
+
+  if (_end - _begin <= kMaxLeafSize || extent[axis] <= 0.0f)
+  {
+    this->nodes[_nodeIdx].offset = _begin;
+    this->nodes[_nodeIdx].count = _end - _begin;
+    return;
+  }
+
+  const uint32_t mid = _begin + (_end - _begin) / 2u;
+  std::nth_element(_order.begin() + _begin, _order.begin() + mid,
+      _order.begin() + _end,
+      [&](uint32_t _a, uint32_t _b)
+      {
+        return _centroids[_a][axis] < _centroids[_b][axis];
+      });
+
+  // note: emplace_back may reallocate so do not hold references to nodes
+  const uint32_t left = static_cast<uint32_t>(this->nodes.size());
+  this->nodes.emplace_back();
+  this->nodes.emplace_back();
+  this->nodes[_nodeIdx].offset = left;
+  this->nodes[_nodeIdx].count = 0u;
+
+  this->Build(left, _begin, mid, _order, _centroids);
+  this->Build(left + 1u, mid, _end, _order, _centroids);
+}
+
+/// \brief Ray / axis aligned box slab test
+/// \param[in] _min Min corner of the box
+/// \param[in] _max Max corner of the box
+/// \param[in] _origin Ray origin
+/// \param[in] _invDir Component wise inverse of the ray direction
+/// \param[in] _tMax Ignore boxes farther than this
+/// \param[out] _tEntry Ray parameter where the ray enters the box
+/// \return True if the ray hits the box before _tMax
+static bool RayBox(const float *_min, const float *_max,
+    const math::Vector3d &_origin, const math::Vector3d &_invDir,
+    double _tMax, double &_tEntry)
+{
+  double tmin = 0.0;
+  double tmax = _tMax;
+  for (unsigned int axis = 0; axis < 3u; ++axis)
+  {
+    double t0 = (_min[axis] - _origin[axis]) * _invDir[axis];
+    double t1 = (_max[axis] - _origin[axis]) * _invDir[axis];
+    if (t0 > t1)
+      std::swap(t0, t1);
+    // written so that NaNs, from 0 * inf when the ray lies on a slab
+    // boundary, keep the current interval
+    tmin = t0 > tmin ? t0 : tmin;
+    tmax = t1 < tmax ? t1 : tmax;
+    if (tmin > tmax)
+      return false;
+  }
+  _tEntry = tmin;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2MeshBvh::Intersect(const math::Vector3d &_origin,
+    const math::Vector3d &_dir, bool _flipWinding, double &_t) const
+{
+  if (this->nodes.empty())
+    return false;
+
+  const math::Vector3d invDir(1.0 / _dir.X(), 1.0 / _dir.Y(),
+      1.0 / _dir.Z());
+
+  bool hit = false;
+  uint32_t stack[kMaxDepth * 2u];
+  uint32_t stackSize = 0u;
+  stack[stackSize++] = 0u;
+  while (stackSize > 0u)
+  {
+    const Node &node = this->nodes[stack[--stackSize]];
+    double tEntry;
+    if (!RayBox(node.min, node.max, _origin, invDir, _t, tEntry))
+      continue;
+
+    if (node.count > 0u)
+    {
+      for (uint32_t i = node.offset; i < node.offset + node.count; ++i)
+      {
+        // Moller-Trumbore ray / triangle intersection. The determinant is
+        // positive when the ray hits the counter clockwise (front) side.
+        const Triangle &tri = this->triangles[i];
+        const math::Vector3d e1(tri.e1.X(), tri.e1.Y(), tri.e1.Z());
+        const math::Vector3d e2(tri.e2.X(), tri.e2.Y(), tri.e2.Z());
+        const math::Vector3d p = _dir.Cross(e2);
+        const double det = e1.Dot(p);
+        if ((!_flipWinding && det <= 0.0) || (_flipWinding && det >= 0.0))
+          continue;
+
+        const double invDet = 1.0 / det;
+        const math::Vector3d s =
+            _origin - math::Vector3d(tri.v0.X(), tri.v0.Y(), tri.v0.Z());
+        const double u = s.Dot(p) * invDet;
+        if (u < 0.0 || u > 1.0)
+          continue;
+
+        const math::Vector3d q = s.Cross(e1);
+        const double v = _dir.Dot(q) * invDet;
+        if (v < 0.0 || u + v > 1.0)
+          continue;
+
+        const double t = e2.Dot(q) * invDet;
+        if (t >= 0.0 && t < _t)
+        {
+          _t = t;
+          hit = true;
+        }
+      }
+      continue;
+    }
+
+    // visit the nearest child first so farther subtrees can be culled by
+    // the closest hit found so far
+    const Node &left = this->nodes[node.offset];
+    const Node &right = this->nodes[node.offset + 1u];
+    double tLeft;
+    double tRight;
+    bool hitLeft = RayBox(left.min, left.max, _origin, invDir, _t, tLeft);
+    bool hitRight = RayBox(right.min, right.max, _origin, invDir, _t, tRight);
+    if (hitLeft && hitRight)
+    {
+      if (tLeft < tRight)
+      {
+        stack[stackSize++] = node.offset + 1u;
+        stack[stackSize++] = node.offset;
+      }
+      else
+      {
+        stack[stackSize++] = node.offset;
+        stack[stackSize++] = node.offset + 1u;
+      }
+    }
+    else if (hitLeft)
+    {
+      stack[stackSize++] = node.offset;
+    }
+    else if (hitRight)
+    {
+      stack[stackSize++] = node.offset + 1u;
+    }
+  }
+  return hit;
+}
+
+//////////////////////////////////////////////////
+std::size_t Ogre2MeshBvh::TriangleCount() const
+{
+  return this->triangles.size();
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const Ogre2MeshBvh> Ogre2MeshBvh::Lookup(
+    const void *_owner, uint64_t _key)
+{
+  std::lock_guard<std::mutex> lock(g_bvhCacheMutex);
+  auto ownerIt = g_bvhCache.find(_owner);
+  if (ownerIt == g_bvhCache.end())
+    return nullptr;
+  auto it = ownerIt->second.find(_key);
+  if (it == ownerIt->second.end())
+    return nullptr;
+  return it->second;
+}
+
+//////////////////////////////////////////////////
+void Ogre2MeshBvh::Store(const void *_owner, uint64_t _key,
+    std::shared_ptr<const Ogre2MeshBvh> _bvh)
+{
+  if (!_bvh)
+    return;
+  std::lock_guard<std::mutex> lock(g_bvhCacheMutex);
+  g_bvhCache[_owner][_key] = std::move(_bvh);
+}
+
+//////////////////////////////////////////////////
+void Ogre2MeshBvh::Evict(const void *_owner, uint64_t _key)
+{
+  std::lock_guard<std::mutex> lock(g_bvhCacheMutex);
+  auto ownerIt = g_bvhCache.find(_owner);
+  if (ownerIt == g_bvhCache.end())
+    return;
+  ownerIt->second.erase(_key);
+  if (ownerIt->second.empty())
+    g_bvhCache.erase(ownerIt);
+}
+
+//////////////////////////////////////////////////
+void Ogre2MeshBvh::Clear(const void *_owner)
+{
+  std::lock_guard<std::mutex> lock(g_bvhCacheMutex);
+  g_bvhCache.erase(_owner);
+}
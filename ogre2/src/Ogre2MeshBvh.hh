@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2MESHBVH_HH_
+#define GZ_RENDERING_OGRE2_OGRE2MESHBVH_HH_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Export.hh"
+
+namespace gz
+{
+  namespace common
+  {
+    class Mesh;
+  }
+
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Bounding volume hierarchy over the triangles of a
+    /// common::Mesh. Used to speed up ray / mesh intersection tests done on
+    /// the CPU. Triangles are stored in mesh local space so the hierarchy
+    /// can be shared by all items created from the same mesh.
+    class GZ_RENDERING_OGRE2_HIDDEN Ogre2MeshBvh
+    {
+      /// \brief Constructor. Builds the hierarchy from the triangles of all
+      /// submeshes of the given mesh.
+      /// \param[in] _mesh Mesh to build the hierarchy from
+      public: explicit Ogre2MeshBvh(const common::Mesh &_mesh);
+
+      /// \brief Find the closest front facing triangle hit by a ray.
+      /// \param[in] _origin Ray origin in mesh local space
+      /// \param[in] _dir Ray direction in mesh local space. It does not need
+      /// to be unit length; hit distances are expressed in multiples of it.
+      /// \param[in] _flipWinding True to treat clockwise triangles as front
+      /// facing, e.g. when the mesh is mirrored by a negative scale.
+      /// \param[in,out] _t Ray parameter of the closest hit. Only hits closer
+      /// than the value passed in are considered.
+      /// \return True if a closer hit was found and _t was updated.
+      public: bool Intersect(const math::Vector3d &_origin,
+                  const math::Vector3d &_dir, bool _flipWinding,
+                  double &_t) const;
+
+      /// \brief Get the number of triangles in the hierarchy
+      /// \return Triangle count
+      public: std::size_t TriangleCount() const;
+
+      /// \brief Look up the hierarchy cached for a mesh. Thread safe.
+      /// \param[in] _owner Owner of the cache, e.g. the Ogre scene manager
+      /// \param[in] _key Unique key of the mesh, e.g. its Ogre resource handle
+      /// \return Cached hierarchy or null if none is cached for _key
+      public: static std::shared_ptr<const Ogre2MeshBvh> Lookup(
+                  const void *_owner, uint64_t _key);
+
+      /// \brief Cache the hierarchy of a mesh. Null hierarchies are not
+      /// cached. Thread safe.
+      /// \param[in] _owner Owner of the cache
+      /// \param[in] _key Unique key of the mesh
+      /// \param[in] _bvh Hierarchy to cache
+      public: static void Store(const void *_owner, uint64_t _key,
+                  std::shared_ptr<const Ogre2MeshBvh> _bvh);
+
+      /// \brief Remove the cached hierarchy of a mesh. Thread safe.
+      /// \param[in] _owner Owner of the cache
+      /// \param[in] _key Unique key of the mesh
+      public: static void Evict(const void *_owner, uint64_t _key);
+
+      /// \brief Remove all hierarchies cached by an owner, e.g. when its
+      /// scene is cleared. Thread safe.
+      /// \param[in] _owner Owner of the cache
+      public: static void Clear(const void *_owner);
+
+      /// \brief Recursively build the hierarchy
+      /// \param[in] _nodeIdx Index of the node to fill in
+      /// \param[in] _begin First entry in _order covered by the node
+      /// \param[in] _end One past the last entry in _order covered by the node
+      /// \param[in,out] _order Triangle indices, partitioned in place
+      /// \param[in] _centroids Triangle centroids
+      private: void Build(uint32_t _nodeIdx, uint32_t _begin, uint32_t _end,
+                  std::vector<uint32_t> &_order,
+                  const std::vector<math::Vector3f> &_centroids);
+
+      /// \brief A node of the hierarchy
+      private: struct Node
+      {
+        /// \brief Min corner of the node bounds
+        float min[3];
+
+        /// \brief Max corner of the node bounds
+        float max[3];
+
+        /// \brief Index of the first triangle for leaf nodes. Index of the
+        /// left child for internal nodes; the right child follows it.
+        uint32_t offset = 0u;
+
+        /// \brief Number of triangles in a leaf node. 0 for internal nodes.
+        uint32_t count = 0u;
+      };
+
+      /// \brief A triangle stored as one vertex and two edges, which is the
+      /// form the intersection test needs.
+      private: struct Triangle
+      {
+        /// \brief First vertex
+        math::Vector3f v0;
+
+        /// \brief Second vertex minus first vertex
+        math::Vector3f e1;
+
+        /// \brief Third vertex minus first vertex
+        math::Vector3f e2;
+      };
+
+      /// \brief Nodes of the hierarchy. The root is the first node.
+      private: std::vector<Node> nodes;
+
+      /// \brief Triangles, ordered so that each leaf covers a contiguous
+      /// range.
+      private: std::vector<Triangle> triangles;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/common/config.hh>
+
+#include "Ogre2CacheFile.hh"
+#include "Ogre2CacheHash.hh"
+#include "Ogre2MeshCache.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreMeshSerializer.h>
+#include <Vao/OgreVaoManager.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Version of the cache layout. Bump to invalidate all entries when
+/// the way meshes are built changes.
+static const char kMeshCacheVersion[] = "1";
+
+/// \brief Length of a cache key: two 16 character hashes and a separator
+static const std::size_t kKeyLength = 33u;
+
+//////////////////////////////////////////////////
+Ogre2MeshCache::Ogre2MeshCache(const std::string &_path)
+  : path(_path)
+{
+}
+
+//////////////////////////////////////////////////
+bool Ogre2MeshCache::Enabled() const
+{
+  return !this->path.empty();
+}
+
+//////////////////////////////////////////////////
+std::string Ogre2MeshCache::Key(const MeshDescriptor &_desc,
+    bool _compact) const
+{
+  if (!this->Enabled() || !_desc.mesh)
+    return std::string();
+
+  // skeletons and animations are not part of the cached mesh
+  if (_desc.mesh->HasSkeleton())
+    return std::string();
+
+  // only meshes loaded from a file have content we can hash. Procedural
+  // meshes are cheap to build anyway
+  if (!common::isFile(_desc.meshName))
+    return std::string();
+
+  // options that change the generated geometry, plus the versions of the
+  // code that loads, generates and serializes it
+  std::stringstream options;
+  options << kMeshCacheVersion << "::"
+          << GZ_COMMON_VERSION_FULL << "::"
+          << GZ_RENDERING_VERSION_FULL << "::"
+          << OGRE_VERSION << "::"
+          << _desc.subMeshName << "::"
+          << (_desc.centerSubMesh ? "CENTERED" : "ORIGINAL") << "::"
+          << (_compact ? "COMPACT" : "FULL");
+  const std::string optionStr = options.str();
+
+  // identify the file by path, size and modification time first, so its
+  // content is only hashed the first time it is seen or after it changed
+  const std::string file = common::absPath(_desc.meshName);
+  std::error_code ec;
+  const uint64_t fileSize = std::filesystem::file_size(file, ec);
+  if (ec)
+    return std::string();
+  const int64_t fileTime = static_cast<int64_t>(
+      std::filesystem::last_write_time(file, ec).time_since_epoch().count());
+  if (ec)
+    return std::string();
+
+  Ogre2CacheHash fileId;
+  fileId.Add(file);
+  fileId.Add(&fileSize, sizeof(fileSize));
+  fileId.Add(&fileTime, sizeof(fileTime));
+  fileId.Add(optionStr);
+  const std::string index =
+      common::joinPaths(this->path, fileId.Hex() + ".key");
+
+  std::string key;
+  {
+    std::ifstream in(index);
+    if (in >> key && key.size() == kKeyLength &&
+        key.find_first_not_of("0123456789abcdef_") == std::string::npos)
+    {
+      return key;
+    }
+  }
+
+  // entries are keyed by content so copies of a mesh share them
+  Ogre2CacheHash fileHash;
+  if (!fileHash.AddFile(file))
+    return std::string();
+  Ogre2CacheHash optionHash;
+  optionHash.Add(optionStr);
+  key = fileHash.Hex() + "_" + optionHash.Hex();
+
+  if (common::isDirectory(this->path) ||
+      common::createDirectories(this->path))
+  {
+    Ogre2CacheFile::WriteText(index, key);
+  }
+  return key;
+}
+
+//////////////////////////////////////////////////
+Ogre::MeshPtr Ogre2MeshCache::Load(const std::string &_key,
+    const std::string &_name) const
+{
+  if (_key.empty())
+    return Ogre::MeshPtr();
+
+  // read the whole entry with a single call and deserialize from memory
+  const std::string entry = this->EntryPath(_key);
+  Ogre::DataStreamPtr stream = Ogre2CacheFile::Read(entry);
+  if (!stream)
+    return Ogre::MeshPtr();
+
+  Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().createManual(
+      _name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+  try
+  {
+    Ogre::MeshSerializer serializer(
+        Ogre::Root::getSingleton().getRenderSystem()->getVaoManager());
+    serializer.importMesh(stream, mesh.get());
+  }
+  catch (Ogre::Exception &e)
+  {
+    gzwarn << "Ignoring invalid mesh cache entry [" << entry << "]: "
+           << e.getDescription() << std::endl;
+    Ogre::MeshManager::getSingleton().remove(_name);
+    return Ogre::MeshPtr();
+  }
+
+  return mesh;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2MeshCache::Save(const std::string &_key,
+    const Ogre::MeshPtr &_mesh) const
+{
+  if (_key.empty() || !_mesh)
+    return false;
+
+  if (!common::isDirectory(this->path) &&
+      !common::createDirectories(this->path))
+  {
+    gzwarn << "Unable to create mesh cache directory [" << this->path << "]"
+           << std::endl;
+    return false;
+  }
+
+  return Ogre2CacheFile::Write(this->EntryPath(_key),
+      [&_mesh](const std::string &_tmp)
+      {
+        Ogre::MeshSerializer serializer(
+            Ogre::Root::getSingleton().getRenderSystem()->getVaoManager());
+        serializer.exportMesh(_mesh.get(), _tmp);
+        return true;
+      });
+}
+
+//////////////////////////////////////////////////
+std::string Ogre2MeshCache::EntryPath(const std::string &_key) const
+{
+  return common::joinPaths(this->path, _key + ".mesh");
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_RENDERING_OGRE2_OGRE2MESHCACHE_HH_
+#define GZ_RENDERING_OGRE2_OGRE2MESHCACHE_HH_
+
+#include <string>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/MeshDescriptor.hh"
+#include "gz/rendering/ogre2/Export.hh"
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief On-disk cache of GPU ready Ogre v2 meshes. Entries are stored
+    /// in the Ogre v2 binary mesh format and keyed by a hash of the mesh
+    /// file content and the descriptor options that change the geometry, so
+    /// a warm start can skip building the v1 mesh, importing it to v2 and
+    /// generating the shadow mapping buffers. A small index keyed by the
+    /// file path, size and modification time maps to the entry key, so mesh
+    /// files are only hashed when they are new or changed.
+    class GZ_RENDERING_OGRE2_HIDDEN Ogre2MeshCache
+    {
+      /// \brief Constructor
+      /// \param[in] _path Cache directory. Caching is disabled if empty.
+      public: explicit Ogre2MeshCache(const std::string &_path);
+
+      /// \brief Check if caching is enabled
+      /// \return True if a cache directory was given
+      public: bool Enabled() const;
+
+      /// \brief Compute the cache key of a mesh. The mesh file is hashed
+      /// and an index entry is written if the file path, size or
+      /// modification time are not in the index yet.
+      /// \param[in] _desc Descriptor of the mesh to cache
+      /// \param[in] _compact True if the mesh is built with compact vertex
+      /// and index formats
+      /// \return Cache key, or an empty string if the mesh can not be
+      /// cached, e.g. it is not loaded from a file or it is skinned.
+      public: std::string Key(const MeshDescriptor &_desc,
+                  bool _compact) const;
+
+      /// \brief Load a mesh from the cache
+      /// \param[in] _key Cache key returned by Key()
+      /// \param[in] _name Name of the Ogre mesh to create
+      /// \return The loaded mesh, or null if there is no valid entry for
+      /// _key. No mesh named _name is left behind on failure.
+      public: Ogre::MeshPtr Load(const std::string &_key,
+                  const std::string &_name) const;
+
+      /// \brief Save a mesh to the cache. The entry is written to a temporary
+      /// file first so concurrent processes never read a partial entry.
+      /// \param[in] _key Cache key returned by Key()
+      /// \param[in] _mesh Mesh to save
+      /// \return True on success
+      public: bool Save(const std::string &_key,
+                  const Ogre::MeshPtr &_mesh) const;
+
+      /// \brief Get the path of the cache entry for a key
+      /// \param[in] _key Cache key
+      /// \return Path of the entry file
+      private: std::string EntryPath(const std::string &_key) const;
+
+      /// \brief Cache directory
+      private: std::string path;
+    };
+    }
+  }
+}
+#endif
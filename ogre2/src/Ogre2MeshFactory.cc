@@ -16,10 +16,13 @@
  */
 
 
+#include <limits>
 #include <sstream>
+#include <unordered_map>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Material.hh>
+#include <gz/common/Mesh.hh>
 #include <gz/common/MeshManager.hh>
 #include <gz/common/Skeleton.hh>
 #include <gz/common/SkeletonAnimation.hh>
@@ -35,6 +38,9 @@
 #include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2Storage.hh"
 
+#include "Ogre2MeshBvh.hh"
+#include "Ogre2MeshCache.hh"
+
 #ifdef _MSC_VER
   #pragma warning(push, 0)
 #endif
@@ -51,6 +57,10 @@
 #include <OgreSubItem.h>
 #include <OgreSubMesh.h>
 #include <OgreSubMesh2.h>
+#include <OgreTangentSpaceCalc.h>
+#include <Vao/OgreIndexBufferPacked.h>
+#include <Vao/OgreVertexArrayObject.h>
+#include <Vao/OgreVertexBufferPacked.h>
 #ifdef _MSC_VER
   #pragma warning(pop)
 #endif
@@ -58,11 +68,61 @@
 /// \brief Private data for the Ogre2MeshFactory class
 class gz::rendering::Ogre2MeshFactoryPrivate
 {
+  /// \brief Constructor
+  public: Ogre2MeshFactoryPrivate()
+    : meshCache(Ogre2RenderEngine::Instance()->MeshCachePath()),
+      compactMeshes(Ogre2RenderEngine::Instance()->CompactMeshes())
+  {
+  }
+
+  /// \brief Create the material of a submesh
+  /// \param[in] _scene Scene to create the material in
+  /// \param[in] _mesh Mesh the submesh belongs to
+  /// \param[in] _subMesh Submesh to create the material for
+  /// \return Name of the created material
+  public: std::string CreateSubMeshMaterial(Ogre2ScenePtr _scene,
+              const common::Mesh &_mesh, const common::SubMesh &_subMesh);
+
   /// \brief Vector with the template materials, we keep the pointer to be
   /// able to remove it when nobody is using it.
   public: std::vector<MaterialPtr> materialCache;
+
+  /// \brief On-disk cache of GPU ready meshes
+  public: Ogre2MeshCache meshCache;
+
+  /// \brief Cache keys of meshes that were not found in the cache, indexed
+  /// by mesh name. They are saved once imported to v2.
+  public: std::unordered_map<std::string, std::string> pendingCacheKeys;
+
+  /// \brief True to build meshes with compact vertex and index formats
+  public: bool compactMeshes = false;
+
+  /// \brief Size in bytes that meshes built with compact formats would take
+  /// with full precision formats, indexed by mesh name. Used to report the
+  /// memory saved once the mesh is imported to v2.
+  public: std::unordered_map<std::string, std::size_t> fullPrecisionBytes;
 };
 
+/// \brief Get the size of the GPU vertex and index buffers of a mesh
+/// \param[in] _mesh Ogre v2 mesh
+/// \return Size in bytes
+static std::size_t meshBufferBytes(const Ogre::MeshPtr &_mesh)
+{
+  std::size_t bytes = 0u;
+  for (unsigned int i = 0u; i < _mesh->getNumSubMeshes(); ++i)
+  {
+    const auto &vaos = _mesh->getSubMesh(i)->mVao[Ogre::VpNormal];
+    if (vaos.empty())
+      continue;
+
+    for (const auto *vertexBuffer : vaos[0]->getVertexBuffers())
+      bytes += vertexBuffer->getTotalSizeBytes();
+    if (vaos[0]->getIndexBuffer())
+      bytes += vaos[0]->getIndexBuffer()->getTotalSizeBytes();
+  }
+  return bytes;
+}
+
 /// \brief Private data for the Ogre2SubMeshStoreFactory class
 class gz::rendering::Ogre2SubMeshStoreFactoryPrivate
 {
@@ -71,6 +131,32 @@ class gz::rendering::Ogre2SubMeshStoreFactoryPrivate
 using namespace gz;
 using namespace rendering;
 
+//////////////////////////////////////////////////
+std::string Ogre2MeshFactoryPrivate::CreateSubMeshMaterial(
+    Ogre2ScenePtr _scene, const common::Mesh &_mesh,
+    const common::SubMesh &_subMesh)
+{
+  common::MaterialPtr material;
+  if (const auto subMeshIdx = _subMesh.GetMaterialIndex())
+  {
+    material = _mesh.MaterialByIndex(subMeshIdx.value());
+  }
+
+  MaterialPtr mat = _scene->CreateMaterial();
+  if (material)
+  {
+    mat->CopyFrom(*material);
+    this->materialCache.push_back(mat);
+  }
+  else
+  {
+    MaterialPtr defaultMat = _scene->Material("Default/White");
+    if (defaultMat != nullptr)
+      mat->CopyFrom(defaultMat);
+  }
+  return mat->Name();
+}
+
 //////////////////////////////////////////////////
 Ogre2MeshFactory::Ogre2MeshFactory(Ogre2ScenePtr _scene) :
   scene(_scene), dataPtr(std::make_unique<Ogre2MeshFactoryPrivate>())
@@ -86,7 +172,13 @@ Ogre2MeshFactory::~Ogre2MeshFactory()
 void Ogre2MeshFactory::Clear()
 {
   for (auto &m : this->ogreMeshes)
+  {
+    // drop the ray query acceleration structure built for this mesh
+    Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().getByName(m);
+    if (mesh)
+      Ogre2MeshBvh::Evict(this->scene->OgreSceneManager(), mesh->getHandle());
     Ogre::MeshManager::getSingleton().remove(m);
+  }
 
   this->ogreMeshes.clear();
 }
@@ -165,8 +257,30 @@ Ogre::Item *Ogre2MeshFactory::OgreItem(const MeshDescriptor &_desc)
     // create v2 mesh from v1
     mesh = Ogre::MeshManager::getSingleton().createManual(
         name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    // full precision positions, half float texture coordinates, and
+    // QTangents when the v1 mesh has tangents. The index format is kept.
     mesh->importV1(v1Mesh.get(), false, true, true);
     this->ogreMeshes.push_back(name);
+
+    auto bytesIt = this->dataPtr->fullPrecisionBytes.find(name);
+    if (bytesIt != this->dataPtr->fullPrecisionBytes.end())
+    {
+      const std::size_t bytes = meshBufferBytes(mesh);
+      gzdbg << "Mesh [" << name << "] uses " << bytes << " bytes of vertex "
+            << "and index data, saving "
+            << static_cast<int64_t>(bytesIt->second) -
+               static_cast<int64_t>(bytes)
+            << " bytes compared to full precision formats" << std::endl;
+      this->dataPtr->fullPrecisionBytes.erase(bytesIt);
+    }
+
+    // store the imported mesh so the next run can load it directly
+    auto keyIt = this->dataPtr->pendingCacheKeys.find(name);
+    if (keyIt != this->dataPtr->pendingCacheKeys.end())
+    {
+      this->dataPtr->meshCache.Save(keyIt->second, mesh);
+      this->dataPtr->pendingCacheKeys.erase(keyIt);
+    }
   }
 
   return sceneManager->createItem(mesh, Ogre::SCENE_DYNAMIC);
@@ -204,6 +318,46 @@ bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
 
   Ogre2RenderEngine::Instance()->AddResourcePath(_desc.mesh->Path());
 
+  // a cached mesh is already in v2 format, only the materials need to be
+  // created
+  const std::string cacheKey =
+      this->dataPtr->meshCache.Key(_desc, this->dataPtr->compactMeshes);
+  if (!cacheKey.empty())
+  {
+    name = this->MeshName(_desc);
+    Ogre::MeshPtr cachedMesh = this->dataPtr->meshCache.Load(cacheKey, name);
+    if (cachedMesh)
+    {
+      std::vector<std::shared_ptr<common::SubMesh>> subMeshes;
+      for (unsigned int i = 0; i < _desc.mesh->SubMeshCount(); i++)
+      {
+        auto s = _desc.mesh->SubMeshByIndex(i).lock();
+        if (s && (_desc.subMeshName.empty() || s->Name() == _desc.subMeshName))
+          subMeshes.push_back(s);
+      }
+
+      if (subMeshes.size() == cachedMesh->getNumSubMeshes())
+      {
+        for (std::size_t i = 0u; i < subMeshes.size(); ++i)
+        {
+          cachedMesh->getSubMesh(static_cast<unsigned int>(i))->
+              setMaterialName(this->dataPtr->CreateSubMeshMaterial(
+              this->scene, *_desc.mesh, *subMeshes[i]));
+        }
+        this->ogreMeshes.push_back(name);
+        return true;
+      }
+
+      gzwarn << "Mesh cache entry for [" << _desc.meshName << "] does not "
+             << "match the mesh, rebuilding it" << std::endl;
+      Ogre::MeshManager::getSingleton().remove(name);
+    }
+    this->dataPtr->pendingCacheKeys[name] = cacheKey;
+  }
+
+  // size the mesh would take with full precision formats
+  std::size_t fullPrecisionBytes = 0u;
+
   try
   {
     name = this->MeshName(_desc);
@@ -449,45 +603,71 @@ bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
       vBuf->unlock();
 
       // Add all the indices
-      // allocate index buffer
+      // allocate index buffer. Compact meshes use 16 bit indices when all
+      // vertices can be addressed with them. The max value is left out
+      // since it is used as the primitive restart index.
+      const bool index16 = this->dataPtr->compactMeshes &&
+          subMesh.VertexCount() < std::numeric_limits<uint16_t>::max();
       ogreSubMesh->indexData[Ogre::VpNormal]->indexCount = subMesh.IndexCount();
 
       ogreSubMesh->indexData[Ogre::VpNormal]->indexBuffer =
         Ogre::v1::HardwareBufferManager::getSingleton().createIndexBuffer(
+            index16 ? Ogre::v1::HardwareIndexBuffer::IT_16BIT :
             Ogre::v1::HardwareIndexBuffer::IT_32BIT,
             ogreSubMesh->indexData[Ogre::VpNormal]->indexCount,
             Ogre::v1::HardwareBuffer::HBU_STATIC,
             true);
 
       iBuf = ogreSubMesh->indexData[Ogre::VpNormal]->indexBuffer;
-      indices = static_cast<uint32_t*>(
-          iBuf->lock(Ogre::v1::HardwareBuffer::HBL_DISCARD));
-
-
-      for (unsigned int j = 0; j < subMesh.IndexCount(); ++j)
-        *indices++ = static_cast<uint32_t>(subMesh.Index(j));
-
-      iBuf->unlock();
-
-      common::MaterialPtr material;
-      if (const auto subMeshIdx = subMesh.GetMaterialIndex())
+      if (index16)
       {
-        material = _desc.mesh->MaterialByIndex(subMeshIdx.value());
+        uint16_t *indices16 = static_cast<uint16_t*>(
+            iBuf->lock(Ogre::v1::HardwareBuffer::HBL_DISCARD));
+        for (unsigned int j = 0; j < subMesh.IndexCount(); ++j)
+          *indices16++ = static_cast<uint16_t>(subMesh.Index(j));
       }
-
-      MaterialPtr mat = this->scene->CreateMaterial();
-      if (material)
+      else
       {
-        mat->CopyFrom(*material);
-        this->dataPtr->materialCache.push_back(mat);
+        indices = static_cast<uint32_t*>(
+            iBuf->lock(Ogre::v1::HardwareBuffer::HBL_DISCARD));
+        for (unsigned int j = 0; j < subMesh.IndexCount(); ++j)
+          *indices++ = static_cast<uint32_t>(subMesh.Index(j));
       }
-      else
+
+      iBuf->unlock();
+
+      if (this->dataPtr->compactMeshes)
       {
-        MaterialPtr defaultMat = this->scene->Material("Default/White");
-        if (defaultMat != nullptr)
-          mat->CopyFrom(defaultMat);
+        fullPrecisionBytes += vertexDecl->getVertexSize(0) *
+            vertexData->vertexCount + subMesh.IndexCount() * sizeof(uint32_t);
+
+        // Generate tangents for lit triangle meshes. The v2 import packs the
+        // normal and tangent into a single QTangent, which is smaller than
+        // the normal alone.
+        if (subMesh.SubMeshPrimitiveType() == common::SubMesh::TRIANGLES &&
+            subMesh.NormalCount() > 0u && subMesh.TexCoordSetCount() > 0u &&
+            subMesh.TexCoordCountBySet(0u) > 0u)
+        {
+          try
+          {
+            Ogre::v1::TangentSpaceCalc tangentCalc;
+            tangentCalc.setStoreParityInW(true);
+            tangentCalc.setVertexData(vertexData);
+            tangentCalc.addIndexData(ogreSubMesh->indexData[Ogre::VpNormal],
+                ogreSubMesh->operationType);
+            tangentCalc.build(Ogre::VES_TANGENT, 0u, 0u);
+          }
+          catch(Ogre::Exception &e)
+          {
+            gzdbg << "Unable to pack the normals of submesh ["
+                  << subMesh.Name() << "]: " << e.getDescription()
+                  << std::endl;
+          }
+        }
       }
-      ogreSubMesh->setMaterialName(mat->Name());
+
+      ogreSubMesh->setMaterialName(this->dataPtr->CreateSubMeshMaterial(
+          this->scene, *_desc.mesh, subMesh));
     }
 
     math::Vector3d max = _desc.mesh->Max();
@@ -521,6 +701,9 @@ bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
           false);
     ogreMesh->_setBoundingSphereRadius((max - min).Length());
 
+    if (this->dataPtr->compactMeshes)
+      this->dataPtr->fullPrecisionBytes[name] = fullPrecisionBytes;
+
     // this line makes clear the mesh is loaded (avoids memory leaks)
     // ogreMesh->load();
   }
@@ -15,6 +15,9 @@
  *
  */
 
+#include <string>
+#include <utility>
+
 #include <gz/common/Console.hh>
 
 #include "gz/rendering/ogre2/Ogre2Camera.hh"
@@ -215,6 +218,8 @@ bool Ogre2Node::AttachChild(NodePtr _child)
 
   derived->SetParent(this->SharedThis());
   this->ogreNode->addChild(derived->Node());
+  if (this->scene)
+    this->scene->SetSensorStateDirty();
   return true;
 }
 
@@ -234,6 +239,8 @@ bool Ogre2Node::DetachChild(NodePtr _child)
   }
 
   this->ogreNode->removeChild(derived->Node());
+  if (this->scene)
+    this->scene->SetSensorStateDirty();
 
   return true;
 }
@@ -270,6 +277,15 @@ void Ogre2Node::SetInheritScale(bool _inherit)
     return;
 
   this->ogreNode->setInheritScale(_inherit);
+  this->MarkWorldTransformDirty();
+}
+
+//////////////////////////////////////////////////
+void Ogre2Node::SetUserData(const std::string &_key, Variant _value)
+{
+  BaseNode::SetUserData(_key, std::move(_value));
+  if (this->scene)
+    this->scene->SetSensorStateDirty();
 }
 
 //////////////////////////////////////////////////
@@ -15,6 +15,14 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <gz/common/Console.hh>
 #include <gz/common/Mesh.hh>
 #include <gz/common/MeshManager.hh>
@@ -30,6 +38,8 @@
 #include "gz/rendering/ogre2/Ogre2SelectionBuffer.hh"
 #include "gz/rendering/ogre2/Ogre2ThermalCamera.hh"
 
+#include "Ogre2MeshBvh.hh"
+
 #ifdef _MSC_VER
   #pragma warning(push, 0)
 #endif
@@ -42,6 +52,30 @@
   #pragma warning(pop)
 #endif
 
+/// \brief Snapshot of a mesh item that can be hit by a ray. Candidates are
+/// collected once per batch of rays so the rays can then be tested
+/// concurrently without touching Ogre.
+struct Ogre2RayQueryCandidate
+{
+  /// \brief Min corner of the item world bounding box
+  gz::math::Vector3d min;
+
+  /// \brief Max corner of the item world bounding box
+  gz::math::Vector3d max;
+
+  /// \brief World to mesh local space transform
+  gz::math::Matrix4d inverse;
+
+  /// \brief True if the item transform mirrors the mesh
+  bool flipWinding = false;
+
+  /// \brief Bounding volume hierarchy of the item mesh
+  std::shared_ptr<const gz::rendering::Ogre2MeshBvh> bvh;
+
+  /// \brief Id of the visual the item belongs to
+  unsigned int objectId = 0u;
+};
+
 /// \brief Private data class for Ogre2RayQuery
 class gz::rendering::Ogre2RayQueryPrivate
 {
@@ -56,6 +90,39 @@ class gz::rendering::Ogre2RayQueryPrivate
 
   /// \brief thread that ray query is created in
   public: std::thread::id threadId;
+
+  /// \brief Find the closest mesh item hit by a ray. The scene graph is
+  /// expected to be up to date.
+  /// \param[in] _sceneManager Scene manager to query
+  /// \param[in] _origin Ray origin in world frame
+  /// \param[in] _direction Ray direction in world frame
+  /// \return Intersection result
+  public: RayQueryResult Intersect(Ogre::SceneManager *_sceneManager,
+      const math::Vector3d &_origin, const math::Vector3d &_direction);
+
+  /// \brief Collect the mesh items that can be hit by rays. The scene graph
+  /// is expected to be up to date.
+  /// \param[in] _sceneManager Scene manager to collect items from
+  /// \param[out] _candidates Items that can be hit
+  public: static void CollectCandidates(Ogre::SceneManager *_sceneManager,
+      std::vector<Ogre2RayQueryCandidate> &_candidates);
+
+  /// \brief Find the closest candidate hit by a ray. Does not access Ogre
+  /// so it is safe to call from multiple threads.
+  /// \param[in] _candidates Items that can be hit
+  /// \param[in] _origin Ray origin in world frame
+  /// \param[in] _direction Ray direction in world frame
+  /// \param[in,out] _hits Scratch buffer for the candidates whose bounding
+  /// box is hit, reused between rays to avoid allocations
+  /// \return Intersection result
+  public: static RayQueryResult IntersectCandidates(
+      const std::vector<Ogre2RayQueryCandidate> &_candidates,
+      const math::Vector3d &_origin, const math::Vector3d &_direction,
+      std::vector<std::pair<double, std::size_t>> &_hits);
+
+  /// \brief Min number of rays handled by a worker thread. Smaller batches
+  /// are not worth the cost of starting a thread.
+  public: static constexpr std::size_t kRaysPerThread = 64u;
 };
 
 using namespace gz;
@@ -203,33 +270,281 @@ RayQueryResult Ogre2RayQuery::ClosestPointBySelectionBuffer()
   return result;
 }
 
+/// \brief Get the bounding volume hierarchy of an Ogre mesh. The hierarchy
+/// is built from the common::Mesh the Ogre mesh was created from the first
+/// time it is needed and cached in the scene by the Ogre resource handle
+/// afterwards.
+/// \param[in] _sceneManager Scene manager of the scene the mesh is used in
+/// \param[in] _mesh Ogre mesh
+/// \return Hierarchy of the mesh or null if the mesh has no matching
+/// common::Mesh
+static std::shared_ptr<const Ogre2MeshBvh> MeshBvh(
+    const Ogre::SceneManager *_sceneManager, const Ogre::MeshPtr &_mesh)
+{
+  std::shared_ptr<const Ogre2MeshBvh> bvh =
+      Ogre2MeshBvh::Lookup(_sceneManager, _mesh->getHandle());
+  if (bvh)
+    return bvh;
+
+  // mesh factory creates name with ::CENTER or ::ORIGINAL depending on
+  // the params passed in the MeshDescriptor when loading the mesh
+  // so strip off the suffix
+  std::string meshName = _mesh->getName();
+  size_t idx = meshName.find("::");
+  if (idx != std::string::npos)
+    meshName = meshName.substr(0, idx);
+
+  const common::Mesh *mesh =
+       common::MeshManager::Instance()->MeshByName(meshName);
+  if (!mesh)
+    return bvh;
+
+  bvh = std::make_shared<const Ogre2MeshBvh>(*mesh);
+  Ogre2MeshBvh::Store(_sceneManager, _mesh->getHandle(), bvh);
+  return bvh;
+}
+
+/// \brief Get the world to mesh local space transform of an item
+/// \param[in] _item Ogre item
+/// \param[out] _inverse World to mesh local space transform
+/// \param[out] _flipWinding True if the item transform mirrors the mesh
+/// \return False if the item transform is singular, e.g. it has a zero
+/// scale, and cannot be inverted
+static bool ItemInverseTransform(const Ogre::Item *_item,
+    math::Matrix4d &_inverse, bool &_flipWinding)
+{
+  math::Matrix4d transform = Ogre2Conversions::Convert(
+      _item->_getParentNodeFullTransform());
+  // only skip truly singular transforms; items scaled down a lot have a
+  // tiny determinant but can still be inverted
+  double det = transform.Determinant();
+  if (det == 0.0 || !std::isfinite(det))
+    return false;
+
+  _inverse = transform.Inverse();
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      if (!std::isfinite(_inverse(i, j)))
+        return false;
+    }
+  }
+  _flipWinding = det < 0.0;
+  return true;
+}
+
 //////////////////////////////////////////////////
 RayQueryResult Ogre2RayQuery::ClosestPointByIntersection(bool _forceSceneUpdate)
 {
-  RayQueryResult result;
   Ogre2ScenePtr ogreScene =
       std::dynamic_pointer_cast<Ogre2Scene>(this->Scene());
   if (!ogreScene)
-    return result;
+    return RayQueryResult();
 
   if (_forceSceneUpdate)
   {
     ogreScene->OgreSceneManager()->updateSceneGraph();
   }
 
-  Ogre::Ray mouseRay(Ogre2Conversions::Convert(this->origin),
-      Ogre2Conversions::Convert(this->direction));
+  return this->dataPtr->Intersect(ogreScene->OgreSceneManager(),
+      this->origin, this->direction);
+}
+
+//////////////////////////////////////////////////
+std::vector<RayQueryResult> Ogre2RayQuery::ClosestPoints(
+    const std::vector<math::Vector3d> &_origins,
+    const std::vector<math::Vector3d> &_directions,
+    bool _forceSceneUpdate)
+{
+  std::vector<RayQueryResult> results;
+  if (_origins.size() != _directions.size())
+  {
+    gzerr << "Number of ray origins [" << _origins.size()
+          << "] does not match number of ray directions ["
+          << _directions.size() << "]" << std::endl;
+    return results;
+  }
+
+  Ogre2ScenePtr ogreScene =
+      std::dynamic_pointer_cast<Ogre2Scene>(this->Scene());
+  if (!ogreScene)
+  {
+    results.resize(_origins.size());
+    return results;
+  }
 
-  if (!this->dataPtr->rayQuery)
+  if (_forceSceneUpdate && !_origins.empty())
   {
-    this->dataPtr->rayQuery =
-        ogreScene->OgreSceneManager()->createRayQuery(mouseRay);
+    ogreScene->OgreSceneManager()->updateSceneGraph();
   }
-  this->dataPtr->rayQuery->setSortByDistance(true);
-  this->dataPtr->rayQuery->setRay(mouseRay);
+
+  results.resize(_origins.size());
+  if (_origins.empty())
+    return results;
+
+  // Ogre scene queries are not thread safe so snapshot the items that can
+  // be hit once and test the rays against the snapshot in parallel
+  std::vector<Ogre2RayQueryCandidate> candidates;
+  Ogre2RayQueryPrivate::CollectCandidates(ogreScene->OgreSceneManager(),
+      candidates);
+  if (candidates.empty())
+    return results;
+
+  const std::size_t rayCount = _origins.size();
+  std::size_t threadCount = std::min<std::size_t>(
+      std::max(1u, std::thread::hardware_concurrency()),
+      (rayCount + Ogre2RayQueryPrivate::kRaysPerThread - 1u) /
+      Ogre2RayQueryPrivate::kRaysPerThread);
+
+  // rays are handed out in chunks so threads that get cheap rays, e.g.
+  // ones that miss everything, pick up more work
+  std::atomic<std::size_t> nextRay(0u);
+  auto work = [&]()
+  {
+    std::vector<std::pair<double, std::size_t>> hits;
+    while (true)
+    {
+      std::size_t begin = nextRay.fetch_add(
+          Ogre2RayQueryPrivate::kRaysPerThread);
+      if (begin >= rayCount)
+        break;
+      std::size_t end = std::min(rayCount,
+          begin + Ogre2RayQueryPrivate::kRaysPerThread);
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        results[i] = Ogre2RayQueryPrivate::IntersectCandidates(
+            candidates, _origins[i], _directions[i], hits);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount - 1u);
+  for (std::size_t i = 1u; i < threadCount; ++i)
+    threads.emplace_back(work);
+  work();
+  for (auto &thread : threads)
+    thread.join();
+
+  return results;
+}
+
+//////////////////////////////////////////////////
+void Ogre2RayQueryPrivate::CollectCandidates(
+    Ogre::SceneManager *_sceneManager,
+    std::vector<Ogre2RayQueryCandidate> &_candidates)
+{
+  auto itor = _sceneManager->getMovableObjectIterator(
+      Ogre::ItemFactory::FACTORY_TYPE_NAME);
+  while (itor.hasMoreElements())
+  {
+    Ogre::Item *ogreItem = static_cast<Ogre::Item *>(itor.getNext());
+    if (!ogreItem->isAttached() || !ogreItem->getVisible())
+      continue;
+
+    auto userAny = ogreItem->getUserObjectBindings().getUserAny();
+    if (userAny.isEmpty() || userAny.getType() != typeid(unsigned int))
+      continue;
+
+    Ogre2RayQueryCandidate candidate;
+    candidate.bvh = MeshBvh(_sceneManager, ogreItem->getMesh());
+    if (!candidate.bvh)
+      continue;
+
+    if (!ItemInverseTransform(ogreItem, candidate.inverse,
+        candidate.flipWinding))
+    {
+      continue;
+    }
+
+    Ogre::Aabb aabb = ogreItem->getWorldAabb();
+    candidate.min = Ogre2Conversions::Convert(aabb.getMinimum());
+    candidate.max = Ogre2Conversions::Convert(aabb.getMaximum());
+    candidate.objectId = Ogre::any_cast<unsigned int>(userAny);
+    _candidates.push_back(std::move(candidate));
+  }
+}
+
+//////////////////////////////////////////////////
+RayQueryResult Ogre2RayQueryPrivate::IntersectCandidates(
+    const std::vector<Ogre2RayQueryCandidate> &_candidates,
+    const math::Vector3d &_origin, const math::Vector3d &_direction,
+    std::vector<std::pair<double, std::size_t>> &_hits)
+{
+  RayQueryResult result;
+
+  // find the candidates whose bounding box is hit, same as the Ogre ray
+  // scene query used for single rays. Boxes that contain the ray origin are
+  // skipped for consistency with it.
+  _hits.clear();
+  for (std::size_t i = 0; i < _candidates.size(); ++i)
+  {
+    const Ogre2RayQueryCandidate &candidate = _candidates[i];
+    double tmin = 0.0;
+    double tmax = std::numeric_limits<double>::max();
+    bool hit = true;
+    for (unsigned int axis = 0; axis < 3u && hit; ++axis)
+    {
+      double invDir = 1.0 / _direction[axis];
+      double t0 = (candidate.min[axis] - _origin[axis]) * invDir;
+      double t1 = (candidate.max[axis] - _origin[axis]) * invDir;
+      if (t0 > t1)
+        std::swap(t0, t1);
+      tmin = t0 > tmin ? t0 : tmin;
+      tmax = t1 < tmax ? t1 : tmax;
+      hit = tmin <= tmax;
+    }
+    if (hit && tmin > 0.0)
+      _hits.emplace_back(tmin, i);
+  }
+  std::sort(_hits.begin(), _hits.end());
+
+  double distance = -1.0;
+  for (const auto &hit : _hits)
+  {
+    // nothing beyond the closest hit found so far can be any closer
+    if (distance >= 0.0 && hit.first > distance)
+      break;
+
+    const Ogre2RayQueryCandidate &candidate = _candidates[hit.second];
+    math::Vector3d localOrigin = candidate.inverse * _origin;
+    math::Vector3d localDirection =
+        candidate.inverse * (_origin + _direction) - localOrigin;
+
+    double t = distance < 0.0 ? std::numeric_limits<double>::max() :
+        distance;
+    if (candidate.bvh->Intersect(localOrigin, localDirection,
+        candidate.flipWinding, t))
+    {
+      distance = t;
+      result.distance = distance;
+      result.point = _origin + _direction * distance;
+      result.objectId = candidate.objectId;
+    }
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+RayQueryResult Ogre2RayQueryPrivate::Intersect(
+    Ogre::SceneManager *_sceneManager, const math::Vector3d &_origin,
+    const math::Vector3d &_direction)
+{
+  RayQueryResult result;
+
+  Ogre::Ray mouseRay(Ogre2Conversions::Convert(_origin),
+      Ogre2Conversions::Convert(_direction));
+
+  if (!this->rayQuery)
+  {
+    this->rayQuery = _sceneManager->createRayQuery(mouseRay);
+  }
+  this->rayQuery->setSortByDistance(true);
+  this->rayQuery->setRay(mouseRay);
 
   // Perform the scene query
-  Ogre::RaySceneQueryResult &ogreResult = this->dataPtr->rayQuery->execute();
+  Ogre::RaySceneQueryResult &ogreResult = this->rayQuery->execute();
 
   double distance = -1.0;
 
@@ -239,6 +554,11 @@ RayQueryResult Ogre2RayQuery::ClosestPointByIntersection(bool _forceSceneUpdate)
     if (iter->distance <= 0.0)
       continue;
 
+    // results are sorted by distance to the bounding boxes so nothing
+    // beyond the closest hit found so far can be any closer
+    if (distance >= 0.0 && iter->distance > distance)
+      break;
+
     if (!iter->movable || !iter->movable->getVisible())
       continue;
 
@@ -248,66 +568,32 @@ RayQueryResult Ogre2RayQuery::ClosestPointByIntersection(bool _forceSceneUpdate)
     {
       Ogre::Item *ogreItem = static_cast<Ogre::Item *>(iter->movable);
 
-      // mesh factory creates name with ::CENTER or ::ORIGINAL depending on
-      // the params passed in the MeshDescriptor when loading the mesh
-      // so strip off the suffix
-      std::string meshName = ogreItem->getMesh()->getName();
-      size_t idx = meshName.find("::");
-      if (idx != std::string::npos)
-        meshName = meshName.substr(0, idx);
-
-      const common::Mesh *mesh =
-           common::MeshManager::Instance()->MeshByName(meshName);
-
-      if (!mesh)
+      std::shared_ptr<const Ogre2MeshBvh> bvh =
+          MeshBvh(_sceneManager, ogreItem->getMesh());
+      if (!bvh)
         continue;
 
-      Ogre::Matrix4 transform = ogreItem->_getParentNodeFullTransform();
-
-      // test for hitting individual triangles on the mesh
-      for (unsigned int j = 0; j < mesh->SubMeshCount(); ++j)
+      // transform the ray into mesh local space instead of transforming
+      // every triangle into world space. The local direction is not
+      // normalized so the hit parameter is the same in both spaces.
+      math::Matrix4d inverse;
+      bool flipWinding = false;
+      if (!ItemInverseTransform(ogreItem, inverse, flipWinding))
+        continue;
+      math::Vector3d localOrigin = inverse * _origin;
+      math::Vector3d localDirection =
+          inverse * (_origin + _direction) - localOrigin;
+
+      // a mirroring transform flips the triangle winding
+      double t = distance < 0.0 ? std::numeric_limits<double>::max() :
+          distance;
+      if (bvh->Intersect(localOrigin, localDirection, flipWinding, t))
       {
-        auto s = mesh->SubMeshByIndex(j);
-        auto submesh = s.lock();
-        if (!submesh || submesh->VertexCount() < 3u)
-          continue;
-        unsigned int indexCount = submesh->IndexCount();
-        for (unsigned int k = 0; k < indexCount; k += 3)
-        {
-          if (indexCount <= k+2)
-            continue;
-
-          math::Vector3d vertexA =
-            submesh->Vertex(submesh->Index(k));
-          math::Vector3d vertexB =
-            submesh->Vertex(submesh->Index(k+1));
-          math::Vector3d vertexC =
-            submesh->Vertex(submesh->Index(k+2));
-
-          Ogre::Vector3 worldVertexA =
-              transform * Ogre2Conversions::Convert(vertexA);
-          Ogre::Vector3 worldVertexB =
-              transform * Ogre2Conversions::Convert(vertexB);
-          Ogre::Vector3 worldVertexC =
-              transform * Ogre2Conversions::Convert(vertexC);
-
-          // check for a hit against this triangle
-          std::pair<bool, Ogre::Real> hit = Ogre::Math::intersects(mouseRay,
-              worldVertexA, worldVertexB, worldVertexC,
-              true, false);
-
-          // if it was a hit check if its the closest
-          if (hit.first &&
-              (distance < 0.0f || hit.second < distance))
-          {
-            // this is the closest so far, save it off
-            distance = hit.second;
-            result.distance = distance;
-            result.point =
-                Ogre2Conversions::Convert(mouseRay.getPoint(distance));
-            result.objectId = Ogre::any_cast<unsigned int>(userAny);
-          }
-        }
+        // this is the closest so far, save it off
+        distance = t;
+        result.distance = distance;
+        result.point = _origin + _direction * distance;
+        result.objectId = Ogre::any_cast<unsigned int>(userAny);
       }
     }
   }
@@ -38,6 +38,7 @@
 #include "Ogre2GzHlmsPbsPrivate.hh"
 #include "Ogre2GzHlmsTerraPrivate.hh"
 #include "Ogre2GzHlmsUnlitPrivate.hh"
+#include "Ogre2HlmsCache.hh"
 
 #include "Terra/Hlms/OgreHlmsTerra.h"
 #include "Terra/Hlms/PbsListener/OgreHlmsPbsTerraShadows.h"
@@ -87,6 +88,19 @@ class GZ_RENDERING_OGRE2_HIDDEN
 
   /// \brief Custom Terra modifications
   public: Ogre::Ogre2GzHlmsTerra *gzHlmsTerra{nullptr};
+
+  /// \brief Directory of the on-disk mesh cache. Empty if disabled
+  public: std::string meshCachePath;
+
+  /// \brief True to build meshes with compact vertex and index formats
+  public: bool compactMeshes = false;
+
+  /// \brief Directory of the persistent shader cache. Empty if disabled
+  public: std::string shaderCachePath;
+
+  /// \brief Persistent cache of the generated and compiled shaders. Null
+  /// if disabled
+  public: std::unique_ptr<Ogre2HlmsCache> shaderCache;
 };
 
 using namespace gz;
@@ -159,6 +173,13 @@ void Ogre2RenderEngine::Destroy()
 
   if (this->ogreRoot)
   {
+    // keep the shaders generated and compiled in this run for the next one
+    if (this->dataPtr->shaderCache)
+    {
+      this->dataPtr->shaderCache->Save();
+      this->dataPtr->shaderCache.reset();
+    }
+
     // Clean up any textures that may still be in flight.
     Ogre::TextureGpuManager *mgr =
     this->ogreRoot->getRenderSystem()->getTextureGpuManager();
@@ -365,6 +386,18 @@ bool Ogre2RenderEngine::LoadImpl(
         this->dataPtr->graphicsAPI = GraphicsAPI::VULKAN;
   }
 
+  it = _params.find("meshCachePath");
+  if (it != _params.end())
+    this->dataPtr->meshCachePath = it->second;
+
+  it = _params.find("compactMeshes");
+  if (it != _params.end())
+    std::istringstream(it->second) >> this->dataPtr->compactMeshes;
+
+  it = _params.find("shaderCachePath");
+  if (it != _params.end())
+    this->dataPtr->shaderCachePath = it->second;
+
   try
   {
     this->LoadAttempt();
@@ -419,6 +452,14 @@ void Ogre2RenderEngine::LoadAttempt()
   this->ogreRoot->initialise(false);
   this->CreateRenderWindow();
   this->CreateResources();
+
+  // restore the shaders generated and compiled by previous runs
+  if (!this->dataPtr->shaderCachePath.empty())
+  {
+    this->dataPtr->shaderCache.reset(
+        new Ogre2HlmsCache(this->dataPtr->shaderCachePath));
+    this->dataPtr->shaderCache->Load();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -1223,6 +1264,24 @@ Ogre::CompositorWorkspaceListener *Ogre2RenderEngine::TerraWorkspaceListener()
   return this->dataPtr->terraWorkspaceListener.get();
 }
 
+//////////////////////////////////////////////////
+std::string Ogre2RenderEngine::MeshCachePath() const
+{
+  return this->dataPtr->meshCachePath;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2RenderEngine::CompactMeshes() const
+{
+  return this->dataPtr->compactMeshes;
+}
+
+//////////////////////////////////////////////////
+std::string Ogre2RenderEngine::ShaderCachePath() const
+{
+  return this->dataPtr->shaderCachePath;
+}
+
 //////////////////////////////////////////////////
 Ogre2RenderEngine *Ogre2RenderEngine::Instance()
 {
@@ -15,6 +15,8 @@
  *
  */
 
+#include <vector>
+
 #include <gz/common/Console.hh>
 
 #include "gz/rendering/Material.hh"
@@ -102,6 +104,10 @@ class gz::rendering::Ogre2RenderTargetPrivate
   /// actual window
   ///
   public: Ogre::TextureGpu *ogreTexture[2] = {nullptr, nullptr};
+
+  /// \brief Color image read back from the GPU before being converted to
+  /// bayer. Kept between frames to avoid reallocating it.
+  public: std::vector<unsigned char> bayerColorBuffer;
 };
 
 using namespace gz;
@@ -405,13 +411,15 @@ void Ogre2RenderTarget::Copy(Image &_image) const
       (_image.Format() == PF_BAYER_GBRG8) ||
       (_image.Format() == PF_BAYER_GRBG8))
   {
-    // create tmp color image to get data from gpu
-    Image colorImage(this->width, this->height, PF_R8G8B8);
-    dstBox.data = colorImage.Data();
+    // get the color image from the gpu into a reused buffer and convert it
+    // straight into the caller's image
+    std::vector<unsigned char> &colorBuffer = this->dataPtr->bayerColorBuffer;
+    colorBuffer.resize(dstBox.bytesPerImage);
+    dstBox.data = colorBuffer.data();
     Ogre::Image2::copyContentsToMemory(
         texture, texture->getEmptyBox(0u), dstBox, dstOgrePf);
-    // convert color image to bayer image
-    _image = gz::rendering::convertRGBToBayer(colorImage, _image.Format());
+    gz::rendering::convertRGBToBayer(colorBuffer.data(), this->width,
+        this->height, _image.Format(), _image.Data<unsigned char>());
   }
   else
   {
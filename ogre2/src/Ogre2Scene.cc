@@ -15,6 +15,11 @@
  *
  */
 
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <gz/common/Console.hh>
 
 #include "gz/rendering/base/SceneExt.hh"
@@ -53,6 +58,8 @@
 #include "gz/rendering/ogre2/Ogre2Visual.hh"
 #include "gz/rendering/ogre2/Ogre2WireBox.hh"
 
+#include "Ogre2MeshBvh.hh"
+
 #ifdef _MSC_VER
   #pragma warning(push, 0)
 #endif
@@ -84,6 +91,12 @@ class gz::rendering::Ogre2ScenePrivate
   /// \brief Flag to indicate if shadows need to be updated
   public: bool shadowsDirty = true;
 
+  /// \brief Version of the visual state read by sensor material switchers
+  public: uint64_t sensorStateVersion = 0u;
+
+  /// \brief Number of frames started on this scene
+  public: uint64_t frameNumber = 0u;
+
   /// \brief Flag to indicate if sky is enabled or not
   public: bool skyEnabled = false;
 
@@ -187,6 +200,7 @@ void Ogre2Scene::PreRender()
              "Scene::PreRender called again before calling Scene::PostRender. "
              "See Scene::SetCameraPassCountPerGpuFlush for details");
   this->dataPtr->frameUpdateStarted = true;
+  ++this->dataPtr->frameNumber;
 
   if (this->ShadowsDirty())
   {
@@ -295,6 +309,7 @@ void Ogre2Scene::StartRendering(Ogre::Camera *_camera)
 
   if (this->LegacyAutoGpuFlush())
   {
+    ++this->dataPtr->frameNumber;
     auto engine = Ogre2RenderEngine::Instance();
 
     const auto currTime = this->Time();
@@ -422,11 +437,94 @@ bool Ogre2Scene::LegacyAutoGpuFlush() const
   return this->dataPtr->cameraPassCountPerGpuFlush == 0u;
 }
 
+//////////////////////////////////////////////////
+std::size_t Ogre2Scene::SetNodeLocalPoses(const unsigned int *_ids,
+    const math::Pose3d *_poses, std::size_t _count, bool _parallel)
+{
+  // Look up nodes and compute the raw poses on this thread since the
+  // stores and the nodes' cached state are not thread safe
+  std::vector<std::pair<Ogre2Node *, math::Pose3d>> updates;
+  updates.reserve(_count);
+  std::size_t updated = 0u;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    NodePtr node = this->NodeById(_ids[i]);
+    if (!node || !_poses[i].IsFinite())
+      continue;
+
+    // nodes are kept alive by the scene's stores during the call
+    Ogre2Node *ogreNode = dynamic_cast<Ogre2Node *>(node.get());
+    if (!ogreNode || !ogreNode->ogreNode ||
+        dynamic_cast<Ogre2Camera *>(ogreNode))
+    {
+      // cameras limit how far they can be placed from the origin
+      node->SetLocalPose(_poses[i]);
+      ++updated;
+      continue;
+    }
+
+    math::Pose3d rawPose;
+    if (!ogreNode->ComputeRawLocalPose(_poses[i], rawPose))
+      continue;
+    updates.push_back({ogreNode, rawPose});
+  }
+
+  auto writePoses = [&updates](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      Ogre::SceneNode *sceneNode = updates[i].first->ogreNode;
+      const math::Pose3d &rawPose = updates[i].second;
+      sceneNode->setPosition(Ogre2Conversions::Convert(rawPose.Pos()));
+      sceneNode->setOrientation(Ogre2Conversions::Convert(rawPose.Rot()));
+    }
+  };
+
+  // Each ogre scene node owns its slots in the transform arrays, so
+  // different nodes can be written from different threads. Threads get
+  // contiguous ranges as neighboring nodes often share cache lines.
+  const std::size_t kPosesPerThread = 4096u;
+  unsigned int threadCount = 1u;
+  if (_parallel)
+  {
+    threadCount = static_cast<unsigned int>(std::min<std::size_t>(
+        std::max(1u, std::thread::hardware_concurrency()),
+        updates.size() / kPosesPerThread));
+    threadCount = std::max(1u, threadCount);
+  }
+
+  if (threadCount > 1u)
+  {
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1u; t < threadCount; ++t)
+    {
+      threads.emplace_back(writePoses, updates.size() * t / threadCount,
+          updates.size() * (t + 1u) / threadCount);
+    }
+    writePoses(0u, updates.size() / threadCount);
+    for (auto &thread : threads)
+      thread.join();
+  }
+  else
+  {
+    writePoses(0u, updates.size());
+  }
+
+  for (auto &update : updates)
+    update.first->MarkWorldTransformDirty();
+
+  return updated + updates.size();
+}
+
 //////////////////////////////////////////////////
 void Ogre2Scene::Clear()
 {
   this->meshFactory->Clear();
 
+  // drop the ray query acceleration structures of meshes not created by
+  // the mesh factory, e.g. heightmaps and dynamic renderables
+  Ogre2MeshBvh::Clear(this->ogreSceneManager);
+
   BaseScene::Clear();
 }
 
@@ -1432,6 +1530,24 @@ bool Ogre2Scene::ShadowsDirty() const
   return this->dataPtr->shadowsDirty;
 }
 
+//////////////////////////////////////////////////
+void Ogre2Scene::SetSensorStateDirty()
+{
+  ++this->dataPtr->sensorStateVersion;
+}
+
+//////////////////////////////////////////////////
+uint64_t Ogre2Scene::SensorStateVersion() const
+{
+  return this->dataPtr->sensorStateVersion;
+}
+
+//////////////////////////////////////////////////
+uint64_t Ogre2Scene::FrameNumber() const
+{
+  return this->dataPtr->frameNumber;
+}
+
 //////////////////////////////////////////////////
 void Ogre2Scene::SetSkyEnabled(bool _enabled)
 {
@@ -33,6 +33,7 @@
 #include "gz/rendering/Utils.hh"
 
 #include "Ogre2SegmentationMaterialSwitcher.hh"
+#include "Ogre2TextureReadback.hh"
 
 /// \brief Private data for the Ogre2SegmentationCamera class
 class gz::rendering::Ogre2SegmentationCameraPrivate
@@ -52,6 +53,9 @@ class gz::rendering::Ogre2SegmentationCameraPrivate
   /// \brief Output texture
   public: Ogre::TextureGpu *ogreSegmentationTexture {nullptr};
 
+  /// \brief Reads the output texture back to the CPU
+  public: Ogre2TextureReadback readback;
+
   /// \brief Dummy render texture for the depth data
   public: RenderTexturePtr segmentationTexture {nullptr};
 
@@ -264,34 +268,18 @@ void Ogre2SegmentationCamera::PostRender()
   const auto bytesPerChannel = PixelUtil::BytesPerChannel(format);
   const auto bufferSize = len * channelCount * bytesPerChannel;
 
-  Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->ogreSegmentationTexture, 0u, 0u);
-  Ogre::TextureBox box = image.getData(0);
-
   if (!this->dataPtr->buffer)
   {
     this->dataPtr->buffer = new uint8_t[bufferSize];
   }
 
-  uint8_t *bufferTmp = static_cast<uint8_t*>(box.data);
-
-  auto rawChannelCount = 4u;
-
-  for (unsigned int row = 0; row < height; ++row)
-  {
-    unsigned int rawDataRowIdx = row * box.bytesPerRow / bytesPerChannel;
-    for (unsigned int column = 0; column < width; ++column)
-    {
-      unsigned int idx = (row * width * channelCount) +
-          column * channelCount;
-      unsigned int rawIdx = rawDataRowIdx +
-          column * rawChannelCount;
-
-      this->dataPtr->buffer[idx] = bufferTmp[rawIdx];
-      this->dataPtr->buffer[idx + 1] = bufferTmp[rawIdx + 1];
-      this->dataPtr->buffer[idx + 2] = bufferTmp[rawIdx + 2];
-    }
-  }
+  // the raw gpu texture format is RGBA8. Repack it straight from the mapped
+  // staging memory into the output buffer
+  Ogre::TextureBox box =
+      this->dataPtr->readback.Map(this->dataPtr->ogreSegmentationTexture);
+  Ogre2TextureReadback::CopyRGBA8ToRGB8(box, width, height,
+      this->dataPtr->buffer);
+  this->dataPtr->readback.Unmap();
 
   this->dataPtr->newSegmentationFrame(
     this->dataPtr->buffer,
@@ -227,15 +227,43 @@ VisualPtr Ogre2SegmentationMaterialSwitcher::TopLevelModelVisual(
 }
 
 ////////////////////////////////////////////////
-void Ogre2SegmentationMaterialSwitcher::cameraPreRenderScene(
-    Ogre::Camera * /*_cam*/)
+void Ogre2SegmentationMaterialSwitcher::UpdateItemStates()
 {
-  this->colorToLabel.clear();
+  const uint64_t version = this->scene->SensorStateVersion();
+  auto heightmaps = this->scene->Heightmaps();
+
+  bool valid = this->itemStatesValid &&
+      version == this->sensorStateVersion &&
+      this->segmentationCamera->Type() == this->type &&
+      this->segmentationCamera->IsColoredMap() == this->coloredMap &&
+      this->segmentationCamera->BackgroundLabel() == this->backgroundLabel &&
+      this->segmentationCamera->BackgroundColor() == this->backgroundColor &&
+      heightmaps.size() == this->heightmapParameters.size();
+
+  // Items are created and destroyed with their geometries, which may
+  // happen without a visual being modified, so check that the items that
+  // belong to a visual are still the same ones
   auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
       Ogre::ItemFactory::FACTORY_TYPE_NAME);
+  std::size_t itemCount = 0u;
+  while (valid && itor.hasMoreElements())
+  {
+    Ogre::MovableObject *object = itor.peekNext();
+    const Ogre::Any &userAny = object->getUserObjectBindings().getUserAny();
+    if (!userAny.isEmpty() && userAny.getType() == typeid(unsigned int))
+    {
+      auto it = this->itemStates.find(object->getId());
+      valid = it != this->itemStates.end() && it->second.item == object;
+      ++itemCount;
+    }
+    itor.moveNext();
+  }
+  if (valid && itemCount == this->itemStates.size())
+    return;
 
-  auto engine = Ogre2RenderEngine::Instance();
-  engine->SetGzOgreRenderingMode(GORM_SOLID_COLOR);
+  this->colorToLabel.clear();
+  itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
+      Ogre::ItemFactory::FACTORY_TYPE_NAME);
 
   // Used for multi-link models, where each model has many ogre items but
   // belongs to the same object, and all of them has the same parent name
@@ -258,17 +286,8 @@ void Ogre2SegmentationMaterialSwitcher::cameraPreRenderScene(
       return object1->getName() > object2->getName();
   });
 
-  this->materialMap.clear();
-  this->datablockMap.clear();
-  Ogre::HlmsManager *hlmsManager = engine->OgreRoot()->getHlmsManager();
-
-  Ogre::HlmsDatablock *defaultPbs =
-    hlmsManager->getHlms(Ogre::HLMS_PBS)->getDefaultDatablock();
-
-  // Construct one now so that datablock->setBlendblock
-  // each is as fast as possible
-  const Ogre::HlmsBlendblock *noBlend =
-    hlmsManager->getBlendblock(Ogre::HlmsBlendblock());
+  std::unordered_map<Ogre::IdType, ItemState> prevItemStates;
+  prevItemStates.swap(this->itemStates);
 
   for (auto object : ogreObjects)
   {
@@ -292,73 +311,147 @@ void Ogre2SegmentationMaterialSwitcher::cameraPreRenderScene(
         gzerr << "Ogre Error:" << e.getFullDescription() << "\n";
       }
 
-      const Ogre::Vector4 customParameter =
-        ColorForVisual(visual, prevParentName);
+      ItemState &state = this->itemStates[item->getId()];
+      state.item = item;
+      state.customParameter = ColorForVisual(visual, prevParentName);
 
-      const size_t numSubItems = item->getNumSubItems();
-      for (size_t i = 0; i < numSubItems; ++i)
-      {
-        // Set the custom value to the sub item to render
-        Ogre::SubItem *subItem = item->getSubItem(i);
-        subItem->setCustomParameter(1, customParameter);
+      // keep the materials resolved in previous frames
+      auto prevIt = prevItemStates.find(item->getId());
+      if (prevIt != prevItemStates.end() && prevIt->second.item == item)
+        state.subItems = std::move(prevIt->second.subItems);
+      state.subItems.resize(item->getNumSubItems());
+    }
+  }
+
+  // Do the same with heightmaps / terrain
+  this->heightmapParameters.clear();
+  for (auto h : heightmaps)
+  {
+    auto heightmap = h.lock();
+    Ogre::Vector4 customParameter = Ogre::Vector4::ZERO;
+    if (heightmap)
+    {
+      VisualPtr visual = heightmap->Parent();
+      customParameter = ColorForVisual(visual, prevParentName);
+    }
+    this->heightmapParameters.push_back(customParameter);
+  }
+
+  // reset the count & colors tracking
+  this->instancesCount.clear();
+  this->takenColors.clear();
+  this->coloredLabel.clear();
+
+  this->itemStatesValid = true;
+  this->sensorStateVersion = version;
+  this->type = this->segmentationCamera->Type();
+  this->coloredMap = this->segmentationCamera->IsColoredMap();
+  this->backgroundLabel = this->segmentationCamera->BackgroundLabel();
+  this->backgroundColor = this->segmentationCamera->BackgroundColor();
+}
+
+////////////////////////////////////////////////
+void Ogre2SegmentationMaterialSwitcher::cameraPreRenderScene(
+    Ogre::Camera * /*_cam*/)
+{
+  auto engine = Ogre2RenderEngine::Instance();
+  engine->SetGzOgreRenderingMode(GORM_SOLID_COLOR);
+
+  this->UpdateItemStates();
+
+  this->materialMap.clear();
+  this->datablockMap.clear();
+  Ogre::HlmsManager *hlmsManager = engine->OgreRoot()->getHlmsManager();
+
+  Ogre::HlmsDatablock *defaultPbs =
+    hlmsManager->getHlms(Ogre::HLMS_PBS)->getDefaultDatablock();
+
+  // Construct one now so that datablock->setBlendblock
+  // each is as fast as possible
+  const Ogre::HlmsBlendblock *noBlend =
+    hlmsManager->getBlendblock(Ogre::HlmsBlendblock());
 
-        if (!subItem->getMaterial().isNull())
+  for (auto &[id, state] : this->itemStates)
+  {
+    Ogre::Item *item = state.item;
+    const size_t numSubItems = item->getNumSubItems();
+    for (size_t i = 0; i < numSubItems; ++i)
+    {
+      // Set the custom value to the sub item to render
+      Ogre::SubItem *subItem = item->getSubItem(i);
+      subItem->setCustomParameter(1, state.customParameter);
+
+      const Ogre::MaterialPtr &material = subItem->getMaterial();
+      if (!material.isNull())
+      {
+        this->materialMap.push_back({ subItem, material });
+
+        // We need to keep the material's vertex shader
+        // to keep vertex deformation consistent; so we use
+        // a cloned material with a different pixel shader
+        // https://github.com/gazebosim/gz-rendering/issues/544
+        //
+        // material may be a nullptr if we called setMaterial directly
+        // (i.e. it's not using Ogre2Material interface).
+        // In those cases we fallback to PBS in the current IORM mode.
+        //
+        // The lookup is only done again when the sub item's material
+        // changes.
+        SubItemMaterials &materials = state.subItems[i];
+        if (materials.material != material)
         {
-          this->materialMap.push_back({ subItem, subItem->getMaterial() });
-
-          // We need to keep the material's vertex shader
-          // to keep vertex deformation consistent; so we use
-          // a cloned material with a different pixel shader
-          // https://github.com/gazebosim/gz-rendering/issues/544
-          //
-          // material may be a nullptr if we called setMaterial directly
-          // (i.e. it's not using Ogre2Material interface).
-          // In those cases we fallback to PBS in the current IORM mode.
-          auto material = Ogre::MaterialManager::getSingleton().getByName(
-            subItem->getMaterial()->getName() + "_solid",
+          materials.material = material;
+          materials.solidMaterial.reset();
+          auto solidMaterial = Ogre::MaterialManager::getSingleton().getByName(
+            material->getName() + "_solid",
             Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
-          if (material)
+          materials.hasSolidMaterial = !solidMaterial.isNull();
+          if (solidMaterial)
           {
-            if (material->getLoadingState() ==
+            if (solidMaterial->getLoadingState() ==
                 Ogre::Resource::LOADSTATE_UNLOADED)
             {
-              // Manually defined materials like PointCloudPoint_solid need this
-              material->load();
+              // Manually defined materials like PointCloudPoint_solid need
+              // this
+              solidMaterial->load();
             }
 
-            if (material->getNumSupportedTechniques() > 0u)
-            {
-              subItem->setMaterial(material);
-            }
-          }
-          else
-          {
-            // The supplied vertex shader could not pair with the
-            // pixel shader we provide. Try to salvage the situation
-            // using PBS shader. Custom deformation won't work but
-            // if we're lucky that won't matter
-            subItem->setDatablock(defaultPbs);
+            if (solidMaterial->getNumSupportedTechniques() > 0u)
+              materials.solidMaterial = solidMaterial;
           }
         }
-        else
+
+        if (materials.solidMaterial)
         {
-          Ogre::HlmsDatablock *datablock = subItem->getDatablock();
-          const Ogre::HlmsBlendblock *blendblock = datablock->getBlendblock();
-
-          // We can't do any sort of blending. This isn't colour what we're
-          // storing, but rather an ID.
-          if (blendblock->mSourceBlendFactor != Ogre::SBF_ONE ||
-              blendblock->mDestBlendFactor != Ogre::SBF_ZERO ||
-              blendblock->mBlendOperation != Ogre::SBO_ADD ||
-              (blendblock->mSeparateBlend &&
-               (blendblock->mSourceBlendFactorAlpha != Ogre::SBF_ONE ||
-                blendblock->mDestBlendFactorAlpha != Ogre::SBF_ZERO ||
-                blendblock->mBlendOperationAlpha != Ogre::SBO_ADD)))
-          {
-            hlmsManager->addReference(blendblock);
-            this->datablockMap[datablock] = blendblock;
-            datablock->setBlendblock(noBlend);
-          }
+          subItem->setMaterial(materials.solidMaterial);
+        }
+        else if (!materials.hasSolidMaterial)
+        {
+          // The supplied vertex shader could not pair with the
+          // pixel shader we provide. Try to salvage the situation
+          // using PBS shader. Custom deformation won't work but
+          // if we're lucky that won't matter
+          subItem->setDatablock(defaultPbs);
+        }
+      }
+      else
+      {
+        Ogre::HlmsDatablock *datablock = subItem->getDatablock();
+        const Ogre::HlmsBlendblock *blendblock = datablock->getBlendblock();
+
+        // We can't do any sort of blending. This isn't colour what we're
+        // storing, but rather an ID.
+        if (blendblock->mSourceBlendFactor != Ogre::SBF_ONE ||
+            blendblock->mDestBlendFactor != Ogre::SBF_ZERO ||
+            blendblock->mBlendOperation != Ogre::SBO_ADD ||
+            (blendblock->mSeparateBlend &&
+             (blendblock->mSourceBlendFactorAlpha != Ogre::SBF_ONE ||
+              blendblock->mDestBlendFactorAlpha != Ogre::SBF_ZERO ||
+              blendblock->mBlendOperationAlpha != Ogre::SBO_ADD)))
+        {
+          hlmsManager->addReference(blendblock);
+          this->datablockMap[datablock] = blendblock;
+          datablock->setBlendblock(noBlend);
         }
       }
     }
@@ -366,27 +459,19 @@ void Ogre2SegmentationMaterialSwitcher::cameraPreRenderScene(
 
   // Do the same with heightmaps / terrain
   auto heightmaps = this->scene->Heightmaps();
-  for (auto h : heightmaps)
+  for (size_t i = 0; i < heightmaps.size(); ++i)
   {
-    auto heightmap = h.lock();
+    auto heightmap = heightmaps[i].lock();
     if (heightmap)
     {
       // TODO(anyone): Retrieve datablock and make sure it's not blending
       // like we do with Items (it should be impossible?)
-      VisualPtr visual = heightmap->Parent();
-      const Ogre::Vector4 customParameter =
-        ColorForVisual(visual, prevParentName);
-      heightmap->Terra()->SetSolidColor(1u, customParameter);
+      heightmap->Terra()->SetSolidColor(1u, this->heightmapParameters[i]);
     }
   }
 
   // Remove the reference count on noBlend we created
   hlmsManager->destroyBlendblock(noBlend);
-
-  // reset the count & colors tracking
-  this->instancesCount.clear();
-  this->takenColors.clear();
-  this->coloredLabel.clear();
 }
 
 ////////////////////////////////////////////////
@@ -413,19 +498,15 @@ void Ogre2SegmentationMaterialSwitcher::cameraPostRenderScene(
   //
   // This consumes more performance but it's the price to pay for
   // safety.
-  auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
-      Ogre::ItemFactory::FACTORY_TYPE_NAME);
-  while (itor.hasMoreElements())
+  for (auto &[id, state] : this->itemStates)
   {
-    Ogre::MovableObject *object = itor.peekNext();
-    Ogre::Item *item = static_cast<Ogre::Item *>(object);
+    Ogre::Item *item = state.item;
     const size_t numSubItems = item->getNumSubItems();
     for (size_t i = 0; i < numSubItems; ++i)
     {
       Ogre::SubItem *subItem = item->getSubItem(i);
       subItem->removeCustomParameter(1u);
     }
-    itor.moveNext();
   }
 
   // Restore Items with low level materials
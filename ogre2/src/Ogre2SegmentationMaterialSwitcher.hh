@@ -18,6 +18,7 @@
 #ifndef GZ_RENDERING_OGRE2_OGRE2SEGMENTATIONMATERIALSWITCHER_HH_
 #define GZ_RENDERING_OGRE2_OGRE2SEGMENTATIONMATERIALSWITCHER_HH_
 
+#include <cstdint>
 #include <random>
 #include <string>
 #include <unordered_map>
@@ -99,6 +100,67 @@ class GZ_RENDERING_OGRE2_VISIBLE Ogre2SegmentationMaterialSwitcher :
   /// \return True if taken, False otherwise
   private: bool IsTakenColor(const math::Color &_color);
 
+  /// \brief Update the segmentation state of all items if the scene or the
+  /// segmentation camera settings changed since the last update. Colors
+  /// depend on the order and instance count of all items so they are
+  /// computed for the whole scene at once.
+  private: void UpdateItemStates();
+
+  /// \brief Low level materials of a sub item
+  private: struct SubItemMaterials
+  {
+    /// \brief Original low level material of the sub item, null if it uses
+    /// an hlms datablock
+    Ogre::MaterialPtr material;
+
+    /// \brief Solid color variant of the material. Null if it has no
+    /// supported techniques, in which case the original is kept.
+    Ogre::MaterialPtr solidMaterial;
+
+    /// \brief False if the material has no solid color variant, in which
+    /// case the default pbs datablock is used instead
+    bool hasSolidMaterial = false;
+  };
+
+  /// \brief Segmentation state of an ogre item, kept across frames
+  private: struct ItemState
+  {
+    /// \brief The ogre item
+    Ogre::Item *item = nullptr;
+
+    /// \brief Custom parameter that outputs the item's color
+    Ogre::Vector4 customParameter;
+
+    /// \brief Low level materials of the sub items
+    std::vector<SubItemMaterials> subItems;
+  };
+
+  /// \brief Segmentation state of the items that belong to a visual.
+  /// Key: ogre item id.
+  private: std::unordered_map<Ogre::IdType, ItemState> itemStates;
+
+  /// \brief Custom parameters of the heightmaps, in the same order as
+  /// Ogre2Scene::Heightmaps
+  private: std::vector<Ogre::Vector4> heightmapParameters;
+
+  /// \brief True if itemStates has been computed
+  private: bool itemStatesValid = false;
+
+  /// \brief Scene sensor state version when itemStates was computed
+  private: uint64_t sensorStateVersion = 0u;
+
+  /// \brief Segmentation type when itemStates was computed
+  private: SegmentationType type = SegmentationType::ST_SEMANTIC;
+
+  /// \brief Colored map setting when itemStates was computed
+  private: bool coloredMap = false;
+
+  /// \brief Background label when itemStates was computed
+  private: int backgroundLabel = 0;
+
+  /// \brief Background color when itemStates was computed
+  private: math::Color backgroundColor;
+
   /// \brief A map of ogre sub item pointer to its original hlms maults to 10mK
   private: double resolution = 0.01;
 
@@ -15,11 +15,21 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <gz/math/Color.hh>
 
 #include "gz/common/Console.hh"
 #include "gz/rendering/RenderTypes.hh"
+#include "gz/rendering/Visual.hh"
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
 #include "gz/rendering/ogre2/Ogre2Heightmap.hh"
 #include "gz/rendering/ogre2/Ogre2MaterialSwitcher.hh"
@@ -38,6 +48,7 @@
 #include <Compositor/Pass/PassScene/OgreCompositorPassSceneDef.h>
 #include <OgreCamera.h>
 #include <OgreDepthBuffer.h>
+#include <OgreImage2.h>
 #include <OgreItem.h>
 #include <OgrePass.h>
 #include <OgreRoot.h>
@@ -52,6 +63,26 @@
 using namespace gz;
 using namespace rendering;
 
+/// \brief Pixels of an area query that share one selection color
+struct Ogre2SelectionBufferColorArea
+{
+  /// \brief Number of pixels with the color
+  unsigned int pixelCount = 0u;
+
+  /// \brief Distance from the camera to the closest point
+  double distance = std::numeric_limits<double>::infinity();
+
+  /// \brief Closest point in camera frame
+  Ogre::Vector3 point = Ogre::Vector3::ZERO;
+};
+
+/// \brief Name of the 1x1 render texture shared by all selection buffers
+static const char kSharedSelectionTexture[] = "SelectionPassTex";
+
+/// \brief Number of selection buffers using the shared 1x1 render texture.
+/// The texture is destroyed once the last of them is deleted.
+static unsigned int g_sharedSelectionTextureUsers = 0u;
+
 class gz::rendering::Ogre2SelectionBufferPrivate
 {
   /// \brief This is a material listener and a RenderTargetListener.
@@ -94,6 +125,83 @@ class gz::rendering::Ogre2SelectionBufferPrivate
 
   /// \brief The selection buffer material
   public: Ogre::MaterialPtr selectionMaterial;
+
+  /// \brief True to render the whole camera view into the selection buffer
+  public: bool fullFrame = false;
+
+  /// \brief Render texture the whole camera view is rendered into by full
+  /// frame and area queries. Created on first use and kept next to the
+  /// shared 1x1 render texture, so neither has to be recreated when
+  /// switching between point and full frame queries.
+  public: Ogre::TextureGpu *frameTexture = nullptr;
+
+  /// \brief Compositor workspace rendering into frameTexture
+  public: Ogre::CompositorWorkspace *frameWorkspace = nullptr;
+
+  /// \brief CPU copy of the selection buffer rendered in full frame mode
+  public: Ogre::Image2 frameImage;
+
+  /// \brief True if frameImage holds a rendered frame
+  public: bool frameValid = false;
+
+  /// \brief Scene frame number frameImage was rendered in
+  public: uint64_t frameNumber = 0u;
+
+  /// \brief Scene sensor state version frameImage was rendered with
+  public: uint64_t sensorStateVersion = 0u;
+
+  /// \brief Camera position frameImage was rendered from
+  public: Ogre::Vector3 framePosition = Ogre::Vector3::ZERO;
+
+  /// \brief Camera orientation frameImage was rendered from
+  public: Ogre::Quaternion frameOrientation = Ogre::Quaternion::IDENTITY;
+
+  /// \brief Camera projection matrix frameImage was rendered with
+  public: Ogre::Matrix4 frameProjection = Ogre::Matrix4::IDENTITY;
+
+  /// \brief Check whether the frame copied in full frame mode can still be
+  /// used to answer queries
+  /// \return True if the frame is up to date
+  public: bool FrameValid() const;
+
+  /// \brief Get the world pose of the camera from the scene graph. Unlike
+  /// Ogre::Camera::getDerivedPosition this does not read the transforms
+  /// cached by the last render, so it sees camera moves made since then.
+  /// \param[out] _position Camera world position
+  /// \param[out] _orientation Camera world orientation
+  public: void CameraPose(Ogre::Vector3 &_position,
+      Ogre::Quaternion &_orientation) const;
+
+  /// \brief Create frameTexture at the camera resolution and its
+  /// workspace
+  public: void CreateFrameTarget();
+
+  /// \brief Destroy frameTexture and its workspace
+  public: void DestroyFrameTarget();
+
+  /// \brief Render a selection buffer workspace
+  /// \param[in] _workspace Workspace to render
+  public: void Render(Ogre::CompositorWorkspace *_workspace);
+
+  /// \brief Check that the camera has a valid projection matrix. There could
+  /// be nan values if the camera was resized.
+  /// \return True if the projection matrix is valid
+  public: bool ProjectionValid() const;
+
+  /// \brief Get the id of the visual an entity of the selection buffer
+  /// belongs to
+  /// \param[in] _entName Name of the entity
+  /// \return Id of the visual, 0 if not found
+  public: unsigned int VisualId(const std::string &_entName) const;
+
+  /// \brief Get the ogre item and point of intersection encoded in a
+  /// selection buffer pixel
+  /// \param[in] _pixel Selection buffer pixel
+  /// \param[out] _item Ogre item at the pixel
+  /// \param[out] _point 3D point of intersection with the ogre item's mesh
+  /// \return True if an ogre item is found, false otherwise
+  public: bool ItemFromPixel(const Ogre::ColourValue &_pixel,
+      Ogre::Item *&_item, math::Vector3d &_point) const;
 };
 
 /////////////////////////////////////////////////
@@ -166,35 +274,95 @@ void Ogre2SelectionBuffer::Update()
   if (!this->dataPtr->renderTexture)
     return;
 
-  this->dataPtr->materialSwitcher->Reset();
+  this->dataPtr->Render(this->dataPtr->ogreCompositorWorkspace);
+
+  // this->dataPtr->renderTexture->copyContentsToMemory(*this->dataPtr->pixelBox,
+  //     Ogre::RenderTarget::FB_FRONT);
+}
+
+/////////////////////////////////////////////////
+void Ogre2SelectionBufferPrivate::Render(
+    Ogre::CompositorWorkspace *_workspace)
+{
+  this->materialSwitcher->Reset();
 
-  this->dataPtr->scene->StartForcedRender();
+  this->scene->StartForcedRender();
 
   // manual update
-  // this->dataPtr->ogreCompositorWorkspace->setEnabled(true);
+  // _workspace->setEnabled(true);
   // auto engine = Ogre2RenderEngine::Instance();
   // engine->OgreRoot()->renderOneFrame();
-  // this->dataPtr->ogreCompositorWorkspace->setEnabled(false);
-  this->dataPtr->ogreCompositorWorkspace->_validateFinalTarget();
-  this->dataPtr->ogreCompositorWorkspace->_beginUpdate(false);
-  this->dataPtr->ogreCompositorWorkspace->_update();
-  this->dataPtr->ogreCompositorWorkspace->_endUpdate(false);
+  // _workspace->setEnabled(false);
+  _workspace->_validateFinalTarget();
+  _workspace->_beginUpdate(false);
+  _workspace->_update();
+  _workspace->_endUpdate(false);
 
   Ogre::vector<Ogre::TextureGpu *>::type swappedTargets;
   swappedTargets.reserve(2u);
-  this->dataPtr->ogreCompositorWorkspace->_swapFinalTarget(swappedTargets);
+  _workspace->_swapFinalTarget(swappedTargets);
 
-  this->dataPtr->scene->FlushGpuCommandsAndStartNewFrame(1u, false);
+  this->scene->FlushGpuCommandsAndStartNewFrame(1u, false);
 
-  this->dataPtr->scene->EndForcedRender();
+  this->scene->EndForcedRender();
+}
 
-  // this->dataPtr->renderTexture->copyContentsToMemory(*this->dataPtr->pixelBox,
-  //     Ogre::RenderTarget::FB_FRONT);
+/////////////////////////////////////////////////
+void Ogre2SelectionBufferPrivate::CreateFrameTarget()
+{
+  Ogre::TextureGpuManager *textureMgr =
+    Ogre2RenderEngine::Instance()->OgreRoot()->getRenderSystem()->
+    getTextureGpuManager();
+  this->frameTexture = textureMgr->createTexture(
+      this->camera->getName() + "_SelectionFrameTex",
+      Ogre::GpuPageOutStrategy::SaveToSystemRam,
+      Ogre::TextureFlags::RenderToTexture,
+      Ogre::TextureTypes::Type2D);
+  this->frameTexture->setResolution(
+      std::max(this->width, 1u), std::max(this->height, 1u));
+  this->frameTexture->setNumMipmaps(1u);
+  this->frameTexture->setPixelFormat(Ogre::PFG_RGBA32_FLOAT);
+  this->frameTexture->scheduleTransitionTo(Ogre::GpuResidency::Resident);
+
+  // the compositor textures are sized relative to the final target so the
+  // workspace definition of the 1x1 texture works for both
+  this->frameWorkspace = this->ogreCompMgr->addWorkspace(
+      this->sceneMgr, this->frameTexture, this->selectionCamera,
+      this->ogreCompWorkspaceDefName, false);
+}
+
+/////////////////////////////////////////////////
+void Ogre2SelectionBufferPrivate::DestroyFrameTarget()
+{
+  this->frameValid = false;
+
+  if (this->frameWorkspace)
+  {
+    this->ogreCompMgr->removeWorkspace(this->frameWorkspace);
+    this->frameWorkspace = nullptr;
+  }
+
+  if (this->frameTexture)
+  {
+    Ogre::TextureGpuManager *textureMgr =
+      Ogre2RenderEngine::Instance()->OgreRoot()->getRenderSystem()->
+      getTextureGpuManager();
+    if (textureMgr->findTextureNoThrow(this->frameTexture->getName()))
+      textureMgr->destroyTexture(this->frameTexture);
+    this->frameTexture = nullptr;
+  }
 }
 
 /////////////////////////////////////////////////
 void Ogre2SelectionBuffer::DeleteRTTBuffer()
 {
+  this->dataPtr->DestroyFrameTarget();
+  if (this->dataPtr->selectionCamera)
+  {
+    this->dataPtr->selectionCamera->removeListener(
+        this->dataPtr->materialSwitcher.get());
+  }
+
   if (this->dataPtr->ogreCompositorWorkspace)
   {
     // TODO(ahcorde): Remove the workspace. Potential leak here
@@ -210,15 +378,21 @@ void Ogre2SelectionBuffer::DeleteRTTBuffer()
 
   if (this->dataPtr->renderTexture)
   {
-    auto engine = Ogre2RenderEngine::Instance();
-    auto ogreRoot = engine->OgreRoot();
-    Ogre::TextureGpuManager *textureMgr =
-      ogreRoot->getRenderSystem()->getTextureGpuManager();
-    if (textureMgr->findTextureNoThrow(
-        this->dataPtr->renderTexture->getName()))
+    // the 1x1 texture is shared with the workspaces of the other selection
+    // buffers so only the last user destroys it
+    this->dataPtr->renderTexture = nullptr;
+    if (g_sharedSelectionTextureUsers > 0u)
+      --g_sharedSelectionTextureUsers;
+    if (g_sharedSelectionTextureUsers == 0u)
     {
-      textureMgr->destroyTexture(this->dataPtr->renderTexture);
-      this->dataPtr->renderTexture = nullptr;
+      auto engine = Ogre2RenderEngine::Instance();
+      auto ogreRoot = engine->OgreRoot();
+      Ogre::TextureGpuManager *textureMgr =
+        ogreRoot->getRenderSystem()->getTextureGpuManager();
+      Ogre::TextureGpu *texture =
+          textureMgr->findTextureNoThrow(kSharedSelectionTexture);
+      if (texture)
+        textureMgr->destroyTexture(texture);
     }
   }
 }
@@ -231,7 +405,7 @@ void Ogre2SelectionBuffer::CreateRTTBuffer()
 
   Ogre::TextureGpuManager *textureMgr =
     ogreRoot->getRenderSystem()->getTextureGpuManager();
-  const std::string selectionTextureName = "SelectionPassTex";
+  const std::string selectionTextureName = kSharedSelectionTexture;
   bool hasSelectionTexture =
       textureMgr->findTextureNoThrow(selectionTextureName);
   this->dataPtr->renderTexture =
@@ -240,6 +414,7 @@ void Ogre2SelectionBuffer::CreateRTTBuffer()
         Ogre::GpuPageOutStrategy::SaveToSystemRam,
         Ogre::TextureFlags::RenderToTexture,
         Ogre::TextureTypes::Type2D);
+  ++g_sharedSelectionTextureUsers;
   if (!hasSelectionTexture)
   {
     this->dataPtr->renderTexture->setResolution(1, 1);
@@ -421,12 +596,7 @@ bool Ogre2SelectionBuffer::ExecuteQuery(const int _x, const int _y,
   if (!this->dataPtr->camera)
     return false;
 
-  // check camera has valid projection matrix
-  // There could be nan values if camera was resized
-  Ogre::Matrix4 projectionMatrix =
-      this->dataPtr->camera->getProjectionMatrix();
-  if (projectionMatrix.getTrans().isNaN() ||
-      projectionMatrix.extractQuaternion().isNaN())
+  if (!this->dataPtr->ProjectionValid())
     return false;
 
    const unsigned int targetWidth = this->dataPtr->width;
@@ -436,44 +606,64 @@ bool Ogre2SelectionBuffer::ExecuteQuery(const int _x, const int _y,
        || _y >= static_cast<int>(targetHeight))
      return false;
 
-  // 1x1 selection buffer, adapted from rviz
-  // http://docs.ros.org/indigo/api/rviz/html/c++/selection__manager_8cpp.html
-  unsigned int width = 1;
-  unsigned int height = 1;
-  float x1 = static_cast<float>(_x) /
-      static_cast<float>(targetWidth - 1) - 0.5f;
-  float y1 = static_cast<float>(_y) /
-      static_cast<float>(targetHeight - 1) - 0.5f;
-  float x2 = static_cast<float>(_x+width) /
-      static_cast<float>(targetWidth - 1) - 0.5f;
-  float y2 = static_cast<float>(_y+height) /
-      static_cast<float>(targetHeight - 1) - 0.5f;
-
-  Ogre::Matrix4 scaleMatrix = Ogre::Matrix4::IDENTITY;
-  Ogre::Matrix4 transMatrix = Ogre::Matrix4::IDENTITY;
-  scaleMatrix[0][0] = 1.0 / (x2-x1);
-  scaleMatrix[1][1] = 1.0 / (y2-y1);
-  transMatrix[0][3] -= x1+x2;
-  transMatrix[1][3] += y1+y2;
-  Ogre::Matrix4 customProjectionMatrix =
-      scaleMatrix * transMatrix *
-      this->dataPtr->camera->getProjectionMatrix();
-  this->dataPtr->selectionCamera->setCustomProjectionMatrix(true,
-      customProjectionMatrix);
-
-  this->dataPtr->selectionCamera->setPosition(
-      this->dataPtr->camera->getDerivedPosition());
-  this->dataPtr->selectionCamera->setOrientation(
-      this->dataPtr->camera->getDerivedOrientation());
-
-  // update render texture
-  this->Update();
+  Ogre::ColourValue pixel;
+  if (this->dataPtr->fullFrame)
+  {
+    if (!this->dataPtr->FrameValid())
+      this->UpdateFullFrame();
+    pixel = this->dataPtr->frameImage.getColourAt(
+        static_cast<uint32_t>(_x), static_cast<uint32_t>(_y), 0, 0);
+  }
+  else
+  {
+    // 1x1 selection buffer, adapted from rviz
+    // http://docs.ros.org/indigo/api/rviz/html/c++/selection__manager_8cpp.html
+    unsigned int width = 1;
+    unsigned int height = 1;
+    float x1 = static_cast<float>(_x) /
+        static_cast<float>(targetWidth - 1) - 0.5f;
+    float y1 = static_cast<float>(_y) /
+        static_cast<float>(targetHeight - 1) - 0.5f;
+    float x2 = static_cast<float>(_x+width) /
+        static_cast<float>(targetWidth - 1) - 0.5f;
+    float y2 = static_cast<float>(_y+height) /
+        static_cast<float>(targetHeight - 1) - 0.5f;
+
+    Ogre::Matrix4 scaleMatrix = Ogre::Matrix4::IDENTITY;
+    Ogre::Matrix4 transMatrix = Ogre::Matrix4::IDENTITY;
+    scaleMatrix[0][0] = 1.0 / (x2-x1);
+    scaleMatrix[1][1] = 1.0 / (y2-y1);
+    transMatrix[0][3] -= x1+x2;
+    transMatrix[1][3] += y1+y2;
+    Ogre::Matrix4 customProjectionMatrix =
+        scaleMatrix * transMatrix *
+        this->dataPtr->camera->getProjectionMatrix();
+    this->dataPtr->selectionCamera->setCustomProjectionMatrix(true,
+        customProjectionMatrix);
+
+    Ogre::Vector3 position;
+    Ogre::Quaternion orientation;
+    this->dataPtr->CameraPose(position, orientation);
+    this->dataPtr->selectionCamera->setPosition(position);
+    this->dataPtr->selectionCamera->setOrientation(orientation);
+
+    // update render texture
+    this->Update();
+
+    Ogre::Image2 image;
+    image.convertFromTexture(this->dataPtr->renderTexture, 0, 0);
+    pixel = image.getColourAt(0, 0, 0, 0);
+  }
 
-  Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->renderTexture, 0, 0);
-  Ogre::ColourValue pixel = image.getColourAt(0, 0, 0, 0);
+  return this->dataPtr->ItemFromPixel(pixel, _item, _point);
+}
 
-  float color = pixel[3];
+/////////////////////////////////////////////////
+bool Ogre2SelectionBufferPrivate::ItemFromPixel(
+    const Ogre::ColourValue &_pixel, Ogre::Item *&_item,
+    math::Vector3d &_point) const
+{
+  float color = _pixel[3];
   uint32_t *rgba = reinterpret_cast<uint32_t *>(&color);
   unsigned int r = *rgba >> 24 & 0xFF;
   unsigned int g = *rgba >> 16 & 0xFF;
@@ -482,12 +672,12 @@ bool Ogre2SelectionBuffer::ExecuteQuery(const int _x, const int _y,
   // todo(anyone) shaders may return nan values for semi-transparent objects
   // if there are no objects in the background (behind the semi-transparent
   // object)
-  math::Vector3d point(pixel[0], pixel[1], pixel[2]);
+  math::Vector3d point(_pixel[0], _pixel[1], _pixel[2]);
 
   auto rot = Ogre2Conversions::Convert(
-      this->dataPtr->camera->getParentSceneNode()->_getDerivedOrientation());
+      this->camera->getParentSceneNode()->_getDerivedOrientationUpdated());
   auto pos = Ogre2Conversions::Convert(
-      this->dataPtr->camera->getParentSceneNode()->_getDerivedPosition());
+      this->camera->getParentSceneNode()->_getDerivedPositionUpdated());
   math::Pose3d p(pos, rot);
   point = rot * point + pos;
 
@@ -498,7 +688,7 @@ bool Ogre2SelectionBuffer::ExecuteQuery(const int _x, const int _y,
   cv.B(b / 255.0);
 
   const std::string &entName =
-    this->dataPtr->materialSwitcher->EntityName(cv);
+    this->materialSwitcher->EntityName(cv);
 
   if (entName.empty())
   {
@@ -506,12 +696,12 @@ bool Ogre2SelectionBuffer::ExecuteQuery(const int _x, const int _y,
   }
   else
   {
-    auto collection = this->dataPtr->sceneMgr->findMovableObjects(
+    auto collection = this->sceneMgr->findMovableObjects(
         Ogre::ItemFactory::FACTORY_TYPE_NAME, entName);
     if (collection.empty())
     {
       // try heightmaps
-      auto heightmaps = this->dataPtr->scene->Heightmaps();
+      auto heightmaps = this->scene->Heightmaps();
       for (auto h : heightmaps)
       {
         auto heightmap = h.lock();
@@ -539,3 +729,293 @@ bool Ogre2SelectionBuffer::ExecuteQuery(const int _x, const int _y,
     }
   }
 }
+
+/////////////////////////////////////////////////
+bool Ogre2SelectionBufferPrivate::FrameValid() const
+{
+  if (!this->frameValid ||
+      this->frameNumber != this->scene->FrameNumber() ||
+      this->sensorStateVersion != this->scene->SensorStateVersion() ||
+      this->frameProjection != this->camera->getProjectionMatrix())
+  {
+    return false;
+  }
+
+  Ogre::Vector3 position;
+  Ogre::Quaternion orientation;
+  this->CameraPose(position, orientation);
+  return this->framePosition == position &&
+      this->frameOrientation == orientation;
+}
+
+/////////////////////////////////////////////////
+void Ogre2SelectionBufferPrivate::CameraPose(Ogre::Vector3 &_position,
+    Ogre::Quaternion &_orientation) const
+{
+  // Ogre::Node::setOrientation only flags the derived transforms as out of
+  // date, they are not recomputed until the next render. Compute them from
+  // the parent nodes instead, the same way Ogre::Camera derives its pose.
+  Ogre::SceneNode *node = this->camera->getParentSceneNode();
+  if (!node)
+  {
+    _position = this->camera->getPosition();
+    _orientation = this->camera->getOrientation();
+    return;
+  }
+
+  const Ogre::Quaternion nodeOrientation =
+      node->_getDerivedOrientationUpdated();
+  _orientation = nodeOrientation * this->camera->getOrientation();
+  _position = nodeOrientation * this->camera->getPosition() +
+      node->_getDerivedPositionUpdated();
+}
+
+/////////////////////////////////////////////////
+void Ogre2SelectionBuffer::UpdateFullFrame()
+{
+  if (!this->dataPtr->frameTexture)
+    this->dataPtr->CreateFrameTarget();
+
+  this->dataPtr->frameProjection =
+      this->dataPtr->camera->getProjectionMatrix();
+  this->dataPtr->CameraPose(this->dataPtr->framePosition,
+      this->dataPtr->frameOrientation);
+
+  this->dataPtr->selectionCamera->setCustomProjectionMatrix(true,
+      this->dataPtr->frameProjection);
+  this->dataPtr->selectionCamera->setPosition(this->dataPtr->framePosition);
+  this->dataPtr->selectionCamera->setOrientation(
+      this->dataPtr->frameOrientation);
+
+  // update render texture
+  this->dataPtr->Render(this->dataPtr->frameWorkspace);
+
+  this->dataPtr->frameImage.convertFromTexture(
+      this->dataPtr->frameTexture, 0, 0);
+  this->dataPtr->frameNumber = this->dataPtr->scene->FrameNumber();
+  this->dataPtr->sensorStateVersion =
+      this->dataPtr->scene->SensorStateVersion();
+  this->dataPtr->frameValid = true;
+}
+
+/////////////////////////////////////////////////
+void Ogre2SelectionBuffer::SetFullFrame(bool _fullFrame)
+{
+  if (this->dataPtr->fullFrame == _fullFrame)
+    return;
+
+  this->dataPtr->fullFrame = _fullFrame;
+}
+
+/////////////////////////////////////////////////
+bool Ogre2SelectionBuffer::FullFrame() const
+{
+  return this->dataPtr->fullFrame;
+}
+
+/////////////////////////////////////////////////
+bool Ogre2SelectionBufferPrivate::ProjectionValid() const
+{
+  Ogre::Matrix4 projectionMatrix = this->camera->getProjectionMatrix();
+  return !projectionMatrix.getTrans().isNaN() &&
+      !projectionMatrix.extractQuaternion().isNaN();
+}
+
+/////////////////////////////////////////////////
+unsigned int Ogre2SelectionBufferPrivate::VisualId(
+    const std::string &_entName) const
+{
+  if (_entName.empty())
+    return 0u;
+
+  auto collection = this->sceneMgr->findMovableObjects(
+      Ogre::ItemFactory::FACTORY_TYPE_NAME, _entName);
+  if (collection.empty())
+  {
+    for (auto h : this->scene->Heightmaps())
+    {
+      auto heightmap = h.lock();
+      if (heightmap && _entName == heightmap->Name())
+      {
+        VisualPtr parent = heightmap->Parent();
+        return parent ? parent->Id() : 0u;
+      }
+    }
+    return 0u;
+  }
+
+  const Ogre::Any &userAny =
+      collection[0]->getUserObjectBindings().getUserAny();
+  if (userAny.isEmpty() || userAny.getType() != typeid(unsigned int))
+    return 0u;
+
+  try
+  {
+    return Ogre::any_cast<unsigned int>(userAny);
+  }
+  catch(Ogre::Exception &e)
+  {
+    gzerr << "Ogre Error:" << e.getFullDescription() << "\n";
+  }
+  return 0u;
+}
+
+/// \brief Get the pixels of an image row whose centers are inside a
+/// polygon, using the even-odd rule
+/// \param[in] _polygon Polygon vertices in pixels
+/// \param[in] _y Image row
+/// \param[in,out] _crossings Scratch buffer for the x coordinates where the
+/// row crosses the polygon edges, reused between rows
+/// \param[out] _spans First and last pixel of each run of pixels inside the
+/// polygon. Not clipped to the image.
+static void PolygonRowSpans(const std::vector<math::Vector2i> &_polygon,
+    int _y, std::vector<double> &_crossings,
+    std::vector<std::pair<int, int>> &_spans)
+{
+  _crossings.clear();
+  _spans.clear();
+
+  // sample at pixel centers. Vertices have integer coordinates so the row
+  // never passes through one.
+  const double y = _y + 0.5;
+  for (std::size_t i = 0; i < _polygon.size(); ++i)
+  {
+    const math::Vector2i &a = _polygon[i];
+    const math::Vector2i &b = _polygon[(i + 1) % _polygon.size()];
+    if ((a.Y() < y) != (b.Y() < y))
+    {
+      const double t = (y - a.Y()) / (b.Y() - a.Y());
+      _crossings.push_back(a.X() + t * (b.X() - a.X()));
+    }
+  }
+  std::sort(_crossings.begin(), _crossings.end());
+
+  for (std::size_t i = 0; i + 1 < _crossings.size(); i += 2)
+  {
+    // pixel x is inside if its center x + 0.5 is in [start, end)
+    const int first = static_cast<int>(std::ceil(_crossings[i] - 0.5));
+    const int last = static_cast<int>(std::ceil(_crossings[i + 1] - 0.5)) - 1;
+    if (first <= last)
+      _spans.emplace_back(first, last);
+  }
+}
+
+/////////////////////////////////////////////////
+bool Ogre2SelectionBuffer::ExecuteAreaQuery(const math::Vector2i &_min,
+    const math::Vector2i &_max, const std::vector<math::Vector2i> &_polygon,
+    std::vector<VisualAreaResult> &_results)
+{
+  _results.clear();
+
+  if (!this->dataPtr->camera || !this->dataPtr->renderTexture ||
+      !this->dataPtr->ProjectionValid())
+  {
+    return false;
+  }
+
+  const int width = static_cast<int>(this->dataPtr->width);
+  const int height = static_cast<int>(this->dataPtr->height);
+  const int minX = std::max(std::min(_min.X(), _max.X()), 0);
+  const int minY = std::max(std::min(_min.Y(), _max.Y()), 0);
+  const int maxX = std::min(std::max(_min.X(), _max.X()), width - 1);
+  const int maxY = std::min(std::max(_min.Y(), _max.Y()), height - 1);
+  if (minX > maxX || minY > maxY)
+    return true;
+
+  // area queries always read the whole view, whatever the mode of point
+  // queries is
+  if (!this->dataPtr->FrameValid())
+    this->UpdateFullFrame();
+
+  // accumulate the pixels of each selection color first so that every
+  // color is resolved to a visual only once
+  std::unordered_map<uint32_t, Ogre2SelectionBufferColorArea> colors;
+  Ogre::TextureBox box = this->dataPtr->frameImage.getData(0);
+  std::vector<double> crossings;
+  std::vector<std::pair<int, int>> spans;
+  for (int y = minY; y <= maxY; ++y)
+  {
+    if (_polygon.empty())
+      spans.assign(1u, std::make_pair(minX, maxX));
+    else
+      PolygonRowSpans(_polygon, y, crossings, spans);
+
+    for (const auto &span : spans)
+    {
+      const int first = std::max(span.first, minX);
+      const int last = std::min(span.second, maxX);
+      if (first > last)
+        continue;
+
+      // each pixel holds the point in camera frame in rgb and the bits of
+      // the selection color in alpha
+      const float *pixel =
+          reinterpret_cast<const float *>(box.at(first, y, 0));
+      for (int x = first; x <= last; ++x, pixel += 4)
+      {
+        uint32_t rgba;
+        std::memcpy(&rgba, pixel + 3, sizeof(rgba));
+        Ogre2SelectionBufferColorArea &area = colors[rgba >> 8];
+        ++area.pixelCount;
+
+        // shaders may return nan values for semi-transparent objects
+        const Ogre::Vector3 point(pixel[0], pixel[1], pixel[2]);
+        const double distance = point.length();
+        if (std::isfinite(distance) && distance < area.distance)
+        {
+          area.distance = distance;
+          area.point = point;
+        }
+      }
+    }
+  }
+
+  auto rot = Ogre2Conversions::Convert(
+      this->dataPtr->camera->getParentSceneNode()->
+      _getDerivedOrientationUpdated());
+  auto pos = Ogre2Conversions::Convert(
+      this->dataPtr->camera->getParentSceneNode()->
+      _getDerivedPositionUpdated());
+
+  // a visual made of several items has several colors so merge by visual
+  std::unordered_map<unsigned int, std::size_t> resultIndices;
+  for (const auto &it : colors)
+  {
+    gz::math::Color cv;
+    cv.A(1.0);
+    cv.R(((it.first >> 16) & 0xFF) / 255.0);
+    cv.G(((it.first >> 8) & 0xFF) / 255.0);
+    cv.B((it.first & 0xFF) / 255.0);
+
+    const unsigned int objectId = this->dataPtr->VisualId(
+        this->dataPtr->materialSwitcher->EntityName(cv));
+    if (objectId == 0u)
+      continue;
+
+    auto inserted = resultIndices.emplace(objectId, _results.size());
+    if (inserted.second)
+    {
+      _results.emplace_back();
+      _results.back().objectId = objectId;
+    }
+
+    VisualAreaResult &result = _results[inserted.first->second];
+    result.pixelCount += it.second.pixelCount;
+    if (std::isfinite(it.second.distance) &&
+        (result.distance < 0 || it.second.distance < result.distance))
+    {
+      result.distance = it.second.distance;
+      result.point = rot * Ogre2Conversions::Convert(it.second.point) + pos;
+    }
+  }
+
+  // closest first, visuals without a valid point last
+  std::sort(_results.begin(), _results.end(),
+      [](const VisualAreaResult &_a, const VisualAreaResult &_b)
+      {
+        if ((_a.distance < 0) != (_b.distance < 0))
+          return _b.distance < 0;
+        return _a.distance < _b.distance;
+      });
+  return true;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstring>
+
+#include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
+
+#include "Ogre2TextureReadback.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreAsyncTextureTicket.h>
+#include <OgrePixelFormatGpuUtils.h>
+#include <OgreRenderSystem.h>
+#include <OgreRoot.h>
+#include <OgreTextureGpu.h>
+#include <OgreTextureGpuManager.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+using namespace gz;
+using namespace rendering;
+
+//////////////////////////////////////////////////
+Ogre2TextureReadback::~Ogre2TextureReadback()
+{
+  this->Destroy();
+}
+
+//////////////////////////////////////////////////
+Ogre::TextureBox Ogre2TextureReadback::Map(Ogre::TextureGpu *_texture)
+{
+  this->Download(_texture);
+  return this->Map();
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextureReadback::Download(Ogre::TextureGpu *_texture)
+{
+  if (!this->Compatible(_texture))
+  {
+    this->Destroy();
+    this->ticket = Ogre2RenderEngine::Instance()->OgreRoot()->
+        getRenderSystem()->getTextureGpuManager()->createAsyncTextureTicket(
+        _texture->getWidth(), _texture->getHeight(),
+        _texture->getDepthOrSlices(), _texture->getTextureType(),
+        _texture->getPixelFormat());
+  }
+
+  // blit data from gpu to cpu. The copy is executed by the GPU once the
+  // commands are flushed, so it does not block.
+  this->ticket->download(_texture, 0u, true);
+}
+
+//////////////////////////////////////////////////
+Ogre::TextureBox Ogre2TextureReadback::Map()
+{
+  return this->ticket->map(0u);
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextureReadback::Unmap()
+{
+  if (this->ticket)
+    this->ticket->unmap();
+}
+
+//////////////////////////////////////////////////
+bool Ogre2TextureReadback::Compatible(const Ogre::TextureGpu *_texture) const
+{
+  return this->ticket &&
+      this->ticket->getWidth() == _texture->getWidth() &&
+      this->ticket->getHeight() == _texture->getHeight() &&
+      this->ticket->getPixelFormatFamily() ==
+      Ogre::PixelFormatGpuUtils::getFamily(_texture->getPixelFormat());
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextureReadback::Destroy()
+{
+  if (!this->ticket)
+    return;
+
+  auto engine = Ogre2RenderEngine::Instance();
+  if (engine && engine->OgreRoot() && engine->OgreRoot()->getRenderSystem())
+  {
+    engine->OgreRoot()->getRenderSystem()->getTextureGpuManager()->
+        destroyAsyncTextureTicket(this->ticket);
+  }
+  this->ticket = nullptr;
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextureReadback::CopyRGBA8ToRGB8(const Ogre::TextureBox &_box,
+    unsigned int _width, unsigned int _height, uint8_t *_rgb)
+{
+  const uint8_t *src = static_cast<const uint8_t *>(_box.data);
+  for (unsigned int row = 0; row < _height; ++row)
+  {
+    // the texture box step size could be larger than our image buffer step
+    // size
+    const uint8_t *srcRow = src + row * _box.bytesPerRow;
+    uint8_t *dstRow = _rgb + static_cast<std::size_t>(row) * _width * 3u;
+    for (unsigned int column = 0; column < _width; ++column)
+    {
+      dstRow[0] = srcRow[0];
+      dstRow[1] = srcRow[1];
+      dstRow[2] = srcRow[2];
+      dstRow += 3u;
+      srcRow += 4u;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextureReadback::CopyRows(const Ogre::TextureBox &_box,
+    std::size_t _rowBytes, unsigned int _height, void *_dst)
+{
+  const uint8_t *src = static_cast<const uint8_t *>(_box.data);
+  uint8_t *dst = static_cast<uint8_t *>(_dst);
+  if (_box.bytesPerRow == _rowBytes)
+  {
+    memcpy(dst, src, _rowBytes * _height);
+    return;
+  }
+
+  // the texture box may not be a contiguous region of a texture
+  for (unsigned int row = 0; row < _height; ++row)
+    memcpy(dst + row * _rowBytes, src + row * _box.bytesPerRow, _rowBytes);
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2TEXTUREREADBACK_HH_
+#define GZ_RENDERING_OGRE2_OGRE2TEXTUREREADBACK_HH_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Export.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreTextureBox.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+namespace Ogre
+{
+  class AsyncTextureTicket;
+  class TextureGpu;
+}
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Reads sensor textures back to the CPU through a staging
+    /// ticket that is kept between frames. The mapped staging memory is
+    /// handed to the caller so sensors can repack it straight into their
+    /// output buffers, instead of going through a temporary Ogre::Image2
+    /// that is allocated and filled every frame.
+    class GZ_RENDERING_OGRE2_HIDDEN Ogre2TextureReadback
+    {
+      /// \brief Destructor. Destroys the staging ticket.
+      public: ~Ogre2TextureReadback();
+
+      /// \brief Download a texture and map its contents. The staging ticket
+      /// is recreated if the texture size or format changed. Must be
+      /// followed by a call to Unmap.
+      /// \param[in] _texture Texture to read back
+      /// \return Mapped texture contents. Rows may be padded, see
+      /// Ogre::TextureBox::bytesPerRow.
+      public: Ogre::TextureBox Map(Ogre::TextureGpu *_texture);
+
+      /// \brief Queue the download of a texture without waiting for it.
+      /// The staging ticket is recreated if the texture size or format
+      /// changed. The contents are mapped later with Map().
+      /// \param[in] _texture Texture to read back
+      public: void Download(Ogre::TextureGpu *_texture);
+
+      /// \brief Map the contents of the last download, waiting for it to
+      /// finish if needed. Must be followed by a call to Unmap.
+      /// \return Mapped texture contents. Rows may be padded, see
+      /// Ogre::TextureBox::bytesPerRow.
+      public: Ogre::TextureBox Map();
+
+      /// \brief Unmap the contents mapped by Map
+      public: void Unmap();
+
+      /// \brief Check if a texture can be downloaded without recreating
+      /// the staging ticket
+      /// \param[in] _texture Texture to read back
+      /// \return True if the ticket exists and matches the texture size
+      /// and format
+      public: bool Compatible(const Ogre::TextureGpu *_texture) const;
+
+      /// \brief Destroy the staging ticket. It is created again by the
+      /// next download.
+      public: void Destroy();
+
+      /// \brief Copy the first 3 channels of an 8 bit RGBA image into a
+      /// tightly packed RGB buffer
+      /// \param[in] _box Mapped RGBA8 image
+      /// \param[in] _width Image width in pixels
+      /// \param[in] _height Image height in pixels
+      /// \param[out] _rgb Output buffer of _width * _height * 3 bytes
+      public: static void CopyRGBA8ToRGB8(const Ogre::TextureBox &_box,
+                  unsigned int _width, unsigned int _height, uint8_t *_rgb);
+
+      /// \brief Copy the rows of an image into a tightly packed buffer
+      /// \param[in] _box Mapped image
+      /// \param[in] _rowBytes Number of bytes to copy per row
+      /// \param[in] _height Image height in pixels
+      /// \param[out] _dst Output buffer of _rowBytes * _height bytes
+      public: static void CopyRows(const Ogre::TextureBox &_box,
+                  std::size_t _rowBytes, unsigned int _height, void *_dst);
+
+      /// \brief Staging ticket used to download the texture
+      private: Ogre::AsyncTextureTicket *ticket = nullptr;
+    };
+    }
+  }
+}
+#endif
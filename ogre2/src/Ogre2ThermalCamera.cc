@@ -26,10 +26,13 @@
 #include <math.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(push, 0)
@@ -62,6 +65,8 @@
 
 #include "Terra/Terra.h"
 
+#include "Ogre2TextureReadback.hh"
+
 namespace gz
 {
 namespace rendering
@@ -89,6 +94,80 @@ class Ogre2ThermalCameraMaterialSwitcher : public Ogre::Camera::Listener
   /// \param[in] _resolution Temperature linear resolution
   public: void SetLinearResolution(double _resolution);
 
+  /// \brief Update the thermal state of all items if the scene or the
+  /// camera settings changed since the last update
+  private: void UpdateItemStates();
+
+  /// \brief Low level materials of a sub item
+  private: struct SubItemMaterials
+  {
+    /// \brief Original low level material of the sub item, null if it uses
+    /// an hlms datablock
+    Ogre::MaterialPtr material;
+
+    /// \brief Solid color variant of the material. Null if it has no
+    /// supported techniques, in which case the original is kept.
+    Ogre::MaterialPtr solidMaterial;
+
+    /// \brief False if the material has no solid color variant, in which
+    /// case the default pbs datablock is used instead
+    bool hasSolidMaterial = false;
+  };
+
+  /// \brief Switch a sub item that uses a low level material to the
+  /// material's solid color variant
+  /// \param[in] _subItem Sub item to switch
+  /// \param[in,out] _materials Materials of the sub item resolved in
+  /// previous frames. The lookup is only done again when the sub item's
+  /// material changes.
+  /// \param[in] _defaultPbs Datablock to use if there is no solid color
+  /// variant
+  private: void SwitchToSolidMaterial(Ogre::SubItem *_subItem,
+      SubItemMaterials &_materials, Ogre::HlmsDatablock *_defaultPbs);
+
+  /// \brief How an item is rendered by the thermal camera
+  private: enum class ItemType
+  {
+    /// \brief Item with a uniform temperature
+    TEMPERATURE,
+
+    /// \brief Item with a heat signature texture
+    HEAT_SIGNATURE,
+
+    /// \brief Item without temperature, converted from its color
+    BACKGROUND
+  };
+
+  /// \brief Thermal state of an ogre item, kept across frames
+  private: struct ItemState
+  {
+    /// \brief The ogre item
+    Ogre::Item *item = nullptr;
+
+    /// \brief How the item is rendered
+    ItemType type = ItemType::BACKGROUND;
+
+    /// \brief Normalized temperature of TEMPERATURE items
+    float color = 0.0f;
+
+    /// \brief Low level materials of the sub items
+    std::vector<SubItemMaterials> subItems;
+  };
+
+  /// \brief Thermal state of the items that belong to a visual.
+  /// Key: ogre item id.
+  private: std::unordered_map<Ogre::IdType, ItemState> itemStates;
+
+  /// \brief Custom parameters of the heightmaps, in the same order as
+  /// Ogre2Scene::Heightmaps
+  private: std::vector<Ogre::Vector4> heightmapParameters;
+
+  /// \brief True if itemStates has been computed
+  private: bool itemStatesValid = false;
+
+  /// \brief Scene sensor state version when itemStates was computed
+  private: uint64_t sensorStateVersion = 0u;
+
   /// \brief Callback when a camara is about to be rendered
   /// \param[in] _cam Ogre camera pointer which is about to render
   private: virtual void cameraPreRenderScene(
@@ -172,6 +251,9 @@ class gz::rendering::Ogre2ThermalCameraPrivate
   /// \brief Thermal textures.
   public: Ogre::TextureGpu *ogreThermalTexture{nullptr};
 
+  /// \brief Reads the thermal texture back to the CPU
+  public: Ogre2TextureReadback readback;
+
   /// \brief Dummy render texture for the thermal data
   public: RenderTexturePtr thermalTexture = nullptr;
 
@@ -220,335 +302,200 @@ void Ogre2ThermalCameraMaterialSwitcher::SetFormat(PixelFormat _format)
 {
   this->format = _format;
   this->bitDepth = 8u * PixelUtil::BytesPerChannel(format);
+  this->itemStatesValid = false;
 }
 
 //////////////////////////////////////////////////
 void Ogre2ThermalCameraMaterialSwitcher::SetLinearResolution(double _resolution)
 {
   this->resolution = _resolution;
+  this->itemStatesValid = false;
 }
-//////////////////////////////////////////////////
-void Ogre2ThermalCameraMaterialSwitcher::cameraPreRenderScene(
-    Ogre::Camera * /*_cam*/)
+/// \brief Get the temperature stored in a user data value
+/// \param[in] _value User data value
+/// \param[out] _temp Temperature in kelvin. Set to -1 if the value is not
+/// a number.
+/// \return True if the value holds a number
+static bool TemperatureFromUserData(const Variant &_value, float &_temp)
 {
-  auto engine = Ogre2RenderEngine::Instance();
-  engine->SetGzOgreRenderingMode(GORM_SOLID_THERMAL_COLOR_TEXTURED);
+  if (auto value = std::get_if<float>(&_value))
+    _temp = *value;
+  else if (auto value = std::get_if<double>(&_value))
+    _temp = static_cast<float>(*value);
+  else if (auto value = std::get_if<int>(&_value))
+    _temp = static_cast<float>(*value);
+  else
+  {
+    gzerr << "Error casting user data: temperature is not a number\n";
+    _temp = -1.0;
+    return false;
+  }
+  return true;
+}
 
-  // swap item to use v1 shader material
-  // Note: keep an eye out for performance impact on switching materials
-  // on the fly. We are not doing this often so should be ok.
-  this->itemDatablockMap.clear();
-  this->materialMap.clear();
-  Ogre::HlmsManager *hlmsManager = engine->OgreRoot()->getHlmsManager();
+//////////////////////////////////////////////////
+void Ogre2ThermalCameraMaterialSwitcher::UpdateItemStates()
+{
+  const uint64_t version = this->scene->SensorStateVersion();
+  auto heightmaps = this->scene->Heightmaps();
 
-  Ogre::HlmsDatablock *defaultPbs =
-    hlmsManager->getHlms(Ogre::HLMS_PBS)->getDefaultDatablock();
+  bool valid = this->itemStatesValid &&
+      version == this->sensorStateVersion &&
+      heightmaps.size() == this->heightmapParameters.size();
 
-  // Construct one now so that datablock->setBlendblock
-  // each is as fast as possible
-  const Ogre::HlmsBlendblock *noBlend =
-    hlmsManager->getBlendblock(Ogre::HlmsBlendblock());
+  // Items are created and destroyed with their geometries, which may
+  // happen without a visual being modified, so check that the items that
+  // belong to a visual are still the same ones
+  auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
+      Ogre::ItemFactory::FACTORY_TYPE_NAME);
+  std::size_t itemCount = 0u;
+  while (valid && itor.hasMoreElements())
+  {
+    Ogre::MovableObject *object = itor.peekNext();
+    const Ogre::Any &userAny = object->getUserObjectBindings().getUserAny();
+    if (!userAny.isEmpty() && userAny.getType() == typeid(unsigned int))
+    {
+      auto it = this->itemStates.find(object->getId());
+      valid = it != this->itemStates.end() && it->second.item == object;
+      ++itemCount;
+    }
+    itor.moveNext();
+  }
+  if (valid && itemCount == this->itemStates.size())
+    return;
 
+  auto engine = Ogre2RenderEngine::Instance();
   const std::string tempKey = "temperature";
 
-  auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
+  std::unordered_map<Ogre::IdType, ItemState> prevItemStates;
+  prevItemStates.swap(this->itemStates);
+
+  itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
       Ogre::ItemFactory::FACTORY_TYPE_NAME);
   while (itor.hasMoreElements())
   {
     Ogre::MovableObject *object = itor.peekNext();
     Ogre::Item *item = static_cast<Ogre::Item *>(object);
+    itor.moveNext();
 
     // get visual
     Ogre::Any userAny = item->getUserObjectBindings().getUserAny();
-    if (!userAny.isEmpty() && userAny.getType() == typeid(unsigned int))
-    {
-      VisualPtr result;
-      try
-      {
-        result = this->scene->VisualById(Ogre::any_cast<unsigned int>(userAny));
-      }
-      catch(Ogre::Exception &e)
-      {
-        gzerr << "Ogre Error:" << e.getFullDescription() << "\n";
-      }
-      Ogre2VisualPtr ogreVisual =
-          std::dynamic_pointer_cast<Ogre2Visual>(result);
+    if (userAny.isEmpty() || userAny.getType() != typeid(unsigned int))
+      continue;
 
-      // get temperature
-      Variant tempAny = ogreVisual->UserData(tempKey);
-      if (tempAny.index() != 0 && !std::holds_alternative<std::string>(tempAny))
-      {
-        float temp = -1.0;
-        bool foundTemp = true;
-        try
-        {
-          temp = std::get<float>(tempAny);
-        }
-        catch(...)
-        {
-          try
-          {
-            temp = static_cast<float>(std::get<double>(tempAny));
-          }
-          catch(...)
-          {
-            try
-            {
-              temp = static_cast<float>(std::get<int>(tempAny));
-            }
-            catch(std::bad_variant_access &e)
-            {
-              gzerr << "Error casting user data: " << e.what() << "\n";
-              temp = -1.0;
-              foundTemp = false;
-            }
-          }
-        }
-
-        // if a non-positive temperature was given, clamp it to 0
-        if (foundTemp && temp < 0.0)
-        {
-          temp = 0.0;
-          gzwarn << "Unable to set negatve temperature for: "
-              << ogreVisual->Name() << ". Value cannot be lower than absolute "
-              << "zero. Clamping temperature to 0 degrees Kelvin."
-              << std::endl;
-        }
+    VisualPtr result;
+    try
+    {
+      result = this->scene->VisualById(Ogre::any_cast<unsigned int>(userAny));
+    }
+    catch(Ogre::Exception &e)
+    {
+      gzerr << "Ogre Error:" << e.getFullDescription() << "\n";
+    }
+    Ogre2VisualPtr ogreVisual =
+        std::dynamic_pointer_cast<Ogre2Visual>(result);
 
-        const size_t numSubItems = item->getNumSubItems();
-        for (size_t i = 0; i < numSubItems; ++i)
-        {
-          Ogre::SubItem *subItem = item->getSubItem(i);
+    ItemState &state = this->itemStates[item->getId()];
+    state.item = item;
 
-          // normalize temperature value
-          const float color = static_cast<float>((temp / this->resolution) /
-                                                 ((1 << bitDepth) - 1.0));
+    // keep the materials resolved in previous frames
+    auto prevIt = prevItemStates.find(item->getId());
+    if (prevIt != prevItemStates.end() && prevIt->second.item == item)
+      state.subItems = std::move(prevIt->second.subItems);
+    state.subItems.resize(item->getNumSubItems());
 
-          // set g, b, a to 0. This will be used by shaders to determine
-          // if particular fragment is a heat source or not
-          // see media/materials/programs/GLSL/thermal_camera_fs.glsl
-          subItem->setCustomParameter(1, Ogre::Vector4(color, 0, 0, 0.0));
+    // get temperature
+    Variant tempAny = ogreVisual->UserData(tempKey);
+    if (tempAny.index() != 0 && !std::holds_alternative<std::string>(tempAny))
+    {
+      float temp = -1.0;
+      bool foundTemp = TemperatureFromUserData(tempAny, temp);
 
-          if (!subItem->getMaterial().isNull())
-          {
-            this->materialMap.push_back({ subItem, subItem->getMaterial() });
-
-            // We need to keep the material's vertex shader
-            // to keep vertex deformation consistent; so we use
-            // a cloned material with a different pixel shader
-            // https://github.com/gazebosim/gz-rendering/issues/544
-            //
-            // material may be a nullptr if we called setMaterial directly
-            // (i.e. it's not using Ogre2Material interface).
-            // In those cases we fallback to PBS in the current IORM mode.
-            auto material = Ogre::MaterialManager::getSingleton().getByName(
-              subItem->getMaterial()->getName() + "_solid",
-              Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
-            if (material)
-            {
-              if (material->getLoadingState() ==
-                  Ogre::Resource::LOADSTATE_UNLOADED)
-              {
-                // Manually defined materials like PointCloudPoint_solid
-                // need this
-                material->load();
-              }
-
-              if (material->getNumSupportedTechniques() > 0u)
-              {
-                subItem->setMaterial(material);
-              }
-            }
-            else
-            {
-              // The supplied vertex shader could not pair with the
-              // pixel shader we provide. Try to salvage the situation
-              // using PBS shader. Custom deformation won't work but
-              // if we're lucky that won't matter
-              subItem->setDatablock(defaultPbs);
-            }
-          }
-          else
-          {
-            Ogre::HlmsDatablock *datablock = subItem->getDatablock();
-            const Ogre::HlmsBlendblock *blendblock = datablock->getBlendblock();
-
-            // We can't do any sort of blending. This isn't colour what we're
-            // storing, but rather an ID.
-            if (blendblock->mSourceBlendFactor != Ogre::SBF_ONE ||
-                blendblock->mDestBlendFactor != Ogre::SBF_ZERO ||
-                blendblock->mBlendOperation != Ogre::SBO_ADD ||
-                (blendblock->mSeparateBlend &&
-                 (blendblock->mSourceBlendFactorAlpha != Ogre::SBF_ONE ||
-                  blendblock->mDestBlendFactorAlpha != Ogre::SBF_ZERO ||
-                  blendblock->mBlendOperationAlpha != Ogre::SBO_ADD)))
-            {
-              hlmsManager->addReference(blendblock);
-              this->datablockMap[datablock] = blendblock;
-              datablock->setBlendblock(noBlend);
-            }
-          }
-        }
-      }
-      // get heat signature and the corresponding min/max temperature values
-      else if (auto heatSignature = std::get_if<std::string>(&tempAny))
+      // if a non-positive temperature was given, clamp it to 0
+      if (foundTemp && temp < 0.0)
       {
-        // if this is the first time rendering the heat signature,
-        // we need to make sure that the texture is loaded and applied to
-        // the heat signature material before loading the material
-        if (this->heatSignatureMaterials.find(item->getId()) ==
-            this->heatSignatureMaterials.end())
-        {
-          // make sure the texture is in ogre's resource path
-          const auto &texture = *heatSignature;
-          engine->AddResourcePath(texture);
-
-          // create a material for this item, now that the texture has been
-          // searched for. We must clone the base heat signature material since
-          // different items may use different textures. We also append the
-          // item's ID to the end of the new material name to ensure new
-          // material uniqueness in case two items use the same heat signature
-          // texture, but have different temperature ranges
-          std::string baseName = common::basename(texture);
-          auto heatSignatureMaterial = this->baseHeatSigMaterial->clone(
-              this->name + "_" + baseName + "_" +
-              Ogre::StringConverter::toString(item->getId()));
-          auto textureUnitStatePtr = heatSignatureMaterial->
-            getTechnique(0)->getPass(0)->getTextureUnitState(0);
-          Ogre::String textureName = baseName;
-          textureUnitStatePtr->setTextureName(textureName);
-
-          // set temperature range for the heat signature
-          auto minTempVariant = ogreVisual->UserData("minTemp");
-          auto maxTempVariant = ogreVisual->UserData("maxTemp");
-          auto minTemperature = std::get_if<float>(&minTempVariant);
-          auto maxTemperature = std::get_if<float>(&maxTempVariant);
-          if (minTemperature && maxTemperature)
-          {
-            // make sure the temperature range is between [min, max] kelvin
-            // for the given pixel format and camera resolution
-            float maxTemp = ((1 << bitDepth) - 1.0) * this->resolution;
-            Ogre::GpuProgramParametersSharedPtr params =
-              heatSignatureMaterial->getTechnique(0)->getPass(0)->
-              getFragmentProgramParameters();
-            params->setNamedConstant("minTemp",
-                std::max(static_cast<float>(*minTemperature), 0.0f));
-            params->setNamedConstant("maxTemp",
-                std::min(static_cast<float>(*maxTemperature), maxTemp));
-            params->setNamedConstant("bitDepth",
-                static_cast<int>(this->bitDepth));
-            params->setNamedConstant("resolution",
-                static_cast<float>(this->resolution));
-          }
-          heatSignatureMaterial->load();
-          this->heatSignatureMaterials[item->getId()] = heatSignatureMaterial;
-        }
-
-        const size_t numSubItems = item->getNumSubItems();
-        for (size_t i = 0; i < numSubItems; ++i)
-        {
-          Ogre::SubItem *subItem = item->getSubItem(i);
+        temp = 0.0;
+        gzwarn << "Unable to set negatve temperature for: "
+            << ogreVisual->Name() << ". Value cannot be lower than absolute "
+            << "zero. Clamping temperature to 0 degrees Kelvin."
+            << std::endl;
+      }
 
-          if (!subItem->getMaterial().isNull())
-          {
-            // TODO(anyone): We need to keep the material's vertex shader
-            // to keep vertex deformation consistent. See
-            // https://github.com/gazebosim/gz-rendering/issues/544
-            this->materialMap.push_back({ subItem, subItem->getMaterial() });
-          }
-          else
-          {
-            // TODO(anyone): We're not using Hlms pieces, therefore HW
-            // vertex deformation (e.g. skinning / skeletal animation) won't
-            // show up correctly
-            Ogre::HlmsDatablock *datablock = subItem->getDatablock();
-            this->itemDatablockMap.push_back({ subItem, datablock });
-          }
+      // normalize temperature value
+      state.type = ItemType::TEMPERATURE;
+      state.color = static_cast<float>((temp / this->resolution) /
+                                       ((1 << bitDepth) - 1.0));
+    }
+    // get heat signature and the corresponding min/max temperature values
+    else if (auto heatSignature = std::get_if<std::string>(&tempAny))
+    {
+      state.type = ItemType::HEAT_SIGNATURE;
 
-          subItem->setMaterial(this->heatSignatureMaterials[item->getId()]);
-        }
-      }
-      else
+      // if this is the first time rendering the heat signature,
+      // we need to make sure that the texture is loaded and applied to
+      // the heat signature material before loading the material
+      if (this->heatSignatureMaterials.find(item->getId()) ==
+          this->heatSignatureMaterials.end())
       {
-        // Temperature object not set
-        // We consider this a "background object".
-        //
-        // It will be set to ambient temperature in thermal_camera_fs.glsl
-        // but its unlit, textured RGB color actually matters.
-        //
-        // We will be converting rgb values to temperature values in shaders
-        // thus we want them textured but without lighting
-        const size_t numSubItems = item->getNumSubItems();
-        for (size_t i = 0; i < numSubItems; ++i)
+        // make sure the texture is in ogre's resource path
+        const auto &texture = *heatSignature;
+        engine->AddResourcePath(texture);
+
+        // create a material for this item, now that the texture has been
+        // searched for. We must clone the base heat signature material since
+        // different items may use different textures. We also append the
+        // item's ID to the end of the new material name to ensure new
+        // material uniqueness in case two items use the same heat signature
+        // texture, but have different temperature ranges
+        std::string baseName = common::basename(texture);
+        auto heatSignatureMaterial = this->baseHeatSigMaterial->clone(
+            this->name + "_" + baseName + "_" +
+            Ogre::StringConverter::toString(item->getId()));
+        auto textureUnitStatePtr = heatSignatureMaterial->
+          getTechnique(0)->getPass(0)->getTextureUnitState(0);
+        Ogre::String textureName = baseName;
+        textureUnitStatePtr->setTextureName(textureName);
+
+        // set temperature range for the heat signature
+        auto minTempVariant = ogreVisual->UserData("minTemp");
+        auto maxTempVariant = ogreVisual->UserData("maxTemp");
+        auto minTemperature = std::get_if<float>(&minTempVariant);
+        auto maxTemperature = std::get_if<float>(&maxTempVariant);
+        if (minTemperature && maxTemperature)
         {
-          Ogre::SubItem *subItem = item->getSubItem(i);
-
-          const Ogre::HlmsDatablock *datablock = subItem->getDatablock();
-          const Ogre::ColourValue color = datablock->getDiffuseColour();
-          subItem->setCustomParameter(
-            1u, Ogre::Vector4(color.r, color.g, color.b, 1.0));
-
-          // Set 2 to signal we want it to multiply against
-          // the diffuse texture (if any). The actual value doesn't matter.
-          subItem->setCustomParameter(2u, Ogre::Vector4::ZERO);
-
-          if (!subItem->getMaterial().isNull())
-          {
-            this->materialMap.push_back({ subItem, subItem->getMaterial() });
-
-            // We need to keep the material's vertex shader
-            // to keep vertex deformation consistent; so we use
-            // a cloned material with a different pixel shader
-            // https://github.com/gazebosim/gz-rendering/issues/544
-            //
-            // material may be a nullptr if we called setMaterial directly
-            // (i.e. it's not using Ogre2Material interface).
-            // In those cases we fallback to PBS in the current IORM mode.
-            auto material = Ogre::MaterialManager::getSingleton().getByName(
-              subItem->getMaterial()->getName() + "_solid",
-              Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
-            if (material)
-            {
-              if (material->getLoadingState() ==
-                  Ogre::Resource::LOADSTATE_UNLOADED)
-              {
-                // Manually defined materials like PointCloudPoint_solid
-                // need this
-                material->load();
-              }
-
-              if (material->getNumSupportedTechniques() > 0u)
-              {
-                subItem->setMaterial(material);
-              }
-            }
-            else
-            {
-              // The supplied vertex shader could not pair with the
-              // pixel shader we provide. Try to salvage the situation
-              // using PBS shader. Custom deformation won't work but
-              // if we're lucky that won't matter
-              subItem->setDatablock(defaultPbs);
-            }
-          }
-          else
-          {
-            // We don't save to this->datablockMap because we're already
-            // honouring the original HlmsBlendblock. There's nothing
-            // to override.
-          }
+          // make sure the temperature range is between [min, max] kelvin
+          // for the given pixel format and camera resolution
+          float maxTemp = ((1 << bitDepth) - 1.0) * this->resolution;
+          Ogre::GpuProgramParametersSharedPtr params =
+            heatSignatureMaterial->getTechnique(0)->getPass(0)->
+            getFragmentProgramParameters();
+          params->setNamedConstant("minTemp",
+              std::max(static_cast<float>(*minTemperature), 0.0f));
+          params->setNamedConstant("maxTemp",
+              std::min(static_cast<float>(*maxTemperature), maxTemp));
+          params->setNamedConstant("bitDepth",
+              static_cast<int>(this->bitDepth));
+          params->setNamedConstant("resolution",
+              static_cast<float>(this->resolution));
         }
+        heatSignatureMaterial->load();
+        this->heatSignatureMaterials[item->getId()] = heatSignatureMaterial;
       }
     }
-
-    itor.moveNext();
+    else
+    {
+      // Temperature object not set
+      // We consider this a "background object".
+      state.type = ItemType::BACKGROUND;
+    }
   }
 
   // Do the same with heightmaps / terrain
-  auto heightmaps = this->scene->Heightmaps();
+  this->heightmapParameters.clear();
   for (auto h : heightmaps)
   {
     auto heightmap = h.lock();
+    Ogre::Vector4 customParameter(1.0, 1.0, 1.0, 1.0);
     if (heightmap)
     {
       VisualPtr visual = heightmap->Parent();
@@ -558,31 +505,7 @@ void Ogre2ThermalCameraMaterialSwitcher::cameraPreRenderScene(
       if (tempAny.index() != 0 && !std::holds_alternative<std::string>(tempAny))
       {
         float temp = -1.0;
-        bool foundTemp = true;
-        try
-        {
-          temp = std::get<float>(tempAny);
-        }
-        catch (...)
-        {
-          try
-          {
-            temp = static_cast<float>(std::get<double>(tempAny));
-          }
-          catch (...)
-          {
-            try
-            {
-              temp = static_cast<float>(std::get<int>(tempAny));
-            }
-            catch (std::bad_variant_access &e)
-            {
-              gzerr << "Error casting user data: " << e.what() << "\n";
-              temp = -1.0;
-              foundTemp = false;
-            }
-          }
-        }
+        bool foundTemp = TemperatureFromUserData(tempAny, temp);
 
         // if a non-positive temperature was given, clamp it to 0
         if (foundTemp && temp < 0.0)
@@ -597,10 +520,7 @@ void Ogre2ThermalCameraMaterialSwitcher::cameraPreRenderScene(
         // normalize temperature value
         const float color = static_cast<float>((temp / this->resolution) /
                                                ((1 << bitDepth) - 1.0));
-
-        heightmap->Terra()->SetSolidColor(1u, Ogre::Vector4(color, 0, 0, 0.0));
-        // TODO(anyone): Retrieve datablock and make sure it's not blending
-        // like we do with Items (it should be impossible?)
+        customParameter = Ogre::Vector4(color, 0, 0, 0.0);
       }
       // get heat signature and the corresponding min/max temperature values
       else if (std::get_if<std::string>(&tempAny))
@@ -608,21 +528,208 @@ void Ogre2ThermalCameraMaterialSwitcher::cameraPreRenderScene(
         gzerr << "Heat Signature not yet supported by Heightmaps. Simulation "
                   "may crash!\n";
       }
-      else
+      // else temperature object not set
+      // We consider this a "background object".
+      // TODO(anyone): Retrieve datablock and get diffuse color
+      // (it's likely gonna be 1 1 1 1 anyway... Does it matter?).
+    }
+    this->heightmapParameters.push_back(customParameter);
+  }
+
+  this->itemStatesValid = true;
+  this->sensorStateVersion = version;
+}
+
+//////////////////////////////////////////////////
+void Ogre2ThermalCameraMaterialSwitcher::SwitchToSolidMaterial(
+    Ogre::SubItem *_subItem, SubItemMaterials &_materials,
+    Ogre::HlmsDatablock *_defaultPbs)
+{
+  const Ogre::MaterialPtr &material = _subItem->getMaterial();
+  this->materialMap.push_back({ _subItem, material });
+
+  // We need to keep the material's vertex shader
+  // to keep vertex deformation consistent; so we use
+  // a cloned material with a different pixel shader
+  // https://github.com/gazebosim/gz-rendering/issues/544
+  //
+  // material may be a nullptr if we called setMaterial directly
+  // (i.e. it's not using Ogre2Material interface).
+  // In those cases we fallback to PBS in the current IORM mode.
+  if (_materials.material != material)
+  {
+    _materials.material = material;
+    _materials.solidMaterial.reset();
+    auto solidMaterial = Ogre::MaterialManager::getSingleton().getByName(
+      material->getName() + "_solid",
+      Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    _materials.hasSolidMaterial = !solidMaterial.isNull();
+    if (solidMaterial)
+    {
+      if (solidMaterial->getLoadingState() ==
+          Ogre::Resource::LOADSTATE_UNLOADED)
+      {
+        // Manually defined materials like PointCloudPoint_solid
+        // need this
+        solidMaterial->load();
+      }
+
+      if (solidMaterial->getNumSupportedTechniques() > 0u)
+        _materials.solidMaterial = solidMaterial;
+    }
+  }
+
+  if (_materials.solidMaterial)
+  {
+    _subItem->setMaterial(_materials.solidMaterial);
+  }
+  else if (!_materials.hasSolidMaterial)
+  {
+    // The supplied vertex shader could not pair with the
+    // pixel shader we provide. Try to salvage the situation
+    // using PBS shader. Custom deformation won't work but
+    // if we're lucky that won't matter
+    _subItem->setDatablock(_defaultPbs);
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2ThermalCameraMaterialSwitcher::cameraPreRenderScene(
+    Ogre::Camera * /*_cam*/)
+{
+  auto engine = Ogre2RenderEngine::Instance();
+  engine->SetGzOgreRenderingMode(GORM_SOLID_THERMAL_COLOR_TEXTURED);
+
+  this->UpdateItemStates();
+
+  // swap item to use v1 shader material
+  // Note: keep an eye out for performance impact on switching materials
+  // on the fly. We are not doing this often so should be ok.
+  this->itemDatablockMap.clear();
+  this->materialMap.clear();
+  Ogre::HlmsManager *hlmsManager = engine->OgreRoot()->getHlmsManager();
+
+  Ogre::HlmsDatablock *defaultPbs =
+    hlmsManager->getHlms(Ogre::HLMS_PBS)->getDefaultDatablock();
+
+  // Construct one now so that datablock->setBlendblock
+  // each is as fast as possible
+  const Ogre::HlmsBlendblock *noBlend =
+    hlmsManager->getBlendblock(Ogre::HlmsBlendblock());
+
+  for (auto &[id, state] : this->itemStates)
+  {
+    Ogre::Item *item = state.item;
+    const size_t numSubItems = item->getNumSubItems();
+    if (state.type == ItemType::TEMPERATURE)
+    {
+      for (size_t i = 0; i < numSubItems; ++i)
+      {
+        Ogre::SubItem *subItem = item->getSubItem(i);
+
+        // set g, b, a to 0. This will be used by shaders to determine
+        // if particular fragment is a heat source or not
+        // see media/materials/programs/GLSL/thermal_camera_fs.glsl
+        subItem->setCustomParameter(1, Ogre::Vector4(state.color, 0, 0, 0.0));
+
+        if (!subItem->getMaterial().isNull())
+        {
+          this->SwitchToSolidMaterial(subItem, state.subItems[i], defaultPbs);
+        }
+        else
+        {
+          Ogre::HlmsDatablock *datablock = subItem->getDatablock();
+          const Ogre::HlmsBlendblock *blendblock = datablock->getBlendblock();
+
+          // We can't do any sort of blending. This isn't colour what we're
+          // storing, but rather an ID.
+          if (blendblock->mSourceBlendFactor != Ogre::SBF_ONE ||
+              blendblock->mDestBlendFactor != Ogre::SBF_ZERO ||
+              blendblock->mBlendOperation != Ogre::SBO_ADD ||
+              (blendblock->mSeparateBlend &&
+               (blendblock->mSourceBlendFactorAlpha != Ogre::SBF_ONE ||
+                blendblock->mDestBlendFactorAlpha != Ogre::SBF_ZERO ||
+                blendblock->mBlendOperationAlpha != Ogre::SBO_ADD)))
+          {
+            hlmsManager->addReference(blendblock);
+            this->datablockMap[datablock] = blendblock;
+            datablock->setBlendblock(noBlend);
+          }
+        }
+      }
+    }
+    else if (state.type == ItemType::HEAT_SIGNATURE)
+    {
+      const Ogre::MaterialPtr &heatSignatureMaterial =
+          this->heatSignatureMaterials[id];
+      for (size_t i = 0; i < numSubItems; ++i)
+      {
+        Ogre::SubItem *subItem = item->getSubItem(i);
+
+        if (!subItem->getMaterial().isNull())
+        {
+          // TODO(anyone): We need to keep the material's vertex shader
+          // to keep vertex deformation consistent. See
+          // https://github.com/gazebosim/gz-rendering/issues/544
+          this->materialMap.push_back({ subItem, subItem->getMaterial() });
+        }
+        else
+        {
+          // TODO(anyone): We're not using Hlms pieces, therefore HW
+          // vertex deformation (e.g. skinning / skeletal animation) won't
+          // show up correctly
+          Ogre::HlmsDatablock *datablock = subItem->getDatablock();
+          this->itemDatablockMap.push_back({ subItem, datablock });
+        }
+
+        subItem->setMaterial(heatSignatureMaterial);
+      }
+    }
+    else
+    {
+      // Temperature object not set
+      // We consider this a "background object".
+      //
+      // It will be set to ambient temperature in thermal_camera_fs.glsl
+      // but its unlit, textured RGB color actually matters.
+      //
+      // We will be converting rgb values to temperature values in shaders
+      // thus we want them textured but without lighting
+      for (size_t i = 0; i < numSubItems; ++i)
       {
-        // Temperature object not set
-        // We consider this a "background object".
-
-        // TODO(anyone): Retrieve datablock and get diffuse color
-        // (it's likely gonna be 1 1 1 1 anyway... Does it matter?).
-        heightmap->Terra()->SetSolidColor(1u,
-                                          Ogre::Vector4(1.0, 1.0, 1.0, 1.0));
-        // TODO(anyone): Retrieve datablock and make sure it's not blending
-        // like we do with Items (it should be impossible?)
+        Ogre::SubItem *subItem = item->getSubItem(i);
+
+        const Ogre::HlmsDatablock *datablock = subItem->getDatablock();
+        const Ogre::ColourValue color = datablock->getDiffuseColour();
+        subItem->setCustomParameter(
+          1u, Ogre::Vector4(color.r, color.g, color.b, 1.0));
+
+        // Set 2 to signal we want it to multiply against
+        // the diffuse texture (if any). The actual value doesn't matter.
+        subItem->setCustomParameter(2u, Ogre::Vector4::ZERO);
+
+        // We don't save datablocks to this->datablockMap because we're
+        // already honouring the original HlmsBlendblock. There's nothing
+        // to override.
+        if (!subItem->getMaterial().isNull())
+          this->SwitchToSolidMaterial(subItem, state.subItems[i], defaultPbs);
       }
     }
   }
 
+  // Do the same with heightmaps / terrain
+  auto heightmaps = this->scene->Heightmaps();
+  for (size_t i = 0; i < heightmaps.size(); ++i)
+  {
+    auto heightmap = heightmaps[i].lock();
+    if (heightmap)
+    {
+      // TODO(anyone): Retrieve datablock and make sure it's not blending
+      // like we do with Items (it should be impossible?)
+      heightmap->Terra()->SetSolidColor(1u, this->heightmapParameters[i]);
+    }
+  }
+
   // Remove the reference count on noBlend we created
   hlmsManager->destroyBlendblock(noBlend);
 }
@@ -651,12 +758,9 @@ void Ogre2ThermalCameraMaterialSwitcher::cameraPostRenderScene(
   //
   // This consumes more performance but it's the price to pay for
   // safety.
-  auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
-      Ogre::ItemFactory::FACTORY_TYPE_NAME);
-  while (itor.hasMoreElements())
+  for (auto &[id, state] : this->itemStates)
   {
-    Ogre::MovableObject *object = itor.peekNext();
-    Ogre::Item *item = static_cast<Ogre::Item *>(object);
+    Ogre::Item *item = state.item;
     const size_t numSubItems = item->getNumSubItems();
     for (size_t i = 0; i < numSubItems; ++i)
     {
@@ -664,7 +768,6 @@ void Ogre2ThermalCameraMaterialSwitcher::cameraPostRenderScene(
       subItem->removeCustomParameter(1u);
       subItem->removeCustomParameter(2u);
     }
-    itor.moveNext();
   }
 
   // Restore Items with low level materials
@@ -1144,15 +1247,14 @@ void Ogre2ThermalCamera::PostRender()
   unsigned int channelCount = PixelUtil::ChannelCount(format);
   unsigned int bytesPerChannel = PixelUtil::BytesPerChannel(format);
 
-  Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->ogreThermalTexture, 0u, 0u);
-
   if (!this->dataPtr->thermalImage)
   {
     this->dataPtr->thermalImage = new uint16_t[len];
   }
 
-  Ogre::TextureBox box = image.getData(0u);
+  // read straight from the mapped staging memory
+  Ogre::TextureBox box =
+      this->dataPtr->readback.Map(this->dataPtr->ogreThermalTexture);
   if (format == PF_L8)
   {
     uint8_t *thermalBuffer = static_cast<uint8_t*>(box.data);
@@ -1171,18 +1273,11 @@ void Ogre2ThermalCamera::PostRender()
   else
   {
     // fill thermal data
-    // copy data row by row. The texture box may not be a contiguous region of
-    // a texture
-    uint16_t * thermalBuffer = static_cast<uint16_t *>(box.data);
-    for (unsigned int i = 0; i < height; ++i)
-    {
-      unsigned int rawDataRowIdx = i * box.bytesPerRow / bytesPerChannel;
-      unsigned int rowIdx = i * width * channelCount;
-      memcpy(&this->dataPtr->thermalImage[rowIdx],
-          &thermalBuffer[rawDataRowIdx],
-          width * channelCount * bytesPerChannel);
-    }
+    Ogre2TextureReadback::CopyRows(box,
+        width * channelCount * bytesPerChannel, height,
+        this->dataPtr->thermalImage);
   }
+  this->dataPtr->readback.Unmap();
 
   this->dataPtr->newThermalFrame(
       this->dataPtr->thermalImage, width, height, 1,
@@ -21,6 +21,7 @@
 #include "gz/rendering/ogre2/Ogre2Geometry.hh"
 #include "gz/rendering/ogre2/Ogre2ParticleEmitter.hh"
 #include "gz/rendering/ogre2/Ogre2RenderTypes.hh"
+#include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2Storage.hh"
 #include "gz/rendering/ogre2/Ogre2Visual.hh"
 #include "gz/rendering/Utils.hh"
@@ -169,6 +170,7 @@ bool Ogre2Visual::AttachGeometry(GeometryPtr _geometry)
 
   derived->SetParent(this->SharedThis());
   this->ogreNode->attachObject(ogreObj);
+  this->scene->SetSensorStateDirty();
 
   return true;
 }
@@ -196,6 +198,7 @@ bool Ogre2Visual::DetachGeometry(GeometryPtr _geometry)
   if (nullptr != derived->OgreObject())
     this->ogreNode->detachObject(derived->OgreObject());
   derived->SetParent(nullptr);
+  this->scene->SetSensorStateDirty();
   return true;
 }
 
@@ -15,6 +15,8 @@
  *
  */
 
+#include <gz/common/Console.hh>
+
 #include "gz/rendering/Camera.hh"
 
 namespace gz::rendering
@@ -22,4 +24,22 @@ namespace gz::rendering
 
 Camera::~Camera() = default;
 
+//////////////////////////////////////////////////
+std::vector<VisualAreaResult> Camera::VisualsInRectangle(
+    const gz::math::Vector2i &/*_min*/, const gz::math::Vector2i &/*_max*/)
+{
+  gzerr << "VisualsInRectangle not implemented for the render engine"
+        << std::endl;
+  return std::vector<VisualAreaResult>();
+}
+
+//////////////////////////////////////////////////
+std::vector<VisualAreaResult> Camera::VisualsInPolygon(
+    const std::vector<gz::math::Vector2i> &/*_polygon*/)
+{
+  gzerr << "VisualsInPolygon not implemented for the render engine"
+        << std::endl;
+  return std::vector<VisualAreaResult>();
+}
+
 }  // namespace gz::rendering
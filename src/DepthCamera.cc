@@ -22,4 +22,16 @@ namespace gz::rendering
 
 DepthCamera::~DepthCamera() = default;
 
+//////////////////////////////////////////////////
+void DepthCamera::SetReadbackLatency(unsigned int /*_frames*/)
+{
+  // no op, data is always read back synchronously
+}
+
+//////////////////////////////////////////////////
+unsigned int DepthCamera::ReadbackLatency() const
+{
+  return 0u;
+}
+
 }  // namespace gz::rendering
@@ -15,6 +15,8 @@
  *
  */
 
+#include <gz/common/Console.hh>
+
 #include "gz/rendering/GpuRays.hh"
 
 namespace gz::rendering
@@ -22,4 +24,27 @@ namespace gz::rendering
 
 GpuRays::~GpuRays() = default;
 
+//////////////////////////////////////////////////
+void GpuRays::SetOutputBuffer(float * /*_buffer*/)
+{
+  gzerr << "SetOutputBuffer is not supported by current render engine"
+        << std::endl;
+}
+
+//////////////////////////////////////////////////
+float *GpuRays::OutputBuffer() const
+{
+  return nullptr;
+}
+
+//////////////////////////////////////////////////
+void GpuRays::SetChannels(unsigned int _channels)
+{
+  if (_channels == this->Channels())
+    return;
+
+  gzerr << "Changing the number of gpu rays channels is not supported "
+        << "by current render engine" << std::endl;
+}
+
 }  // namespace gz::rendering
@@ -40,6 +40,21 @@ Image::Image(unsigned int _width, unsigned int _height,
   this->data = DataPtr(new unsigned char[size], ArrayDeleter<unsigned char>());
 }
 
+//////////////////////////////////////////////////
+Image::Image(unsigned int _width, unsigned int _height,
+  PixelFormat _format, void *_data, std::function<void(void *)> _release) :
+  width(_width),
+  height(_height)
+{
+  this->format = PixelUtil::Sanitize(_format);
+  this->data = DataPtr(static_cast<unsigned char *>(_data),
+      [_release](unsigned char *_p)
+      {
+        if (_release)
+          _release(_p);
+      });
+}
+
 //////////////////////////////////////////////////
 Image::~Image() = default;
 
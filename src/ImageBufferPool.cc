@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "gz/rendering/ImageBufferPool.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Private implementation of the ImageBufferPool class
+class gz::rendering::ImageBufferPoolPrivate
+{
+  /// \brief Width, height and format of the images a buffer is used for
+  public: using Key = std::tuple<unsigned int, unsigned int, PixelFormat>;
+
+  /// \brief Destructor
+  public: ~ImageBufferPoolPrivate();
+
+  /// \brief Return a buffer to the pool, or delete it if the pool is full
+  /// \param[in] _key Image width, height and format of the buffer
+  /// \param[in] _buffer Buffer to return
+  public: void Release(const Key &_key, unsigned char *_buffer);
+
+  /// \brief Delete all free buffers
+  public: void Clear();
+
+  /// \brief Protects the members below
+  public: mutable std::mutex mutex;
+
+  /// \brief Max number of free buffers kept per key
+  public: std::size_t capacity = 0u;
+
+  /// \brief Free buffers per key
+  public: std::map<Key, std::vector<unsigned char *>> freeBuffers;
+};
+
+//////////////////////////////////////////////////
+ImageBufferPoolPrivate::~ImageBufferPoolPrivate()
+{
+  this->Clear();
+}
+
+//////////////////////////////////////////////////
+void ImageBufferPoolPrivate::Release(const Key &_key, unsigned char *_buffer)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto &buffers = this->freeBuffers[_key];
+    if (buffers.size() < this->capacity)
+    {
+      buffers.push_back(_buffer);
+      return;
+    }
+  }
+  delete [] _buffer;
+}
+
+//////////////////////////////////////////////////
+void ImageBufferPoolPrivate::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (auto &buffers : this->freeBuffers)
+  {
+    for (auto buffer : buffers.second)
+      delete [] buffer;
+  }
+  this->freeBuffers.clear();
+}
+
+//////////////////////////////////////////////////
+// ImageBufferPool
+//////////////////////////////////////////////////
+ImageBufferPool::ImageBufferPool() :
+  dataPtr(std::make_shared<ImageBufferPoolPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+ImageBufferPool::~ImageBufferPool() = default;
+
+//////////////////////////////////////////////////
+void ImageBufferPool::SetCapacity(std::size_t _capacity)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->capacity = _capacity;
+  for (auto &buffers : this->dataPtr->freeBuffers)
+  {
+    while (buffers.second.size() > _capacity)
+    {
+      delete [] buffers.second.back();
+      buffers.second.pop_back();
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+std::size_t ImageBufferPool::Capacity() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->capacity;
+}
+
+//////////////////////////////////////////////////
+Image ImageBufferPool::Acquire(unsigned int _width, unsigned int _height,
+    PixelFormat _format)
+{
+  PixelFormat format = PixelUtil::Sanitize(_format);
+  ImageBufferPoolPrivate::Key key(_width, _height, format);
+
+  unsigned char *buffer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->capacity == 0u)
+      return Image(_width, _height, format);
+
+    auto it = this->dataPtr->freeBuffers.find(key);
+    if (it != this->dataPtr->freeBuffers.end() && !it->second.empty())
+    {
+      buffer = it->second.back();
+      it->second.pop_back();
+    }
+  }
+
+  if (!buffer)
+  {
+    buffer =
+        new unsigned char[PixelUtil::MemorySize(format, _width, _height)];
+  }
+
+  // return the buffer to the pool if it still exists, delete it otherwise
+  std::weak_ptr<ImageBufferPoolPrivate> pool = this->dataPtr;
+  return Image(_width, _height, format, buffer,
+      [pool, key](void *_buffer)
+      {
+        auto data = static_cast<unsigned char *>(_buffer);
+        if (auto p = pool.lock())
+          p->Release(key, data);
+        else
+          delete [] data;
+      });
+}
+
+//////////////////////////////////////////////////
+std::size_t ImageBufferPool::FreeCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::size_t count = 0u;
+  for (const auto &buffers : this->dataPtr->freeBuffers)
+    count += buffers.second.size();
+  return count;
+}
+
+//////////////////////////////////////////////////
+void ImageBufferPool::Clear()
+{
+  this->dataPtr->Clear();
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "gz/rendering/Image.hh"
+#include "gz/rendering/ImageBufferPool.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/////////////////////////////////////////////////
+TEST(ImageBufferPoolTest, ExternalMemory)
+{
+  std::vector<unsigned char> memory(PixelUtil::MemorySize(PF_R8G8B8, 4, 2));
+
+  // caller keeps ownership
+  {
+    Image image(4, 2, PF_R8G8B8, memory.data());
+    EXPECT_EQ(4u, image.Width());
+    EXPECT_EQ(2u, image.Height());
+    EXPECT_EQ(PF_R8G8B8, image.Format());
+    EXPECT_EQ(memory.size(), image.MemorySize());
+    EXPECT_EQ(memory.data(), image.Data());
+    image.Data<unsigned char>()[5] = 42u;
+  }
+  EXPECT_EQ(42u, memory[5]);
+
+  // release is called once the last copy is destroyed
+  int released = 0;
+  {
+    Image image(4, 2, PF_R8G8B8, memory.data(),
+        [&](void *_data)
+        {
+          EXPECT_EQ(memory.data(), _data);
+          ++released;
+        });
+    Image copy = image;
+    image = Image();
+    EXPECT_EQ(0, released);
+    EXPECT_EQ(memory.data(), copy.Data());
+  }
+  EXPECT_EQ(1, released);
+}
+
+/////////////////////////////////////////////////
+TEST(ImageBufferPoolTest, Pool)
+{
+  ImageBufferPool pool;
+
+  // disabled by default
+  EXPECT_EQ(0u, pool.Capacity());
+  {
+    Image image = pool.Acquire(8, 4, PF_L8);
+    EXPECT_EQ(8u, image.Width());
+    EXPECT_EQ(4u, image.Height());
+    EXPECT_EQ(PF_L8, image.Format());
+    EXPECT_NE(nullptr, image.Data());
+  }
+  EXPECT_EQ(0u, pool.FreeCount());
+
+  // buffers are reused once released
+  pool.SetCapacity(2u);
+  EXPECT_EQ(2u, pool.Capacity());
+  const void *data = nullptr;
+  {
+    Image image = pool.Acquire(8, 4, PF_L8);
+    data = image.Data();
+    EXPECT_EQ(0u, pool.FreeCount());
+  }
+  EXPECT_EQ(1u, pool.FreeCount());
+  {
+    Image image = pool.Acquire(8, 4, PF_L8);
+    EXPECT_EQ(data, image.Data());
+    EXPECT_EQ(0u, pool.FreeCount());
+
+    // other sizes and formats get their own buffers
+    Image other = pool.Acquire(8, 4, PF_R8G8B8);
+    EXPECT_NE(data, other.Data());
+    EXPECT_EQ(96u, other.MemorySize());
+  }
+  EXPECT_EQ(2u, pool.FreeCount());
+
+  // no more than capacity free buffers are kept per key
+  {
+    std::vector<Image> images;
+    for (unsigned int i = 0; i < 4u; ++i)
+      images.push_back(pool.Acquire(8, 4, PF_L8));
+  }
+  EXPECT_EQ(3u, pool.FreeCount());
+
+  pool.SetCapacity(1u);
+  EXPECT_EQ(2u, pool.FreeCount());
+  pool.Clear();
+  EXPECT_EQ(0u, pool.FreeCount());
+
+  // images may outlive the pool
+  std::unique_ptr<ImageBufferPool> tmpPool(new ImageBufferPool);
+  tmpPool->SetCapacity(1u);
+  Image image = tmpPool->Acquire(8, 4, PF_L8);
+  tmpPool.reset();
+  image.Data<unsigned char>()[0] = 1u;
+  image = Image();
+}
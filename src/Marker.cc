@@ -16,6 +16,8 @@
  */
 
 
+#include <gz/common/Console.hh>
+
 #include "gz/rendering/Marker.hh"
 
 using namespace gz;
@@ -26,3 +28,36 @@ Marker::Marker() = default;
 
 //////////////////////////////////////////////////
 Marker::~Marker() = default;
+
+//////////////////////////////////////////////////
+void Marker::SetPoints(const float *_xyz, const float *_rgba,
+    std::size_t _count, bool /*_borrow*/)
+{
+  this->ClearPoints();
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const float *p = _xyz + i * 3;
+    math::Color color = math::Color::White;
+    if (_rgba)
+    {
+      const float *c = _rgba + i * 4;
+      color.Set(c[0], c[1], c[2], c[3]);
+    }
+    this->AddPoint(math::Vector3d(p[0], p[1], p[2]), color);
+  }
+}
+
+//////////////////////////////////////////////////
+void Marker::SetPoints(std::vector<float> &&_xyz, std::vector<float> &&_rgba)
+{
+  if (_xyz.size() % 3 != 0 ||
+      (!_rgba.empty() && _rgba.size() != _xyz.size() / 3 * 4))
+  {
+    gzerr << "Point array sizes do not match. Expected 3 floats per "
+          << "position and 4 floats per color, got [" << _xyz.size()
+          << "] and [" << _rgba.size() << "]" << std::endl;
+    return;
+  }
+  this->SetPoints(_xyz.data(), _rgba.empty() ? nullptr : _rgba.data(),
+      _xyz.size() / 3);
+}
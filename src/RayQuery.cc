@@ -15,6 +15,8 @@
  *
  */
 
+#include <gz/common/Console.hh>
+
 #include "gz/rendering/RayQuery.hh"
 
 namespace gz::rendering
@@ -22,4 +24,35 @@ namespace gz::rendering
 
 RayQuery::~RayQuery() = default;
 
+//////////////////////////////////////////////////
+std::vector<RayQueryResult> RayQuery::ClosestPoints(
+    const std::vector<math::Vector3d> &_origins,
+    const std::vector<math::Vector3d> &_directions,
+    bool _forceSceneUpdate)
+{
+  std::vector<RayQueryResult> results;
+  if (_origins.size() != _directions.size())
+  {
+    gzerr << "Number of ray origins [" << _origins.size()
+          << "] does not match number of ray directions ["
+          << _directions.size() << "]" << std::endl;
+    return results;
+  }
+
+  // fall back to one query per ray, only updating the scene for the first
+  // one
+  const math::Vector3d prevOrigin = this->Origin();
+  const math::Vector3d prevDirection = this->Direction();
+  results.reserve(_origins.size());
+  for (std::size_t i = 0; i < _origins.size(); ++i)
+  {
+    this->SetOrigin(_origins[i]);
+    this->SetDirection(_directions[i]);
+    results.push_back(this->ClosestPoint(_forceSceneUpdate && i == 0u));
+  }
+  this->SetOrigin(prevOrigin);
+  this->SetDirection(prevDirection);
+  return results;
+}
+
 }  // namespace gz::rendering
@@ -22,4 +22,10 @@ namespace gz::rendering
 
 RenderEngine::~RenderEngine() = default;
 
+//////////////////////////////////////////////////
+ImageBufferPoolPtr RenderEngine::ImageBufferPool() const
+{
+  return ImageBufferPoolPtr();
+}
+
 }  // namespace gz::rendering
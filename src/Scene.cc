@@ -15,6 +15,10 @@
  *
  */
 
+#include <gz/common/Console.hh>
+
+#include "gz/rendering/Camera.hh"
+#include "gz/rendering/Node.hh"
 #include "gz/rendering/Scene.hh"
 
 using namespace gz;
@@ -41,3 +45,77 @@ void Scene::SetExtension(SceneExt *_ext)
 {
   g_sceneExtMap[this] = _ext;
 }
+
+//////////////////////////////////////////////////
+std::size_t Scene::NodeWorldPoses(const std::vector<unsigned int> &_ids,
+    std::vector<math::Pose3d> &_poses) const
+{
+  _poses.resize(_ids.size());
+  std::size_t found = 0u;
+  for (std::size_t i = 0; i < _ids.size(); ++i)
+  {
+    NodePtr node = this->NodeById(_ids[i]);
+    if (node)
+    {
+      _poses[i] = node->WorldPose();
+      ++found;
+    }
+    else
+    {
+      _poses[i] = math::Pose3d::Zero;
+    }
+  }
+  return found;
+}
+
+//////////////////////////////////////////////////
+std::size_t Scene::SetNodeLocalPoses(const unsigned int *_ids,
+    const math::Pose3d *_poses, std::size_t _count, bool /*_parallel*/)
+{
+  std::size_t updated = 0u;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    NodePtr node = this->NodeById(_ids[i]);
+    if (!node || !_poses[i].IsFinite())
+      continue;
+    node->SetLocalPose(_poses[i]);
+    ++updated;
+  }
+  return updated;
+}
+
+//////////////////////////////////////////////////
+std::size_t Scene::SetNodeWorldPoses(const unsigned int *_ids,
+    const math::Pose3d *_poses, std::size_t _count)
+{
+  std::size_t updated = 0u;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    NodePtr node = this->NodeById(_ids[i]);
+    if (!node || !_poses[i].IsFinite())
+      continue;
+    node->SetWorldPose(_poses[i]);
+    ++updated;
+  }
+  return updated;
+}
+
+//////////////////////////////////////////////////
+bool Scene::ScheduleSensor(CameraPtr /*_sensor*/, double /*_rate*/)
+{
+  gzerr << "ScheduleSensor is not supported by current render engine"
+        << std::endl;
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool Scene::UnscheduleSensor(CameraPtr /*_sensor*/)
+{
+  return false;
+}
+
+//////////////////////////////////////////////////
+unsigned int Scene::UpdateSensors()
+{
+  return 0u;
+}
@@ -15,11 +15,18 @@
  *
 */
 
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
 #ifdef __linux__
 #include <X11/Xlib.h>
 #include <X11/Xresource.h>
 #endif
 
+#include <gz/common/Console.hh>
+
 #include "gz/math/Plane.hh"
 #include "gz/math/Vector2.hh"
 #include "gz/math/Vector3.hh"
@@ -252,145 +259,138 @@ gz::math::AxisAlignedBox transformAxisAlignedBox(
   return gz::math::AxisAlignedBox(min, max);
 }
 
-/////////////////////////////////////////////////
-Image convertRGBToBayer(const Image &_image, PixelFormat _bayerFormat)
+/// \brief Min number of pixels converted to bayer by a worker thread.
+/// Smaller images are not worth the cost of starting threads.
+static const std::size_t kBayerPixelsPerThread = 1u << 18u;
+
+/// \brief Get the RGB channels sampled by a bayer pattern
+/// \param[in] _bayerFormat Bayer format
+/// \param[out] _channels Channels sampled at the even and odd columns of
+/// even rows, followed by the ones sampled at the even and odd columns of odd
+/// rows
+/// \return False if _bayerFormat is not a bayer format
+static bool bayerChannels(PixelFormat _bayerFormat, unsigned int _channels[4])
 {
-  const unsigned char *sourceImageData = _image.Data<unsigned char>();
-
-  unsigned int width = _image.Width();
-  unsigned int height = _image.Height();
-
-  Image destImage(width, height, _bayerFormat);
-  unsigned char *destImageData = destImage.Data<unsigned char>();
+  // \todo(anyone) the GBRG8 and GRBG8 patterns are swapped compared to their
+  // names. Kept as is for backward compatibility.
+  switch (_bayerFormat)
+  {
+    case PF_BAYER_RGGB8:
+      _channels[0] = 0u;
+      _channels[1] = 1u;
+      _channels[2] = 1u;
+      _channels[3] = 2u;
+      return true;
+    case PF_BAYER_BGGR8:
+      _channels[0] = 2u;
+      _channels[1] = 1u;
+      _channels[2] = 1u;
+      _channels[3] = 0u;
+      return true;
+    case PF_BAYER_GBRG8:
+      _channels[0] = 1u;
+      _channels[1] = 0u;
+      _channels[2] = 2u;
+      _channels[3] = 1u;
+      return true;
+    case PF_BAYER_GRBG8:
+      _channels[0] = 1u;
+      _channels[1] = 2u;
+      _channels[2] = 0u;
+      _channels[3] = 1u;
+      return true;
+    default:
+      return false;
+  }
+}
 
-  if (_bayerFormat == PF_BAYER_RGGB8)
+/// \brief Convert a range of rows of an RGB image to bayer
+/// \param[in] _rgb RGB image data
+/// \param[in] _width Image width
+/// \param[in] _rowBegin First row to convert
+/// \param[in] _rowEnd One past the last row to convert
+/// \param[in] _channels Channels sampled by the bayer pattern, see
+/// bayerChannels
+/// \param[out] _bayer Bayer image data. May be the same as _rgb.
+static void convertRGBToBayerRows(const unsigned char *_rgb,
+    unsigned int _width, unsigned int _rowBegin, unsigned int _rowEnd,
+    const unsigned int *_channels, unsigned char *_bayer)
+{
+  const unsigned int pairs = _width / 2u;
+  for (unsigned int j = _rowBegin; j < _rowEnd; ++j)
   {
-    for (unsigned int i=0; i < width; i++)
+    const unsigned char *src =
+        _rgb + static_cast<std::size_t>(j) * _width * 3u;
+    unsigned char *dst = _bayer + static_cast<std::size_t>(j) * _width;
+    const unsigned int even = _channels[(j % 2u) * 2u];
+    const unsigned int odd = _channels[(j % 2u) * 2u + 1u] + 3u;
+
+    // convert pixel pairs without branching so the loop can be vectorized.
+    // Every byte is read before it is overwritten, which makes in place
+    // conversion safe.
+    for (unsigned int i = 0; i < pairs; ++i)
     {
-      for (unsigned int j=0; j < height; j++)
-      {
-        if (j%2)
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+2];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-        }
-        else
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+0];
-          }
-        }
-      }
+      dst[2u * i] = src[6u * i + even];
+      dst[2u * i + 1u] = src[6u * i + odd];
     }
+    if (_width % 2u)
+      dst[_width - 1u] = src[3u * (_width - 1u) + even];
   }
+}
 
-  else if (_bayerFormat == PF_BAYER_BGGR8)
+/////////////////////////////////////////////////
+bool convertRGBToBayer(const unsigned char *_rgb, unsigned int _width,
+    unsigned int _height, PixelFormat _bayerFormat, unsigned char *_bayer)
+{
+  unsigned int channels[4];
+  if (!bayerChannels(_bayerFormat, channels))
   {
-    for (unsigned int i=0; i < width; i++)
-    {
-      for (unsigned int j=0; j < height; j++)
-      {
-        if (j%2)
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+0];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-        }
-        else
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+2];
-          }
-        }
-      }
-    }
+    gzerr << "Unable to convert RGB image to non bayer format ["
+          << PixelUtil::Name(_bayerFormat) << "]" << std::endl;
+    return false;
   }
 
-  else if (_bayerFormat == PF_BAYER_GBRG8)
+  if (!_rgb || !_bayer)
+    return false;
+
+  // in place conversion has to go row by row in order
+  const std::size_t pixelCount = static_cast<std::size_t>(_width) * _height;
+  unsigned int threadCount = 1u;
+  if (_rgb != _bayer)
   {
-    for (unsigned int i=0; i < width; i++)
-    {
-      for (unsigned int j=0; j < height; j++)
-      {
-        if (j%2)
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+2];
-          }
-        }
-        else
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+0];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-        }
-      }
-    }
+    threadCount = static_cast<unsigned int>(std::max<std::size_t>(1u,
+        std::min<std::size_t>(std::thread::hardware_concurrency(),
+        pixelCount / kBayerPixelsPerThread)));
   }
 
-  else if (_bayerFormat == PF_BAYER_GRBG8)
+  if (threadCount <= 1u)
   {
-    for (unsigned int i=0; i < width; i++)
-    {
-      for (unsigned int j=0; j < height; j++)
-      {
-        if (j%2)
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+0];
-          }
-        }
-        else
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+2];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-        }
-      }
-    }
+    convertRGBToBayerRows(_rgb, _width, 0u, _height, channels, _bayer);
+    return true;
   }
 
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount);
+  const unsigned int rowsPerThread =
+      (_height + threadCount - 1u) / threadCount;
+  for (unsigned int t = 0; t < threadCount; ++t)
+  {
+    const unsigned int rowBegin = std::min(_height, t * rowsPerThread);
+    const unsigned int rowEnd = std::min(_height, rowBegin + rowsPerThread);
+    threads.emplace_back(convertRGBToBayerRows, _rgb, _width, rowBegin,
+        rowEnd, channels, _bayer);
+  }
+  for (auto &thread : threads)
+    thread.join();
+  return true;
+}
+
+/////////////////////////////////////////////////
+Image convertRGBToBayer(const Image &_image, PixelFormat _bayerFormat)
+{
+  Image destImage(_image.Width(), _image.Height(), _bayerFormat);
+  convertRGBToBayer(_image.Data<unsigned char>(), _image.Width(),
+      _image.Height(), _bayerFormat, destImage.Data<unsigned char>());
   return destImage;
 }
 
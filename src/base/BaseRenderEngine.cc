@@ -15,23 +15,39 @@
  *
  */
 
+#include <mutex>
+#include <unordered_map>
+
 #include <gz/common/Console.hh>
 
+#include "gz/rendering/ImageBufferPool.hh"
 #include "gz/rendering/RenderPassSystem.hh"
 #include "gz/rendering/base/BaseRenderEngine.hh"
 
 using namespace gz;
 using namespace rendering;
 
+/// \brief Image buffer pool shared by the cameras of each render engine
+// added as static var here for ABI compatibility
+static std::unordered_map<const BaseRenderEngine *, ImageBufferPoolPtr>
+    g_imageBufferPoolMap;
+
+/// \brief Mutex protecting g_imageBufferPoolMap
+static std::mutex g_imageBufferPoolMutex;
+
 //////////////////////////////////////////////////
 BaseRenderEngine::BaseRenderEngine()
 {
   this->renderPassSystem.reset(new rendering::RenderPassSystem());
+  std::lock_guard<std::mutex> lock(g_imageBufferPoolMutex);
+  g_imageBufferPoolMap[this].reset(new rendering::ImageBufferPool());
 }
 
 //////////////////////////////////////////////////
 BaseRenderEngine::~BaseRenderEngine()
 {
+  std::lock_guard<std::mutex> lock(g_imageBufferPoolMutex);
+  g_imageBufferPoolMap.erase(this);
 }
 
 //////////////////////////////////////////////////
@@ -286,3 +302,13 @@ RenderPassSystemPtr BaseRenderEngine::RenderPassSystem() const
   }
   return this->renderPassSystem;
 }
+
+//////////////////////////////////////////////////
+ImageBufferPoolPtr BaseRenderEngine::ImageBufferPool() const
+{
+  std::lock_guard<std::mutex> lock(g_imageBufferPoolMutex);
+  auto it = g_imageBufferPoolMap.find(this);
+  if (it == g_imageBufferPoolMap.end())
+    return ImageBufferPoolPtr();
+  return it->second;
+}
@@ -15,7 +15,16 @@
  *
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
 
 #include <gz/math/Helpers.hh>
 
@@ -53,6 +62,61 @@
 using namespace gz;
 using namespace rendering;
 
+/// \brief Private data for the BaseScene class
+class BaseScenePrivate
+{
+  /// \brief A sensor added to the sensor scheduler
+  public: struct ScheduledSensor
+  {
+    /// \brief The sensor. Not owned, so destroyed sensors can be
+    /// dropped from the schedule.
+    std::weak_ptr<Camera> sensor;
+
+    /// \brief Time between updates. Zero to update on every call.
+    std::chrono::steady_clock::duration period;
+
+    /// \brief Scene time of the next update
+    std::chrono::steady_clock::duration nextUpdate;
+
+    /// \brief Name of the sensor type, used to group sensors of the
+    /// same type so they render back to back
+    std::string type;
+  };
+
+  /// \brief Ray query reused by VisualAt so picking, e.g. on every mouse
+  /// move, does not create a new query each time. Created on first use.
+  public: RayQueryPtr pickingQuery;
+
+  /// \brief Thread the picking query was created in. Ray queries choose
+  /// how to run based on the thread that created them, so the query is
+  /// recreated if VisualAt is called from another thread.
+  public: std::thread::id pickingQueryThreadId;
+
+  /// \brief Sensors added to the sensor scheduler, sorted by type
+  public: std::vector<ScheduledSensor> scheduledSensors;
+};
+
+/// \brief Private data of each scene
+// added as static var here for ABI compatibility
+static std::unordered_map<const BaseScene *,
+    std::unique_ptr<BaseScenePrivate>> g_baseScenePrivateMap;
+
+/// \brief Mutex protecting g_baseScenePrivateMap
+static std::mutex g_baseScenePrivateMutex;
+
+//////////////////////////////////////////////////
+/// \brief Get the private data of a scene, created on first use
+/// \param[in] _scene Scene to get the private data of
+/// \return Private data of _scene
+static BaseScenePrivate &ScenePrivate(const BaseScene *_scene)
+{
+  std::lock_guard<std::mutex> lock(g_baseScenePrivateMutex);
+  auto &data = g_baseScenePrivateMap[_scene];
+  if (!data)
+    data = std::make_unique<BaseScenePrivate>();
+  return *data;
+}
+
 //////////////////////////////////////////////////
 BaseScene::BaseScene(unsigned int _id, const std::string &_name) :
   id(_id),
@@ -67,6 +131,8 @@ BaseScene::BaseScene(unsigned int _id, const std::string &_name) :
 //////////////////////////////////////////////////
 BaseScene::~BaseScene()
 {
+  std::lock_guard<std::mutex> lock(g_baseScenePrivateMutex);
+  g_baseScenePrivateMap.erase(this);
 }
 
 //////////////////////////////////////////////////
@@ -142,7 +208,14 @@ VisualPtr BaseScene::VisualAt(const CameraPtr &_camera,
                               const math::Vector2i &_mousePos)
 {
   VisualPtr visual;
-  RayQueryPtr rayQuery = this->CreateRayQuery();
+  BaseScenePrivate &data = ScenePrivate(this);
+  if (!data.pickingQuery ||
+      data.pickingQueryThreadId != std::this_thread::get_id())
+  {
+    data.pickingQuery = this->CreateRayQuery();
+    data.pickingQueryThreadId = std::this_thread::get_id();
+  }
+  RayQueryPtr rayQuery = data.pickingQuery;
   if (!rayQuery)
     return visual;
 
@@ -1446,9 +1519,116 @@ bool BaseScene::LegacyAutoGpuFlush() const
   return true;
 }
 
+//////////////////////////////////////////////////
+bool BaseScene::ScheduleSensor(CameraPtr _sensor, double _rate)
+{
+  if (!_sensor || !this->HasSensor(_sensor))
+  {
+    gzerr << "Unable to schedule sensor. It does not belong to scene ["
+          << this->name << "]" << std::endl;
+    return false;
+  }
+
+  if (!std::isfinite(_rate) || _rate < 0.0)
+  {
+    gzerr << "Invalid update rate [" << _rate << "] for sensor ["
+          << _sensor->Name() << "]" << std::endl;
+    return false;
+  }
+
+  this->UnscheduleSensor(_sensor);
+
+  BaseScenePrivate::ScheduledSensor entry;
+  entry.sensor = _sensor;
+  entry.period = std::chrono::steady_clock::duration::zero();
+  if (_rate > 0.0)
+  {
+    entry.period =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / _rate));
+  }
+  entry.nextUpdate = this->time;
+  const Camera &sensor = *_sensor;
+  entry.type = typeid(sensor).name();
+
+  // keep sensors of the same type next to each other
+  auto &scheduledSensors = ScenePrivate(this).scheduledSensors;
+  auto it = std::upper_bound(scheduledSensors.begin(),
+      scheduledSensors.end(), entry.type,
+      [](const std::string &_type,
+         const BaseScenePrivate::ScheduledSensor &_scheduled)
+      {
+        return _type < _scheduled.type;
+      });
+  scheduledSensors.insert(it, entry);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool BaseScene::UnscheduleSensor(CameraPtr _sensor)
+{
+  auto &scheduledSensors = ScenePrivate(this).scheduledSensors;
+  auto it = std::find_if(scheduledSensors.begin(),
+      scheduledSensors.end(),
+      [&_sensor](const BaseScenePrivate::ScheduledSensor &_scheduled)
+      {
+        return _scheduled.sensor.lock() == _sensor;
+      });
+  if (it == scheduledSensors.end())
+    return false;
+
+  scheduledSensors.erase(it);
+  return true;
+}
+
+//////////////////////////////////////////////////
+unsigned int BaseScene::UpdateSensors()
+{
+  std::vector<CameraPtr> due;
+  auto &scheduledSensors = ScenePrivate(this).scheduledSensors;
+  for (auto it = scheduledSensors.begin();
+      it != scheduledSensors.end();)
+  {
+    CameraPtr sensor = it->sensor.lock();
+    if (!sensor || !this->HasSensor(sensor))
+    {
+      it = scheduledSensors.erase(it);
+      continue;
+    }
+
+    // the scene time went backwards, e.g. the simulation was reset
+    if (it->nextUpdate > this->time + it->period)
+      it->nextUpdate = this->time;
+
+    if (this->time >= it->nextUpdate)
+    {
+      due.push_back(sensor);
+      it->nextUpdate += it->period;
+      // skip the updates missed if the scene time jumped forward
+      if (it->nextUpdate <= this->time)
+        it->nextUpdate = this->time + it->period;
+    }
+    ++it;
+  }
+
+  if (due.empty())
+    return 0u;
+
+  this->PreRender();
+  for (auto &sensor : due)
+    sensor->Render();
+  for (auto &sensor : due)
+    sensor->PostRender();
+  if (!this->LegacyAutoGpuFlush())
+    this->PostRender();
+
+  return static_cast<unsigned int>(due.size());
+}
+
 //////////////////////////////////////////////////
 void BaseScene::Clear()
 {
+  ScenePrivate(this).scheduledSensors.clear();
   this->DestroyNodes();
   auto root = this->RootVisual();
   if (root)
@@ -1464,6 +1644,7 @@ void BaseScene::Clear()
 void BaseScene::Destroy()
 {
   // TODO(anyone): destroy context
+  ScenePrivate(this).pickingQuery.reset();
   this->Clear();
   this->loaded = false;
   this->initialized = false;
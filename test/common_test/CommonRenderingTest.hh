@@ -20,10 +20,13 @@
 
 #include <gtest/gtest.h>
 
+#include <map>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
 
 #include <gz/rendering/RenderingIface.hh>
 #include <gz/rendering/RenderEngine.hh>
@@ -118,6 +121,90 @@ class CommonRenderingTest: public testing::Test
   public: gz::rendering::RenderEngine *engine = nullptr;
 };
 
+/// \brief Test fixture for tests that load and unload the engine
+/// themselves, e.g. to pass extra engine parameters or to check what an
+/// engine leaves on disk for the next one
+class EngineReloadTest: public testing::Test
+{
+  /// \brief Set up the test case
+  public: void SetUp() override
+  {
+    gz::common::Console::SetVerbosity(4);
+
+    auto [envEngine, envBackend, envHeadless] = GetTestParams();
+
+    if (envEngine.empty())
+    {
+      GTEST_SKIP() << kEngineToTestEnv << " environment not set";
+    }
+
+    this->engineToTest = envEngine;
+    this->engineParams = GetEngineParams(envEngine, envBackend, envHeadless);
+  }
+
+  /// \brief Load the engine under test
+  /// \param[in] _params Engine parameters added to the ones of the test
+  /// environment
+  /// \return The engine or null if it could not be loaded
+  public: gz::rendering::RenderEngine *LoadEngine(
+              const std::map<std::string, std::string> &_params)
+  {
+    auto params = this->engineParams;
+    for (const auto &param : _params)
+      params[param.first] = param.second;
+    return gz::rendering::engine(this->engineToTest, params);
+  }
+
+  /// \brief Unload the engine under test
+  /// \return True if the engine was unloaded
+  public: bool UnloadEngine()
+  {
+    return gz::rendering::unloadEngine(this->engineToTest);
+  }
+
+  /// \brief Get the files in a directory with the given extension
+  /// \param[in] _path Directory
+  /// \param[in] _extension File extension, including the dot
+  /// \return Paths of the files
+  public: std::vector<std::string> Files(const std::string &_path,
+              const std::string &_extension) const
+  {
+    std::vector<std::string> files;
+    for (gz::common::DirIter it(_path); it != gz::common::DirIter(); ++it)
+    {
+      const std::string file = *it;
+      if (!gz::common::isDirectory(file) &&
+          file.size() > _extension.size() &&
+          file.compare(file.size() - _extension.size(), _extension.size(),
+              _extension) == 0)
+      {
+        files.push_back(file);
+      }
+    }
+    return files;
+  }
+
+  /// \brief Get the subdirectories of a directory
+  /// \param[in] _path Directory
+  /// \return Paths of the subdirectories
+  public: std::vector<std::string> Directories(const std::string &_path) const
+  {
+    std::vector<std::string> directories;
+    for (gz::common::DirIter it(_path); it != gz::common::DirIter(); ++it)
+    {
+      if (gz::common::isDirectory(*it))
+        directories.push_back(*it);
+    }
+    return directories;
+  }
+
+  /// \brief String name of the engine to test
+  public: std::string engineToTest;
+
+  /// \brief Parameters of the test environment for loading the engine
+  protected: std::map<std::string, std::string> engineParams;
+};
+
 
 /// \brief Check that the current engine being tested is supported.
 /// If the engine is not in the set of passed arguments, the test is skipped
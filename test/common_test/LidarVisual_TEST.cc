@@ -16,6 +16,10 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+
 #include "CommonRenderingTest.hh"
 
 #include "gz/rendering/LidarVisual.hh"
@@ -107,3 +111,48 @@ TEST_F(LidarVisualTest, LidarVisual)
   // Clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(LidarVisualTest, UpdateTypes)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  VisualPtr root = scene->RootVisual();
+
+  LidarVisualPtr lidar = scene->CreateLidarVisual();
+  ASSERT_NE(nullptr, lidar);
+  root->AddChild(lidar);
+
+  // two rings of three rays, all pointing along +X
+  lidar->SetMinHorizontalAngle(0.0);
+  lidar->SetMaxHorizontalAngle(0.0);
+  lidar->SetHorizontalRayCount(3);
+  lidar->SetMinVerticalAngle(0.0);
+  lidar->SetMaxVerticalAngle(0.0);
+  lidar->SetVerticalRayCount(2);
+  lidar->SetMinRange(0.1);
+  lidar->SetMaxRange(10.0);
+  std::vector<double> pts{1.0, 2.0, INFINITY, 3.0, INFINITY, 1.5};
+
+  for (auto type : {LVT_RAY_LINES, LVT_POINTS, LVT_TRIANGLE_STRIPS})
+  {
+    // non hitting rays extend to max range
+    lidar->SetType(type);
+    lidar->SetDisplayNonHitting(true);
+    lidar->SetPoints(pts);
+    lidar->Update();
+    math::AxisAlignedBox box = lidar->LocalBoundingBox();
+    EXPECT_NEAR(10.0, box.Max().X(), 1e-4) << type;
+
+    // only hitting rays
+    lidar->SetDisplayNonHitting(false);
+    lidar->SetPoints(pts);
+    lidar->Update();
+    box = lidar->LocalBoundingBox();
+    EXPECT_NEAR(3.0, box.Max().X(), 1e-4) << type;
+  }
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
@@ -16,10 +16,15 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+
 #include "CommonRenderingTest.hh"
 
 #include "gz/rendering/Marker.hh"
 #include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
 
 using namespace gz;
 using namespace rendering;
@@ -97,3 +102,127 @@ TEST_F(MarkerTest, Marker)
   // Clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(MarkerTest, PointUpdates)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+
+  VisualPtr visual = scene->CreateVisual();
+  scene->RootVisual()->AddChild(visual);
+
+  MarkerPtr marker = scene->CreateMarker();
+  ASSERT_NE(nullptr, marker);
+  marker->SetType(MarkerType::MT_LINE_LIST);
+  marker->AddPoint(math::Vector3d(0, 0, 0), math::Color::White);
+  marker->AddPoint(math::Vector3d(1, 2, 3), math::Color::White);
+  visual->AddGeometry(marker);
+
+  marker->PreRender();
+  math::AxisAlignedBox box = visual->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(0, 0, 0), box.Min());
+  EXPECT_EQ(math::Vector3d(1, 2, 3), box.Max());
+
+  // moving a point on the boundary shrinks the bounds
+  marker->SetPoint(1, math::Vector3d(0.5, 0.5, 0.5));
+  marker->PreRender();
+  box = visual->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(0, 0, 0), box.Min());
+  EXPECT_EQ(math::Vector3d(0.5, 0.5, 0.5), box.Max());
+
+  // append enough points to grow the vertex buffer
+  for (unsigned int i = 0; i < 30u; ++i)
+    marker->AddPoint(math::Vector3d(-1.0 * i, 0, 0), math::Color::White);
+  marker->PreRender();
+  box = visual->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(-29, 0, 0), box.Min());
+  EXPECT_EQ(math::Vector3d(0.5, 0.5, 0.5), box.Max());
+
+  // update a few frames in a row so every copy of the buffer is written
+  for (unsigned int i = 0; i < 4u; ++i)
+  {
+    marker->SetPoint(2, math::Vector3d(0, 0, 1.0 + i));
+    marker->PreRender();
+  }
+  box = visual->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(-29, 0, 0), box.Min());
+  EXPECT_EQ(math::Vector3d(0.5, 0.5, 4), box.Max());
+
+  marker->ClearPoints();
+  marker->AddPoint(math::Vector3d(2, 2, 2), math::Color::White);
+  marker->AddPoint(math::Vector3d(3, 3, 3), math::Color::White);
+  marker->PreRender();
+  box = visual->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(2, 2, 2), box.Min());
+  EXPECT_EQ(math::Vector3d(3, 3, 3), box.Max());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MarkerTest, BulkPoints)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+
+  VisualPtr visual = scene->CreateVisual();
+  scene->RootVisual()->AddChild(visual);
+
+  MarkerPtr marker = scene->CreateMarker();
+  ASSERT_NE(nullptr, marker);
+  marker->SetType(MarkerType::MT_POINTS);
+  visual->AddGeometry(marker);
+
+  // copied
+  std::vector<float> xyz = {0, 0, 0, 1, 2, 3, -1, 0, 0};
+  std::vector<float> rgba = {1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 1, 1};
+  marker->SetPoints(xyz.data(), rgba.data(), 3u);
+  marker->PreRender();
+  math::AxisAlignedBox box = visual->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(-1, 0, 0), box.Min());
+  EXPECT_EQ(math::Vector3d(1, 2, 3), box.Max());
+
+  // borrowed, read on render
+  std::vector<float> borrowed = {0, 0, 0, 5, 5, 5};
+  marker->SetPoints(borrowed.data(), nullptr, 2u, true);
+  borrowed[3] = 4.0f;
+  marker->PreRender();
+  box = visual->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(0, 0, 0), box.Min());
+  EXPECT_EQ(math::Vector3d(4, 5, 5), box.Max());
+
+  // moved
+  marker->SetPoints(std::vector<float>{-2, -2, -2, 0, 0, 1},
+      std::vector<float>());
+  marker->PreRender();
+  box = visual->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(-2, -2, -2), box.Min());
+  EXPECT_EQ(math::Vector3d(0, 0, 1), box.Max());
+
+  // single point updates still work after a bulk update
+  marker->SetPoint(1, math::Vector3d(3, 3, 3));
+  marker->PreRender();
+  box = visual->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(-2, -2, -2), box.Min());
+  EXPECT_EQ(math::Vector3d(3, 3, 3), box.Max());
+
+  // mismatched sizes are rejected
+  marker->SetPoints(std::vector<float>{1, 1}, std::vector<float>());
+  marker->PreRender();
+  box = visual->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(3, 3, 3), box.Max());
+
+  // including color arrays that are not a multiple of 4 floats
+  marker->SetPoints(std::vector<float>{4, 4, 4, 6, 6, 6},
+      std::vector<float>{1, 0, 0, 1, 0, 1, 0, 1, 1});
+  marker->PreRender();
+  box = visual->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(3, 3, 3), box.Max());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
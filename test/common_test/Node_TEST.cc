@@ -107,3 +107,59 @@ TEST_F(NodeTest, Pose)
   // Clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(NodeTest, WorldPoseUpdates)
+{
+  ScenePtr scene = engine->CreateScene("scene");
+
+  VisualPtr parent = scene->CreateVisual();
+  VisualPtr child = scene->CreateVisual();
+  VisualPtr grandChild = scene->CreateVisual();
+  ASSERT_NE(nullptr, parent);
+  ASSERT_NE(nullptr, child);
+  ASSERT_NE(nullptr, grandChild);
+  parent->AddChild(child);
+  child->AddChild(grandChild);
+
+  child->SetLocalPosition(1, 0, 0);
+  grandChild->SetLocalPosition(0, 1, 0);
+  EXPECT_EQ(math::Vector3d(1, 1, 0), grandChild->WorldPosition());
+  EXPECT_EQ(math::Vector3d::One, grandChild->WorldScale());
+
+  // world poses of descendants follow changes to the parent
+  parent->SetLocalPosition(0, 0, 2);
+  EXPECT_EQ(math::Vector3d(1, 1, 2), grandChild->WorldPosition());
+  EXPECT_EQ(math::Vector3d(1, 0, 2), child->WorldPosition());
+
+  parent->SetLocalRotation(0, 0, GZ_PI);
+  EXPECT_EQ(math::Vector3d(-1, -1, 2), grandChild->WorldPosition());
+
+  parent->SetLocalPose(math::Pose3d(0, 0, 3, 0, 0, 0));
+  EXPECT_EQ(math::Vector3d(1, 1, 3), grandChild->WorldPosition());
+
+  // and changes to the scale
+  parent->SetLocalScale(2, 3, 4);
+  EXPECT_EQ(math::Vector3d(2, 3, 4), grandChild->WorldScale());
+  child->SetInheritScale(false);
+  EXPECT_EQ(math::Vector3d::One, grandChild->WorldScale());
+  child->SetInheritScale(true);
+  EXPECT_EQ(math::Vector3d(2, 3, 4), grandChild->WorldScale());
+  parent->SetLocalScale(1, 1, 1);
+  EXPECT_EQ(math::Vector3d::One, grandChild->WorldScale());
+
+  // and to the parent
+  parent->RemoveChild(child);
+  VisualPtr newParent = scene->CreateVisual();
+  newParent->SetLocalPosition(0, 0, -1);
+  newParent->SetLocalScale(2, 2, 2);
+  newParent->AddChild(child);
+  EXPECT_EQ(math::Vector3d(1, 1, -1), grandChild->WorldPosition());
+  EXPECT_EQ(math::Vector3d(2, 2, 2), grandChild->WorldScale());
+
+  // world pose of an unchanged node stays the same
+  EXPECT_EQ(math::Pose3d(0, 0, 3, 0, 0, 0), parent->WorldPose());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
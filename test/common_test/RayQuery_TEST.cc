@@ -17,11 +17,14 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "CommonRenderingTest.hh"
 
 #include "gz/rendering/Camera.hh"
 #include "gz/rendering/RayQuery.hh"
 #include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
 
 using namespace gz;
 using namespace rendering;
@@ -111,3 +114,157 @@ TEST_F(RayQueryTest, RayQuery)
   // Clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(RayQueryTest, ClosestPoints)
+{
+  CHECK_UNSUPPORTED_ENGINE("optix");
+
+  ScenePtr scene = engine->CreateScene("scene");
+
+  VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(5.0, 0.0, 0.0);
+  scene->RootVisual()->AddChild(box);
+
+  RayQueryPtr rayQuery = scene->CreateRayQuery();
+  ASSERT_NE(nullptr, rayQuery);
+
+  math::Vector3d origin(0.0, 0.0, 0.5);
+  math::Vector3d direction = -math::Vector3d::UnitZ;
+  rayQuery->SetOrigin(origin);
+  rayQuery->SetDirection(direction);
+
+  // mismatched input
+  std::vector<math::Vector3d> origins(2u, math::Vector3d::Zero);
+  std::vector<math::Vector3d> directions{math::Vector3d::UnitX};
+  EXPECT_TRUE(rayQuery->ClosestPoints(origins, directions).empty());
+
+  // one ray towards the box and one ray away from it
+  directions = {math::Vector3d::UnitX, math::Vector3d::UnitY};
+  std::vector<RayQueryResult> results =
+      rayQuery->ClosestPoints(origins, directions);
+  ASSERT_EQ(2u, results.size());
+
+  // the state of the ray query is not modified
+  EXPECT_EQ(origin, rayQuery->Origin());
+  EXPECT_EQ(direction, rayQuery->Direction());
+
+  if (engine->Name() == "ogre2")
+  {
+    EXPECT_TRUE(results[0]);
+    EXPECT_NEAR(4.5, results[0].distance, 1e-4);
+    EXPECT_EQ(math::Vector3d(4.5, 0.0, 0.0), results[0].point);
+    EXPECT_EQ(box->Id(), results[0].objectId);
+
+    // batched results match single ray queries
+    rayQuery->SetOrigin(origins[0]);
+    rayQuery->SetDirection(directions[0]);
+    RayQueryResult result = rayQuery->ClosestPoint();
+    EXPECT_DOUBLE_EQ(result.distance, results[0].distance);
+    EXPECT_EQ(result.objectId, results[0].objectId);
+  }
+  EXPECT_FALSE(results[1]);
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RayQueryTest, ClosestPointsParallel)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+
+  VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(5.0, 0.0, 0.0);
+  scene->RootVisual()->AddChild(box);
+
+  VisualPtr sphere = scene->CreateVisual();
+  sphere->AddGeometry(scene->CreateSphere());
+  sphere->SetLocalPosition(3.0, 0.5, 0.0);
+  sphere->SetLocalScale(0.5, 0.5, 0.5);
+  scene->RootVisual()->AddChild(sphere);
+
+  RayQueryPtr rayQuery = scene->CreateRayQuery();
+  ASSERT_NE(nullptr, rayQuery);
+
+  // a grid of rays large enough to be split across threads
+  std::vector<math::Vector3d> origins;
+  std::vector<math::Vector3d> directions;
+  for (int i = -20; i <= 20; ++i)
+  {
+    for (int j = -20; j <= 20; ++j)
+    {
+      origins.push_back(math::Vector3d(0.0, i * 0.05, j * 0.05));
+      directions.push_back(math::Vector3d::UnitX);
+    }
+  }
+
+  std::vector<RayQueryResult> results =
+      rayQuery->ClosestPoints(origins, directions);
+  ASSERT_EQ(origins.size(), results.size());
+
+  // compare against single ray queries
+  unsigned int boxHits = 0u;
+  unsigned int sphereHits = 0u;
+  for (std::size_t i = 0; i < origins.size(); ++i)
+  {
+    rayQuery->SetOrigin(origins[i]);
+    rayQuery->SetDirection(directions[i]);
+    RayQueryResult result = rayQuery->ClosestPoint(i == 0u);
+    EXPECT_EQ(static_cast<bool>(result), static_cast<bool>(results[i]));
+    if (!result || !results[i])
+      continue;
+    EXPECT_NEAR(result.distance, results[i].distance, 1e-4);
+    EXPECT_EQ(result.objectId, results[i].objectId);
+    if (results[i].objectId == box->Id())
+      boxHits++;
+    else if (results[i].objectId == sphere->Id())
+      sphereHits++;
+  }
+  EXPECT_LT(0u, boxHits);
+  EXPECT_LT(0u, sphereHits);
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RayQueryTest, ClosestPointsTinyScale)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+
+  // the transform of a box this small has a determinant well below
+  // machine epsilon but can still be inverted
+  const double scale = 1e-6;
+  VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(5.0, 0.0, 0.0);
+  box->SetLocalScale(scale, scale, scale);
+  scene->RootVisual()->AddChild(box);
+
+  RayQueryPtr rayQuery = scene->CreateRayQuery();
+  ASSERT_NE(nullptr, rayQuery);
+
+  rayQuery->SetOrigin(math::Vector3d::Zero);
+  rayQuery->SetDirection(math::Vector3d::UnitX);
+  RayQueryResult result = rayQuery->ClosestPoint(true);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(box->Id(), result.objectId);
+  EXPECT_NEAR(5.0 - scale * 0.5, result.distance, 1e-6);
+
+  std::vector<RayQueryResult> results = rayQuery->ClosestPoints(
+      {math::Vector3d::Zero}, {math::Vector3d::UnitX});
+  ASSERT_EQ(1u, results.size());
+  ASSERT_TRUE(results[0]);
+  EXPECT_EQ(box->Id(), results[0].objectId);
+  EXPECT_NEAR(5.0 - scale * 0.5, results[0].distance, 1e-6);
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
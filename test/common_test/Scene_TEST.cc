@@ -17,8 +17,13 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include "CommonRenderingTest.hh"
 
+#include "gz/rendering/Camera.hh"
 #include "gz/rendering/RenderTarget.hh"
 #include "gz/rendering/Scene.hh"
 
@@ -488,6 +493,175 @@ TEST_F(SceneTest, DestroyNodes)
   engine->DestroyScene(scene);
 }
 
+/////////////////////////////////////////////////
+TEST_F(SceneTest, VisualStoreIndex)
+{
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // create visuals in an order that does not match their name order
+  std::vector<VisualPtr> visuals;
+  for (unsigned int i = 0; i < 50u; ++i)
+  {
+    std::string name = "visual_" + std::to_string((i * 7u) % 50u);
+    visuals.push_back(scene->CreateVisual(name));
+    ASSERT_NE(nullptr, visuals.back());
+  }
+  EXPECT_EQ(50u, scene->VisualCount());
+
+  // visuals are ordered by name when accessed by index
+  std::string prevName;
+  for (unsigned int i = 0; i < scene->VisualCount(); ++i)
+  {
+    VisualPtr visual = scene->VisualByIndex(i);
+    ASSERT_NE(nullptr, visual);
+    EXPECT_LT(prevName, visual->Name());
+    prevName = visual->Name();
+    EXPECT_EQ(visual, scene->VisualById(visual->Id()));
+    EXPECT_EQ(visual, scene->VisualByName(visual->Name()));
+  }
+  EXPECT_EQ(nullptr, scene->VisualByIndex(50u));
+
+  // index access stays consistent while visuals are destroyed
+  for (unsigned int i = 0; i < visuals.size(); i += 3u)
+  {
+    unsigned int id = visuals[i]->Id();
+    std::string name = visuals[i]->Name();
+    scene->DestroyVisual(visuals[i]);
+    EXPECT_FALSE(scene->HasVisualId(id));
+    EXPECT_FALSE(scene->HasVisualName(name));
+    EXPECT_EQ(nullptr, scene->VisualById(id));
+  }
+  EXPECT_EQ(33u, scene->VisualCount());
+
+  prevName.clear();
+  for (unsigned int i = 0; i < scene->VisualCount(); ++i)
+  {
+    VisualPtr visual = scene->VisualByIndex(i);
+    ASSERT_NE(nullptr, visual);
+    EXPECT_LT(prevName, visual->Name());
+    prevName = visual->Name();
+  }
+
+  // destroy the remaining visuals by index
+  while (scene->VisualCount() > 0u)
+    scene->DestroyVisualByIndex(0u);
+  EXPECT_EQ(0u, scene->VisualCount());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneTest, NodeWorldPoses)
+{
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // create a chain of visuals, each offset from its parent
+  std::vector<unsigned int> ids;
+  VisualPtr parent = scene->RootVisual();
+  for (unsigned int i = 0; i < 10u; ++i)
+  {
+    VisualPtr visual = scene->CreateVisual();
+    ASSERT_NE(nullptr, visual);
+    visual->SetLocalPosition(1, 0, 0);
+    parent->AddChild(visual);
+    ids.push_back(visual->Id());
+    parent = visual;
+  }
+  ids.push_back(ids.back() + 1000u);
+
+  std::vector<math::Pose3d> poses;
+  EXPECT_EQ(10u, scene->NodeWorldPoses(ids, poses));
+  ASSERT_EQ(ids.size(), poses.size());
+  for (unsigned int i = 0; i < 10u; ++i)
+  {
+    EXPECT_EQ(math::Vector3d(i + 1.0, 0, 0), poses[i].Pos());
+    EXPECT_EQ(scene->NodeById(ids[i])->WorldPose(), poses[i]);
+  }
+  EXPECT_EQ(math::Pose3d::Zero, poses.back());
+
+  // poses follow changes to an ancestor
+  scene->NodeById(ids[0])->SetLocalPosition(0, 0, 1);
+  EXPECT_EQ(10u, scene->NodeWorldPoses(ids, poses));
+  for (unsigned int i = 0; i < 10u; ++i)
+    EXPECT_EQ(math::Vector3d(i, 0, 1), poses[i].Pos());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneTest, SetNodePoses)
+{
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // enough nodes for engines to split the update across threads
+  const unsigned int count = 8200u;
+  VisualPtr root = scene->RootVisual();
+  VisualPtr parent = scene->CreateVisual();
+  ASSERT_NE(nullptr, parent);
+  root->AddChild(parent);
+
+  std::vector<unsigned int> ids;
+  std::vector<math::Pose3d> poses;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    VisualPtr visual = scene->CreateVisual();
+    ASSERT_NE(nullptr, visual);
+    parent->AddChild(visual);
+    ids.push_back(visual->Id());
+    poses.push_back(math::Pose3d(i, 1, 2, 0, 0, i * 0.001));
+  }
+  // unknown ids and non-finite poses are skipped
+  ids.push_back(ids.back() + 1000u);
+  poses.push_back(math::Pose3d(1, 2, 3, 0, 0, 0));
+  ids.push_back(ids.front());
+  poses.push_back(math::Pose3d(NAN, 0, 0, 0, 0, 0));
+
+  EXPECT_EQ(count, scene->SetNodeLocalPoses(ids.data(), poses.data(),
+      ids.size()));
+  for (unsigned int i = 0; i < count; i += 97u)
+    EXPECT_EQ(poses[i], scene->NodeById(ids[i])->LocalPose());
+
+  // world poses of the updated nodes follow their parent
+  parent->SetLocalPosition(0, 0, 1);
+  for (unsigned int i = 0; i < count; i += 97u)
+  {
+    EXPECT_EQ(math::Vector3d(i, 1, 3),
+        scene->NodeById(ids[i])->WorldPosition());
+  }
+
+  for (auto &pose : poses)
+    pose.Pos().Z() = -pose.Pos().Z();
+  EXPECT_EQ(count, scene->SetNodeLocalPoses(ids.data(), poses.data(),
+      ids.size(), true));
+  for (unsigned int i = 0; i < count; i += 97u)
+  {
+    EXPECT_EQ(poses[i], scene->NodeById(ids[i])->LocalPose());
+    EXPECT_EQ(math::Vector3d(i, 1, -1),
+        scene->NodeById(ids[i])->WorldPosition());
+  }
+
+  // world poses
+  std::vector<math::Pose3d> worldPoses;
+  for (unsigned int i = 0; i < count; ++i)
+    worldPoses.push_back(math::Pose3d(1, 2, 3 + i, 0, 0, 0));
+  EXPECT_EQ(count, scene->SetNodeWorldPoses(ids.data(), worldPoses.data(),
+      count));
+  for (unsigned int i = 0; i < count; i += 97u)
+  {
+    EXPECT_EQ(worldPoses[i], scene->NodeById(ids[i])->WorldPose());
+    EXPECT_EQ(math::Vector3d(1, 2, 2 + i),
+        scene->NodeById(ids[i])->LocalPosition());
+  }
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
 /////////////////////////////////////////////////
 TEST_F(SceneTest, NodeCycle)
 {
@@ -698,6 +872,78 @@ TEST_F(SceneTest, Time)
   engine->DestroyScene(scene);
 }
 
+/////////////////////////////////////////////////
+TEST_F(SceneTest, SensorScheduler)
+{
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  VisualPtr root = scene->RootVisual();
+
+  CameraPtr slow = scene->CreateCamera();
+  ASSERT_NE(nullptr, slow);
+  slow->SetImageWidth(32);
+  slow->SetImageHeight(32);
+  root->AddChild(slow);
+
+  CameraPtr fast = scene->CreateCamera();
+  ASSERT_NE(nullptr, fast);
+  fast->SetImageWidth(32);
+  fast->SetImageHeight(32);
+  root->AddChild(fast);
+
+  // invalid sensors and rates
+  EXPECT_FALSE(scene->ScheduleSensor(nullptr, 10.0));
+  EXPECT_FALSE(scene->ScheduleSensor(slow, -1.0));
+  EXPECT_FALSE(scene->ScheduleSensor(slow, NAN));
+  EXPECT_FALSE(scene->UnscheduleSensor(slow));
+  EXPECT_EQ(0u, scene->UpdateSensors());
+
+  EXPECT_TRUE(scene->ScheduleSensor(slow, 10.0));
+  EXPECT_TRUE(scene->ScheduleSensor(fast, 0.0));
+
+  // both are due right away, then the slow one every 100 ms
+  scene->SetTime(std::chrono::milliseconds(0));
+  EXPECT_EQ(2u, scene->UpdateSensors());
+  EXPECT_EQ(1u, scene->UpdateSensors());
+  scene->SetTime(std::chrono::milliseconds(50));
+  EXPECT_EQ(1u, scene->UpdateSensors());
+  scene->SetTime(std::chrono::milliseconds(100));
+  EXPECT_EQ(2u, scene->UpdateSensors());
+
+  // updates missed by a time jump are skipped
+  scene->SetTime(std::chrono::milliseconds(450));
+  EXPECT_EQ(2u, scene->UpdateSensors());
+  scene->SetTime(std::chrono::milliseconds(500));
+  EXPECT_EQ(1u, scene->UpdateSensors());
+  scene->SetTime(std::chrono::milliseconds(550));
+  EXPECT_EQ(2u, scene->UpdateSensors());
+
+  // going back in time, e.g. on reset, restarts the schedule
+  scene->SetTime(std::chrono::milliseconds(0));
+  EXPECT_EQ(2u, scene->UpdateSensors());
+
+  // rescheduling changes the rate
+  EXPECT_TRUE(scene->ScheduleSensor(fast, 20.0));
+  scene->SetTime(std::chrono::milliseconds(10));
+  EXPECT_EQ(1u, scene->UpdateSensors());
+  scene->SetTime(std::chrono::milliseconds(60));
+  EXPECT_EQ(1u, scene->UpdateSensors());
+
+  EXPECT_TRUE(scene->UnscheduleSensor(fast));
+  EXPECT_FALSE(scene->UnscheduleSensor(fast));
+  scene->SetTime(std::chrono::milliseconds(100));
+  EXPECT_EQ(1u, scene->UpdateSensors());
+
+  // destroyed sensors are dropped from the schedule
+  scene->DestroySensor(slow);
+  scene->SetTime(std::chrono::milliseconds(200));
+  EXPECT_EQ(0u, scene->UpdateSensors());
+  EXPECT_FALSE(scene->UnscheduleSensor(slow));
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
 /////////////////////////////////////////////////
 TEST_F(SceneTest, BackgroundMaterial)
 {
@@ -15,6 +15,11 @@
 */
 #include <gtest/gtest.h>
 
+#include <array>
+#include <map>
+#include <utility>
+#include <vector>
+
 #include "CommonRenderingTest.hh"
 
 #include <gz/common/geospatial/ImageHeightmap.hh>
@@ -270,3 +275,62 @@ TEST_F(UtilTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(ClickToSceneHeightmap))
   // Clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(UtilTest, ConvertRGBToBayer)
+{
+  // expected channel at even and odd columns of even and odd rows
+  const std::map<PixelFormat, std::array<unsigned int, 4>> patterns = {
+      {PF_BAYER_RGGB8, {0u, 1u, 1u, 2u}},
+      {PF_BAYER_BGGR8, {2u, 1u, 1u, 0u}},
+      {PF_BAYER_GBRG8, {1u, 0u, 2u, 1u}},
+      {PF_BAYER_GRBG8, {1u, 2u, 0u, 1u}}};
+
+  // odd width to cover the last column, and an image large enough to be
+  // converted with multiple threads
+  for (auto size : {std::make_pair(5u, 3u), std::make_pair(1201u, 900u)})
+  {
+    const unsigned int width = size.first;
+    const unsigned int height = size.second;
+    Image rgb(width, height, PF_R8G8B8);
+    unsigned char *rgbData = rgb.Data<unsigned char>();
+    for (unsigned int i = 0; i < width * height * 3u; ++i)
+      rgbData[i] = static_cast<unsigned char>(i * 7u % 251u);
+
+    for (const auto &pattern : patterns)
+    {
+      Image bayer = convertRGBToBayer(rgb, pattern.first);
+      EXPECT_EQ(pattern.first, bayer.Format());
+      const unsigned char *bayerData = bayer.Data<unsigned char>();
+
+      std::vector<unsigned char> buffer(width * height);
+      EXPECT_TRUE(convertRGBToBayer(rgbData, width, height, pattern.first,
+          buffer.data()));
+
+      // in place
+      std::vector<unsigned char> inPlace(rgbData,
+          rgbData + width * height * 3u);
+      EXPECT_TRUE(convertRGBToBayer(inPlace.data(), width, height,
+          pattern.first, inPlace.data()));
+
+      for (unsigned int y = 0; y < height; ++y)
+      {
+        for (unsigned int x = 0; x < width; ++x)
+        {
+          const unsigned int channel = pattern.second[(y % 2) * 2 + x % 2];
+          const unsigned char expected =
+              rgbData[(y * width + x) * 3u + channel];
+          const unsigned int idx = y * width + x;
+          ASSERT_EQ(expected, bayerData[idx]) << x << " " << y;
+          ASSERT_EQ(expected, buffer[idx]) << x << " " << y;
+          ASSERT_EQ(expected, inPlace[idx]) << x << " " << y;
+        }
+      }
+    }
+  }
+
+  // not a bayer format
+  std::vector<unsigned char> data(12u);
+  EXPECT_FALSE(convertRGBToBayer(data.data(), 2u, 2u, PF_R8G8B8,
+      data.data()));
+}
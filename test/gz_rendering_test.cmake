@@ -43,7 +43,8 @@ endif()
 # Set up a rendering test to match Gazebo test conventions with additionally
 # specifying engine-specific test parameters
 #
-# The test will be added with the name <TARGET>_<ENGINE>_<BACKEND>
+# The test will be added with the name <TARGET>_<ENGINE>_<BACKEND>, with a
+# _headless suffix for headless tests
 # For example: UNIT_Camera_TEST_ogre2_gl3plus
 #
 # <TARGET>: The executable to create a test from. The same executable may be
@@ -68,6 +69,9 @@ macro(gz_configure_rendering_test)
   endif()
 
   set(test_name ${gz_configure_rendering_test_TARGET}_${gz_configure_rendering_test_RENDER_ENGINE}_${gz_configure_rendering_test_RENDER_ENGINE_BACKEND})
+  if(gz_configure_rendering_test_HEADLESS)
+    set(test_name ${test_name}_headless)
+  endif()
 
   add_test(NAME ${test_name} 
     COMMAND ${gz_configure_rendering_test_TARGET} --gtest_output=xml:${CMAKE_BINARY_DIR}/test_results/${test_name}.xml)
@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "CommonRenderingTest.hh"
 
 #include <gz/common/Filesystem.hh>
@@ -26,6 +29,19 @@
 
 #include "gz/rendering/Scene.hh"
 #include "gz/rendering/BoundingBoxCamera.hh"
+#include "gz/rendering/Marker.hh"
+#include "gz/rendering/config.hh"
+
+#if HAVE_OGRE2
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreId.h>
+#include <OgreMovableObject.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+#endif
 
 using namespace gz;
 using namespace rendering;
@@ -135,6 +151,66 @@ void Build3dBoxScene(rendering::ScenePtr scene)
   root->AddChild(box);
 }
 
+/// \brief Build a scene with a box that is three times taller than wide
+/// and a unit box next to it, both centered on the camera optical axis
+/// height
+void BuildTallBoxScene(rendering::ScenePtr scene)
+{
+  rendering::VisualPtr root = scene->RootVisual();
+
+  rendering::VisualPtr tallBox = scene->CreateVisual();
+  tallBox->AddGeometry(scene->CreateBox());
+  tallBox->SetLocalPosition(math::Vector3d(3, 1.5, 0));
+  tallBox->SetLocalScale(1, 1, 3);
+  tallBox->SetUserData("label", 1);
+  root->AddChild(tallBox);
+
+  rendering::VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(math::Vector3d(3, -1.5, 0));
+  box->SetUserData("label", 2);
+  root->AddChild(box);
+}
+
+/// \brief Render the visible 2D boxes of a scene with a new camera
+/// \param[in] _scene Scene to render
+/// \param[in] _width Image width
+/// \param[in] _height Image height
+/// \return Boxes sorted by label
+std::vector<BoundingBox> VisibleBoxes(rendering::ScenePtr _scene,
+    unsigned int _width, unsigned int _height)
+{
+  auto camera = _scene->CreateBoundingBoxCamera();
+  EXPECT_NE(nullptr, camera);
+  if (!camera)
+    return {};
+
+  camera->SetLocalPosition(0.0, 0.0, 0.0);
+  camera->SetLocalRotation(0.0, 0.0, 0.0);
+  camera->SetImageWidth(_width);
+  camera->SetImageHeight(_height);
+  camera->SetAspectRatio(1.333);
+  camera->SetHFOV(GZ_PI / 2);
+  camera->SetBoundingBoxType(BoundingBoxType::BBT_VISIBLEBOX2D);
+  _scene->RootVisual()->AddChild(camera);
+
+  gz::common::ConnectionPtr connection =
+    camera->ConnectNewBoundingBoxes(
+      std::bind(OnNewBoundingBoxes, std::placeholders::_1));
+  camera->Update();
+  connection.reset();
+  _scene->DestroySensor(camera);
+
+  std::lock_guard<std::mutex> lock(g_mutex);
+  std::vector<BoundingBox> boxes = g_boxes;
+  std::sort(boxes.begin(), boxes.end(),
+      [](const BoundingBox &_a, const BoundingBox &_b)
+      {
+        return _a.Label() < _b.Label();
+      });
+  return boxes;
+}
+
 //////////////////////////////////////////////////
 TEST_F(BoundingBoxCameraTest, SimpleBoxes)
 {
@@ -369,3 +445,166 @@ TEST_F(BoundingBoxCameraTest, Oriented3dBoxes)
   // Clean up
   engine->DestroyScene(scene);
 }
+
+//////////////////////////////////////////////////
+TEST_F(BoundingBoxCameraTest, DynamicGeometry)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  // accepted error with +/- in pixels in comparing the box coordinates
+  int marginError = 3;
+
+  gz::rendering::ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // triangle facing the camera, added with both windings so it is visible
+  // regardless of culling. Its vertices are rewritten in place when moved.
+  math::Vector3d left(3, 0.5, -0.5);
+  math::Vector3d right(3, -0.5, -0.5);
+  math::Vector3d top(3, 0, 0.5);
+  rendering::MarkerPtr marker = scene->CreateMarker();
+  ASSERT_NE(nullptr, marker);
+  marker->SetType(MarkerType::MT_TRIANGLE_LIST);
+  marker->AddPoint(left, math::Color::White);
+  marker->AddPoint(right, math::Color::White);
+  marker->AddPoint(top, math::Color::White);
+  marker->AddPoint(right, math::Color::White);
+  marker->AddPoint(left, math::Color::White);
+  marker->AddPoint(top, math::Color::White);
+
+  rendering::VisualPtr visual = scene->CreateVisual();
+  visual->AddGeometry(marker);
+  visual->SetUserData("label", 1);
+  scene->RootVisual()->AddChild(visual);
+
+  // Create BoundingBox camera
+  auto camera = scene->CreateBoundingBoxCamera("BoundingBoxCamera");
+  ASSERT_NE(camera, nullptr);
+
+  camera->SetLocalPosition(0.0, 0.0, 0.0);
+  camera->SetLocalRotation(0.0, 0.0, 0.0);
+
+  unsigned int width = 320;
+  unsigned int height = 240;
+
+  camera->SetImageWidth(width);
+  camera->SetImageHeight(height);
+  camera->SetAspectRatio(1.333);
+  camera->SetHFOV(GZ_PI / 2);
+  camera->SetBoundingBoxType(BoundingBoxType::BBT_FULLBOX2D);
+  scene->RootVisual()->AddChild(camera);
+
+  gz::common::ConnectionPtr connection =
+    camera->ConnectNewBoundingBoxes(
+      std::bind(OnNewBoundingBoxes, std::placeholders::_1));
+  EXPECT_NE(nullptr, connection);
+
+  camera->Update();
+
+  g_mutex.lock();
+  std::vector<BoundingBox> boxes = g_boxes;
+  g_mutex.unlock();
+  ASSERT_EQ(boxes.size(), size_t(1));
+  BoundingBox box = boxes[0];
+  EXPECT_NEAR(box.Center().X(), 159, marginError);
+  EXPECT_NEAR(box.Center().Y(), 119, marginError);
+  EXPECT_NEAR(box.Size().X(), 53, marginError);
+  EXPECT_NEAR(box.Size().Y(), 53, marginError);
+  EXPECT_EQ(box.Label(), 1u);
+
+  // raise the top vertex, the box must follow without the mesh changing
+  marker->SetPoint(2, math::Vector3d(3, 0, 1.0));
+  marker->SetPoint(5, math::Vector3d(3, 0, 1.0));
+  camera->Update();
+
+  g_mutex.lock();
+  boxes = g_boxes;
+  g_mutex.unlock();
+  ASSERT_EQ(boxes.size(), size_t(1));
+  box = boxes[0];
+  EXPECT_NEAR(box.Center().X(), 159, marginError);
+  EXPECT_NEAR(box.Center().Y(), 106, marginError);
+  EXPECT_NEAR(box.Size().X(), 53, marginError);
+  EXPECT_NEAR(box.Size().Y(), 80, marginError);
+  EXPECT_EQ(box.Label(), 1u);
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+//////////////////////////////////////////////////
+TEST_F(BoundingBoxCameraTest, LargeImage)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  gz::rendering::ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  BuildTallBoxScene(scene);
+
+  // 320x240 is scanned as a single band while 640x480 is split in 4 bands
+  // of 120 rows that are scanned in parallel and merged
+  std::vector<BoundingBox> small = VisibleBoxes(scene, 320u, 240u);
+  std::vector<BoundingBox> large = VisibleBoxes(scene, 640u, 480u);
+  ASSERT_EQ(2u, small.size());
+  ASSERT_EQ(2u, large.size());
+
+  // every item is reported once with the label of its first pixel
+  EXPECT_EQ(1u, large[0].Label());
+  EXPECT_EQ(2u, large[1].Label());
+
+  // the tall box covers all band boundaries and the unit box covers the
+  // one in the middle of the image
+  const unsigned int rowsPerBand = 120u;
+  EXPECT_LT(large[0].Center().Y() - large[0].Size().Y() * 0.5, rowsPerBand);
+  EXPECT_GT(large[0].Center().Y() + large[0].Size().Y() * 0.5,
+      3 * rowsPerBand);
+  EXPECT_LT(large[1].Center().Y() - large[1].Size().Y() * 0.5,
+      2 * rowsPerBand);
+  EXPECT_GT(large[1].Center().Y() + large[1].Size().Y() * 0.5,
+      2 * rowsPerBand);
+
+  // the merged bounds match the single band bounds at twice the resolution
+  const double marginError = 3.0;
+  for (std::size_t i = 0; i < large.size(); ++i)
+  {
+    EXPECT_EQ(small[i].Label(), large[i].Label());
+    EXPECT_NEAR(small[i].Center().X() * 2.0, large[i].Center().X(),
+        marginError);
+    EXPECT_NEAR(small[i].Center().Y() * 2.0, large[i].Center().Y(),
+        marginError);
+    EXPECT_NEAR(small[i].Size().X() * 2.0, large[i].Size().X(),
+        marginError);
+    EXPECT_NEAR(small[i].Size().Y() * 2.0, large[i].Size().Y(),
+        marginError);
+  }
+
+  // Clean up
+  engine->DestroyScene(scene);
+
+#if HAVE_OGRE2
+  // ogre ids are written to the id image as 24 bit values, with the high
+  // byte in the alpha channel. Skip ahead so the next items get ids above
+  // 16 bits and check they are still decoded.
+  while (Ogre::Id::generateNewId<Ogre::MovableObject>() < 0x10000u + 100u)
+  {
+  }
+
+  scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  BuildTallBoxScene(scene);
+
+  std::vector<BoundingBox> largeIds = VisibleBoxes(scene, 640u, 480u);
+  ASSERT_EQ(large.size(), largeIds.size());
+  for (std::size_t i = 0; i < large.size(); ++i)
+  {
+    EXPECT_EQ(large[i].Label(), largeIds[i].Label());
+    EXPECT_NEAR(large[i].Center().X(), largeIds[i].Center().X(), 1.0);
+    EXPECT_NEAR(large[i].Center().Y(), largeIds[i].Center().Y(), 1.0);
+    EXPECT_NEAR(large[i].Size().X(), largeIds[i].Size().X(), 1.0);
+    EXPECT_NEAR(large[i].Size().Y(), largeIds[i].Size().Y(), 1.0);
+  }
+
+  // Clean up
+  engine->DestroyScene(scene);
+#endif
+}
@@ -274,6 +274,133 @@ TEST_F(CameraTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(VisualAt))
   engine->DestroyScene(scene);
 }
 
+/////////////////////////////////////////////////
+TEST_F(CameraTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(VisualsInArea))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  VisualPtr root = scene->RootVisual();
+  ASSERT_NE(nullptr, root);
+
+  // create box visual on the right of the image
+  VisualPtr box = scene->CreateVisual("box");
+  ASSERT_NE(nullptr, box);
+  box->AddGeometry(scene->CreateBox());
+  box->SetOrigin(0.0, 0.7, 0.0);
+  box->SetLocalPosition(2, 0, 0);
+  root->AddChild(box);
+
+  // create sphere visual on the left of the image
+  VisualPtr sphere = scene->CreateVisual("sphere");
+  ASSERT_NE(nullptr, sphere);
+  sphere->AddGeometry(scene->CreateSphere());
+  sphere->SetOrigin(0.0, -0.7, 0.0);
+  sphere->SetLocalPosition(2, 0, 0);
+  root->AddChild(sphere);
+
+  // create camera
+  CameraPtr camera = scene->CreateCamera("camera");
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(800);
+  camera->SetImageHeight(600);
+  camera->SetAspectRatio(1.333);
+  camera->SetHFOV(GZ_PI / 2);
+  root->AddChild(camera);
+  camera->Update();
+
+  // whole image
+  auto results = camera->VisualsInRectangle(math::Vector2i(0, 0),
+      math::Vector2i(799, 599));
+  ASSERT_EQ(2u, results.size());
+  EXPECT_LE(results[0].distance, results[1].distance);
+  for (const auto &result : results)
+  {
+    EXPECT_TRUE(result.objectId == box->Id() ||
+                result.objectId == sphere->Id());
+    EXPECT_GT(result.pixelCount, 0u);
+    EXPECT_GT(result.distance, 0.0);
+    EXPECT_NEAR(1.5, result.point.X(), 0.2);
+  }
+
+  // left half only sees the sphere, corners can be given in any order
+  results = camera->VisualsInRectangle(math::Vector2i(399, 599),
+      math::Vector2i(0, 0));
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ(sphere->Id(), results[0].objectId);
+
+  // empty corner
+  results = camera->VisualsInRectangle(math::Vector2i(0, 0),
+      math::Vector2i(50, 50));
+  EXPECT_TRUE(results.empty());
+
+  // area fully covered by the box
+  results = camera->VisualsInRectangle(math::Vector2i(500, 250),
+      math::Vector2i(649, 349));
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ(box->Id(), results[0].objectId);
+  EXPECT_EQ(150u * 100u, results[0].pixelCount);
+
+  // same area as a polygon, pixel centers inside the polygon are counted
+  results = camera->VisualsInPolygon({math::Vector2i(500, 250),
+      math::Vector2i(650, 250), math::Vector2i(650, 350),
+      math::Vector2i(500, 350)});
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ(box->Id(), results[0].objectId);
+  EXPECT_EQ(150u * 100u, results[0].pixelCount);
+
+  // lasso around the sphere whose bounding rectangle touches the box
+  results = camera->VisualsInPolygon({math::Vector2i(120, 150),
+      math::Vector2i(390, 150), math::Vector2i(390, 450),
+      math::Vector2i(600, 450), math::Vector2i(600, 480),
+      math::Vector2i(120, 480)});
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ(sphere->Id(), results[0].objectId);
+
+  // degenerate polygon
+  results = camera->VisualsInPolygon({math::Vector2i(0, 0),
+      math::Vector2i(799, 599)});
+  EXPECT_TRUE(results.empty());
+
+  // VisualAt keeps working after area queries
+  auto vis = camera->VisualAt(math::Vector2i(550, 300));
+  ASSERT_NE(nullptr, vis);
+  EXPECT_EQ("box", vis->Name());
+
+  // and sees scene changes in the next frame
+  box->SetLocalPosition(2, 0, 10);
+  camera->Update();
+  EXPECT_EQ(nullptr, camera->VisualAt(math::Vector2i(550, 300)));
+  results = camera->VisualsInRectangle(math::Vector2i(0, 0),
+      math::Vector2i(799, 599));
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ(sphere->Id(), results[0].objectId);
+
+  // the 1x1 selection texture is shared between cameras, destroying one of
+  // them must not break the selection buffer of the others
+  CameraPtr otherCamera = scene->CreateCamera("other_camera");
+  ASSERT_NE(nullptr, otherCamera);
+  otherCamera->SetImageWidth(800);
+  otherCamera->SetImageHeight(600);
+  otherCamera->SetAspectRatio(1.333);
+  otherCamera->SetHFOV(GZ_PI / 2);
+  root->AddChild(otherCamera);
+  otherCamera->Update();
+  vis = otherCamera->VisualAt(math::Vector2i(250, 300));
+  ASSERT_NE(nullptr, vis);
+  EXPECT_EQ("sphere", vis->Name());
+  scene->DestroySensor(otherCamera);
+
+  vis = camera->VisualAt(math::Vector2i(250, 300));
+  ASSERT_NE(nullptr, vis);
+  EXPECT_EQ("sphere", vis->Name());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
 /////////////////////////////////////////////////
 TEST_F(CameraTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Follow))
 {
@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "CommonRenderingTest.hh"
 
 #include <gz/common/Filesystem.hh>
@@ -25,6 +28,11 @@
 #include "gz/rendering/DepthCamera.hh"
 #include "gz/rendering/ParticleEmitter.hh"
 #include "gz/rendering/Scene.hh"
+#include "gz/rendering/config.hh"
+
+#if HAVE_OGRE2
+#include "gz/rendering/ogre2/Ogre2DepthCamera.hh"
+#endif
 
 #include <gz/utils/ExtraTestMacros.hh>
 
@@ -735,3 +743,199 @@ TEST_F(DepthCameraTest, DepthCameraParticles)
 
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(DepthCameraTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ReadbackLatency))
+{
+  // asynchronous readback is only supported in ogre2
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  int imgWidth_ = 64;
+  int imgHeight_ = 64;
+  double unitBoxSize = 1.0;
+  gz::math::Vector3d boxPosition(1.8, 0.0, 0.0);
+
+  gz::rendering::ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  gz::rendering::VisualPtr root = scene->RootVisual();
+
+  // create box visual
+  gz::rendering::VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(boxPosition);
+  box->SetLocalScale(unitBoxSize, unitBoxSize, unitBoxSize);
+  root->AddChild(box);
+  {
+    auto depthCamera = scene->CreateDepthCamera("DepthCamera");
+    ASSERT_NE(depthCamera, nullptr);
+    depthCamera->SetImageWidth(imgWidth_);
+    depthCamera->SetImageHeight(imgHeight_);
+    depthCamera->SetFarClipPlane(10.0);
+    depthCamera->SetNearClipPlane(0.15);
+    depthCamera->SetAspectRatio(1.0);
+    depthCamera->SetHFOV(1.05);
+    depthCamera->CreateDepthTexture();
+    root->AddChild(depthCamera);
+
+    // synchronous by default
+    EXPECT_EQ(0u, depthCamera->ReadbackLatency());
+    depthCamera->SetReadbackLatency(2u);
+    EXPECT_EQ(2u, depthCamera->ReadbackLatency());
+
+    float *scan = new float[imgHeight_ * imgWidth_];
+    gz::common::ConnectionPtr connection =
+      depthCamera->ConnectNewDepthFrame(
+          std::bind(&::OnNewDepthFrame, scan,
+            std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+            std::placeholders::_4, std::placeholders::_5));
+
+    int mid = static_cast<int>(imgHeight_ * 0.5) * imgWidth_ +
+        static_cast<int>(imgWidth_ * 0.5) - 1;
+    double expectedRange = boxPosition.X() - unitBoxSize * 0.5;
+
+    // no data is delivered until the ring of readbacks is full
+    g_depthCounter = 0u;
+    depthCamera->Update();
+    depthCamera->Update();
+    EXPECT_EQ(0u, g_depthCounter);
+    depthCamera->Update();
+    EXPECT_EQ(1u, g_depthCounter);
+    EXPECT_NEAR(expectedRange, scan[mid], DEPTH_TOL);
+
+    // move the box away. The frames already in flight still see the box
+    box->SetLocalPosition(boxPosition + gz::math::Vector3d(1.0, 0.0, 0.0));
+    depthCamera->Update();
+    EXPECT_EQ(2u, g_depthCounter);
+    EXPECT_NEAR(expectedRange, scan[mid], DEPTH_TOL);
+    depthCamera->Update();
+    EXPECT_EQ(3u, g_depthCounter);
+    EXPECT_NEAR(expectedRange, scan[mid], DEPTH_TOL);
+    depthCamera->Update();
+    EXPECT_EQ(4u, g_depthCounter);
+    EXPECT_NEAR(expectedRange + 1.0, scan[mid], DEPTH_TOL);
+
+    // switching back to synchronous readback delivers data immediately
+    depthCamera->SetReadbackLatency(0u);
+    EXPECT_EQ(0u, depthCamera->ReadbackLatency());
+    box->SetLocalPosition(boxPosition);
+    depthCamera->Update();
+    EXPECT_EQ(5u, g_depthCounter);
+    EXPECT_NEAR(expectedRange, scan[mid], DEPTH_TOL);
+
+    connection.reset();
+    delete [] scan;
+  }
+
+  engine->DestroyScene(scene);
+}
+
+#if HAVE_OGRE2
+/////////////////////////////////////////////////
+TEST_F(DepthCameraTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(OutputSelection))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  int imgWidth_ = 64;
+  int imgHeight_ = 48;
+  double unitBoxSize = 1.0;
+  gz::math::Vector3d boxPosition(1.8, 0.0, 0.0);
+
+  gz::rendering::ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  gz::rendering::VisualPtr root = scene->RootVisual();
+
+  // create box visual
+  gz::rendering::VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(boxPosition);
+  box->SetLocalScale(unitBoxSize, unitBoxSize, unitBoxSize);
+  root->AddChild(box);
+  {
+    auto depthCamera = scene->CreateDepthCamera("DepthCamera");
+    ASSERT_NE(depthCamera, nullptr);
+    depthCamera->SetImageWidth(imgWidth_);
+    depthCamera->SetImageHeight(imgHeight_);
+    depthCamera->SetFarClipPlane(10.0);
+    depthCamera->SetNearClipPlane(0.15);
+    depthCamera->SetAspectRatio(
+        static_cast<double>(imgWidth_) / imgHeight_);
+    depthCamera->SetHFOV(1.05);
+    depthCamera->CreateDepthTexture();
+    root->AddChild(depthCamera);
+
+    const unsigned int len = imgWidth_ * imgHeight_;
+    std::vector<float> depthOnly(len);
+    std::vector<float> depthFull(len);
+    std::vector<float> pointCloud(len * 4);
+
+    int mid = static_cast<int>(imgHeight_ * 0.5) * imgWidth_ +
+        static_cast<int>(imgWidth_ * 0.5) - 1;
+    double expectedRange = boxPosition.X() - unitBoxSize * 0.5;
+
+    // only depth frames are consumed. DepthData keeps being updated until
+    // depth only readback is enabled
+    g_depthCounter = 0u;
+    gz::common::ConnectionPtr depthConnection =
+      depthCamera->ConnectNewDepthFrame(
+          std::bind(&::OnNewDepthFrame, depthOnly.data(),
+            std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+            std::placeholders::_4, std::placeholders::_5));
+    auto ogreDepthCamera =
+        std::dynamic_pointer_cast<gz::rendering::Ogre2DepthCamera>(
+        depthCamera);
+    ASSERT_NE(nullptr, ogreDepthCamera);
+    EXPECT_FALSE(ogreDepthCamera->DepthOnlyReadback());
+    depthCamera->Update();
+    EXPECT_EQ(1u, g_depthCounter);
+    ASSERT_NE(nullptr, depthCamera->DepthData());
+    EXPECT_NEAR(expectedRange, depthCamera->DepthData()[mid * 4], DEPTH_TOL);
+    EXPECT_NEAR(expectedRange, depthOnly[mid], DEPTH_TOL);
+
+    ogreDepthCamera->SetDepthOnlyReadback(true);
+    EXPECT_TRUE(ogreDepthCamera->DepthOnlyReadback());
+    std::fill(depthOnly.begin(), depthOnly.end(), 0.0f);
+    depthCamera->Update();
+    EXPECT_EQ(2u, g_depthCounter);
+    EXPECT_NEAR(expectedRange, depthOnly[mid], DEPTH_TOL);
+    EXPECT_FLOAT_EQ(gz::math::INF_D, depthOnly[0]);
+
+    // subscribing to the point cloud switches to the full output. The depth
+    // frame must be identical
+    g_pointCloudCounter = 0u;
+    depthConnection = depthCamera->ConnectNewDepthFrame(
+        std::bind(&::OnNewDepthFrame, depthFull.data(),
+          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+          std::placeholders::_4, std::placeholders::_5));
+    gz::common::ConnectionPtr pointCloudConnection =
+      depthCamera->ConnectNewRgbPointCloud(
+          std::bind(&::OnNewRgbPointCloud, pointCloud.data(),
+            std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+            std::placeholders::_4, std::placeholders::_5));
+    depthCamera->Update();
+    EXPECT_EQ(3u, g_depthCounter);
+    EXPECT_EQ(1u, g_pointCloudCounter);
+    for (unsigned int i = 0; i < len; ++i)
+    {
+      EXPECT_FLOAT_EQ(depthFull[i], depthOnly[i]);
+      EXPECT_FLOAT_EQ(depthFull[i], pointCloud[i * 4]);
+    }
+
+    // and back to depth only
+    pointCloudConnection.reset();
+    std::fill(depthOnly.begin(), depthOnly.end(), 0.0f);
+    depthConnection = depthCamera->ConnectNewDepthFrame(
+        std::bind(&::OnNewDepthFrame, depthOnly.data(),
+          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+          std::placeholders::_4, std::placeholders::_5));
+    depthCamera->Update();
+    EXPECT_EQ(4u, g_depthCounter);
+    EXPECT_EQ(1u, g_pointCloudCounter);
+    for (unsigned int i = 0; i < len; ++i)
+      EXPECT_FLOAT_EQ(depthFull[i], depthOnly[i]);
+
+    depthConnection.reset();
+  }
+
+  engine->DestroyScene(scene);
+}
+#endif
@@ -769,6 +769,182 @@ TEST_F(GpuRaysTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SingleRay))
   engine->DestroyScene(scene);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test writing RGBA data straight into a caller-owned buffer
+TEST_F(GpuRaysTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(OutputBuffer))
+{
+  // output buffers and 4 channel data are only supported in ogre2
+  CHECK_SUPPORTED_ENGINE("ogre2");
+  #ifdef __APPLE__
+    GTEST_SKIP() << "Unsupported on apple, see issue #35.";
+  #endif
+
+  const double hMinAngle = -GZ_PI/2.0;
+  const double hMaxAngle = GZ_PI/2.0;
+  const double minRange = 0.1;
+  const double maxRange = 10.0;
+  const int hRayCount = 320;
+  const int vRayCount = 1;
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  VisualPtr root = scene->RootVisual();
+
+  GpuRaysPtr gpuRays = scene->CreateGpuRays("gpu_rays");
+  gpuRays->SetWorldPosition(math::Vector3d(0, 0, 0.1));
+  gpuRays->SetNearClipPlane(minRange);
+  gpuRays->SetFarClipPlane(maxRange);
+  gpuRays->SetAngleMin(hMinAngle);
+  gpuRays->SetAngleMax(hMaxAngle);
+  gpuRays->SetRayCount(hRayCount);
+  gpuRays->SetVerticalRayCount(vRayCount);
+  root->AddChild(gpuRays);
+
+  // box in the center
+  math::Vector3d boxPos(3, 0, 0.5);
+  VisualPtr visualBox1 = scene->CreateVisual("UnitBox1");
+  visualBox1->AddGeometry(scene->CreateBox());
+  visualBox1->SetWorldPosition(boxPos);
+  root->AddChild(visualBox1);
+
+  // invalid channel counts are ignored
+  EXPECT_EQ(3u, gpuRays->Channels());
+  gpuRays->SetChannels(2u);
+  EXPECT_EQ(3u, gpuRays->Channels());
+  gpuRays->SetChannels(4u);
+  EXPECT_EQ(4u, gpuRays->Channels());
+
+  EXPECT_EQ(nullptr, gpuRays->OutputBuffer());
+  std::vector<float> buffer(hRayCount * vRayCount * 4u, -1.0f);
+  gpuRays->SetOutputBuffer(buffer.data());
+  EXPECT_EQ(buffer.data(), gpuRays->OutputBuffer());
+
+  const float *frame = nullptr;
+  unsigned int frameChannels = 0u;
+  std::string frameFormat;
+  common::ConnectionPtr c =
+    gpuRays->ConnectNewGpuRaysFrame(
+        [&](const float *_frame, unsigned int, unsigned int,
+            unsigned int _channels, const std::string &_format)
+        {
+          frame = _frame;
+          frameChannels = _channels;
+          frameFormat = _format;
+        });
+
+  gpuRays->Update();
+  scene->SetTime(scene->Time() + std::chrono::milliseconds(16));
+
+  // data is written straight into our buffer
+  EXPECT_EQ(buffer.data(), frame);
+  EXPECT_EQ(buffer.data(), gpuRays->Data());
+  EXPECT_EQ(4u, frameChannels);
+  EXPECT_EQ("PF_FLOAT32_RGBA", frameFormat);
+
+  int mid = static_cast<int>(hRayCount/2) * 4;
+  int last = (hRayCount - 1) * 4;
+  double expectedRange = boxPos.X() - 0.5;
+  EXPECT_NEAR(expectedRange, buffer[mid], LASER_TOL);
+  EXPECT_FLOAT_EQ(math::INF_F, buffer[last]);
+
+  // readings are laid out as [range, retro, 0, 1]
+  EXPECT_FLOAT_EQ(0.0f, buffer[mid + 2]);
+  EXPECT_FLOAT_EQ(1.0f, buffer[mid + 3]);
+  EXPECT_FLOAT_EQ(0.0f, buffer[last + 2]);
+  EXPECT_FLOAT_EQ(1.0f, buffer[last + 3]);
+
+  // switch back to the internal RGB buffer
+  gpuRays->SetOutputBuffer(nullptr);
+  gpuRays->SetChannels(3u);
+  gpuRays->Update();
+  scene->SetTime(scene->Time() + std::chrono::milliseconds(16));
+  EXPECT_NE(buffer.data(), frame);
+  EXPECT_EQ(3u, frameChannels);
+  EXPECT_EQ("PF_FLOAT32_RGB", frameFormat);
+
+  std::vector<float> scan(hRayCount * vRayCount * 3u);
+  gpuRays->Copy(scan.data());
+  EXPECT_NEAR(expectedRange, scan[hRayCount/2 * 3], LASER_TOL);
+
+  c.reset();
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test gpu rays with the same ray pattern, which share resources
+TEST_F(GpuRaysTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SameRayPattern))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+  #ifdef __APPLE__
+    GTEST_SKIP() << "Unsupported on apple, see issue #35.";
+  #endif
+
+  const double hMinAngle = -GZ_PI/2.0;
+  const double hMaxAngle = GZ_PI/2.0;
+  const double minRange = 0.1;
+  const double maxRange = 10.0;
+  const unsigned int hRayCount = 320u;
+  const unsigned int vRayCount = 4u;
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  VisualPtr root = scene->RootVisual();
+
+  std::vector<GpuRaysPtr> lidars;
+  for (unsigned int i = 0; i < 3u; ++i)
+  {
+    GpuRaysPtr gpuRays =
+        scene->CreateGpuRays("gpu_rays_" + std::to_string(i));
+    gpuRays->SetWorldPosition(math::Vector3d(0, 0, 0.1));
+    gpuRays->SetNearClipPlane(minRange);
+    gpuRays->SetFarClipPlane(maxRange);
+    gpuRays->SetAngleMin(hMinAngle);
+    gpuRays->SetAngleMax(hMaxAngle);
+    gpuRays->SetVerticalAngleMin(-0.1);
+    gpuRays->SetVerticalAngleMax(0.1);
+    gpuRays->SetRayCount(hRayCount);
+    gpuRays->SetVerticalRayCount(vRayCount);
+    root->AddChild(gpuRays);
+    lidars.push_back(gpuRays);
+  }
+
+  math::Vector3d boxPos(3, 0, 0.5);
+  VisualPtr visualBox1 = scene->CreateVisual("UnitBox1");
+  visualBox1->AddGeometry(scene->CreateBox());
+  visualBox1->SetWorldPosition(boxPos);
+  root->AddChild(visualBox1);
+
+  std::vector<std::vector<float>> scans(lidars.size(),
+      std::vector<float>(hRayCount * vRayCount * 3u));
+  for (unsigned int i = 0; i < lidars.size(); ++i)
+  {
+    lidars[i]->Update();
+    lidars[i]->Copy(scans[i].data());
+  }
+
+  const unsigned int mid = (vRayCount / 2u * hRayCount + hRayCount / 2u) * 3u;
+  EXPECT_NEAR(boxPos.X() - 0.5, scans[0][mid], LASER_TOL);
+  for (unsigned int i = 1; i < lidars.size(); ++i)
+  {
+    for (unsigned int j = 0; j < scans[0].size(); j += 3u)
+      EXPECT_FLOAT_EQ(scans[0][j], scans[i][j]) << j;
+  }
+
+  // the remaining gpu rays keep working when one of them is destroyed
+  scene->DestroySensor(lidars[0]);
+  lidars[1]->Update();
+  std::vector<float> scan(hRayCount * vRayCount * 3u);
+  lidars[1]->Copy(scan.data());
+  EXPECT_NEAR(boxPos.X() - 0.5, scan[mid], LASER_TOL);
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
 /////////////////////////////////////////////////
 TEST_F(GpuRaysTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Visibility))
 {
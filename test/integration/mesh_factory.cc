@@ -0,0 +1,377 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CommonRenderingTest.hh"
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/common/MeshManager.hh>
+#include <gz/common/SubMesh.hh>
+#include <gz/common/TempDirectory.hh>
+
+#include "gz/rendering/Camera.hh"
+#include "gz/rendering/DirectionalLight.hh"
+#include "gz/rendering/Image.hh"
+#include "gz/rendering/Mesh.hh"
+#include "gz/rendering/MeshDescriptor.hh"
+#include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreMesh.h>
+#include <OgreMesh2.h>
+#include <OgreMeshManager.h>
+#include <OgreMeshManager2.h>
+#include <OgreSubMesh2.h>
+#include <Vao/OgreIndexBufferPacked.h>
+#include <Vao/OgreVertexArrayObject.h>
+#include <Vao/OgreVertexBufferPacked.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Geometry of a mesh created by the ogre2 engine
+struct OgreMeshInfo
+{
+  /// \brief Number of vertices of all submeshes
+  std::size_t vertexCount = 0u;
+
+  /// \brief Index type of each submesh
+  std::vector<Ogre::IndexBufferPacked::IndexType> indexTypes;
+
+  /// \brief Mesh bounds
+  Ogre::Aabb aabb;
+
+  /// \brief Type of the normal vertex element of each submesh.
+  /// VET_FLOAT3 for plain normals, VET_SHORT4_SNORM for QTangents.
+  std::vector<Ogre::VertexElementType> normalTypes;
+
+  /// \brief True if any submesh has a separate tangent vertex element
+  bool hasTangents = false;
+
+  /// \brief RGB image of the lit mesh seen from above
+  std::vector<unsigned char> image;
+};
+
+/// \brief Size of the images rendered of the test meshes
+static const unsigned int kImageSize = 128u;
+
+/// \brief Test fixture for the ogre2 mesh factory options. Since the options
+/// are engine parameters the engine is loaded by the tests.
+class MeshFactoryTest: public EngineReloadTest
+{
+  /// \brief Load the engine, create a mesh and get its geometry
+  /// \param[in] _params Engine parameters added to the default ones
+  /// \param[in] _desc Descriptor of the mesh to create
+  /// \param[out] _info Geometry of the created mesh
+  /// \param[out] _fromV1 True if the mesh was built from a v1 mesh, false
+  /// if it was loaded from the mesh cache
+  /// \param[in] _render True to render an image of the lit mesh
+  public: void CreateMesh(const std::map<std::string, std::string> &_params,
+              const MeshDescriptor &_desc, OgreMeshInfo &_info,
+              bool &_fromV1, bool _render = false)
+  {
+    auto engine = this->LoadEngine(_params);
+    ASSERT_NE(nullptr, engine);
+
+    ScenePtr scene = engine->CreateScene("scene");
+    ASSERT_NE(nullptr, scene);
+    MeshPtr mesh = scene->CreateMesh(_desc);
+    ASSERT_NE(nullptr, mesh);
+    VisualPtr visual = scene->CreateVisual();
+    visual->AddGeometry(mesh);
+    scene->RootVisual()->AddChild(visual);
+
+    // name given to meshes by the ogre2 mesh factory
+    const std::string name = _desc.meshName + "::" + _desc.subMeshName +
+        "::" + (_desc.centerSubMesh ? "CENTERED" : "ORIGINAL");
+    Ogre::MeshPtr ogreMesh = Ogre::MeshManager::getSingleton().getByName(name);
+    ASSERT_TRUE(ogreMesh);
+    _fromV1 = static_cast<bool>(
+        Ogre::v1::MeshManager::getSingleton().getByName(name));
+
+    _info = OgreMeshInfo();
+    _info.aabb = ogreMesh->getAabb();
+    for (const auto &subMesh : ogreMesh->getSubMeshes())
+    {
+      ASSERT_FALSE(subMesh->mVao[Ogre::VpNormal].empty());
+      Ogre::VertexArrayObject *vao = subMesh->mVao[Ogre::VpNormal][0];
+      _info.vertexCount += vao->getVertexBuffers()[0]->getNumElements();
+      ASSERT_NE(nullptr, vao->getIndexBuffer());
+      _info.indexTypes.push_back(vao->getIndexBuffer()->getIndexType());
+
+      // the vertex declaration the GPU sees
+      Ogre::VertexElementType normalType = Ogre::VET_FLOAT1;
+      for (const auto *vertexBuffer : vao->getVertexBuffers())
+      {
+        for (const auto &element : vertexBuffer->getVertexElements())
+        {
+          if (element.mSemantic == Ogre::VES_NORMAL)
+            normalType = element.mType;
+          else if (element.mSemantic == Ogre::VES_TANGENT)
+            _info.hasTangents = true;
+        }
+      }
+      _info.normalTypes.push_back(normalType);
+    }
+
+    if (_render)
+    {
+      scene->SetAmbientLight(0.2, 0.2, 0.2);
+      scene->SetBackgroundColor(0.0, 0.0, 0.0);
+      DirectionalLightPtr light = scene->CreateDirectionalLight();
+      light->SetDirection(0.5, 0.3, -1.0);
+      light->SetDiffuseColor(0.8, 0.8, 0.8);
+      scene->RootVisual()->AddChild(light);
+
+      // look straight down at the mesh so it fills the whole image
+      CameraPtr camera = scene->CreateCamera();
+      ASSERT_NE(nullptr, camera);
+      camera->SetImageWidth(kImageSize);
+      camera->SetImageHeight(kImageSize);
+      camera->SetImageFormat(PF_R8G8B8);
+      camera->SetAspectRatio(1.0);
+      camera->SetHFOV(GZ_PI / 5);
+      camera->SetLocalPosition(0.0, 0.0, 15.0);
+      camera->SetLocalRotation(0.0, GZ_PI / 2, 0.0);
+      scene->RootVisual()->AddChild(camera);
+
+      Image image = camera->CreateImage();
+      camera->Capture(image);
+      const unsigned char *data = image.Data<unsigned char>();
+      _info.image.assign(data, data + image.MemorySize());
+    }
+
+    engine->DestroyScene(scene);
+    ASSERT_TRUE(this->UnloadEngine());
+  }
+
+  /// \brief Descriptor of a mesh loaded from a file
+  /// \return Mesh descriptor
+  public: MeshDescriptor FileMesh()
+  {
+    MeshDescriptor desc;
+    desc.meshName = common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+        "test", "media", "meshes", "mesh.dae");
+    desc.mesh = common::MeshManager::Instance()->Load(desc.meshName);
+    return desc;
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(MeshFactoryTest, MeshCache)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  common::TempDirectory cacheDir("mesh_cache", "gz_rendering", true);
+  ASSERT_TRUE(cacheDir.Valid());
+  const std::map<std::string, std::string> params =
+      {{"meshCachePath", cacheDir.Path()}, {"compactMeshes", "0"}};
+
+  MeshDescriptor desc = this->FileMesh();
+  ASSERT_NE(nullptr, desc.mesh);
+
+  // cold start builds the mesh and writes an entry and its index
+  OgreMeshInfo built;
+  bool fromV1 = false;
+  ASSERT_NO_FATAL_FAILURE(
+      this->CreateMesh(params, desc, built, fromV1));
+  EXPECT_TRUE(fromV1);
+  EXPECT_GT(built.vertexCount, 0u);
+  auto entries = this->Files(cacheDir.Path(), ".mesh");
+  ASSERT_EQ(1u, entries.size());
+  EXPECT_EQ(1u, this->Files(cacheDir.Path(), ".key").size());
+
+  // warm start in a fresh engine loads the same geometry from the entry
+  OgreMeshInfo cached;
+  ASSERT_NO_FATAL_FAILURE(
+      this->CreateMesh(params, desc, cached, fromV1));
+  EXPECT_FALSE(fromV1);
+  EXPECT_EQ(built.vertexCount, cached.vertexCount);
+  EXPECT_EQ(built.indexTypes, cached.indexTypes);
+  EXPECT_EQ(built.aabb.getMinimum(), cached.aabb.getMinimum());
+  EXPECT_EQ(built.aabb.getMaximum(), cached.aabb.getMaximum());
+  EXPECT_EQ(1u, this->Files(cacheDir.Path(), ".mesh").size());
+
+  // a corrupted entry is ignored, the mesh is built again and the entry is
+  // replaced
+  {
+    std::ofstream out(entries[0], std::ios::binary | std::ios::trunc);
+    out << "not a mesh";
+  }
+  OgreMeshInfo rebuilt;
+  ASSERT_NO_FATAL_FAILURE(
+      this->CreateMesh(params, desc, rebuilt, fromV1));
+  EXPECT_TRUE(fromV1);
+  EXPECT_EQ(built.vertexCount, rebuilt.vertexCount);
+  EXPECT_EQ(built.aabb.getMinimum(), rebuilt.aabb.getMinimum());
+  EXPECT_EQ(built.aabb.getMaximum(), rebuilt.aabb.getMaximum());
+
+  ASSERT_NO_FATAL_FAILURE(
+      this->CreateMesh(params, desc, cached, fromV1));
+  EXPECT_FALSE(fromV1);
+  EXPECT_EQ(built.vertexCount, cached.vertexCount);
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a grid of height samples as a triangle mesh and register
+/// it with the mesh manager
+/// \param[in] _name Mesh name
+/// \param[in] _samples Number of samples along each side of the grid
+/// \return Descriptor of the mesh
+MeshDescriptor gridMesh(const std::string &_name, unsigned int _samples)
+{
+  MeshDescriptor desc;
+  desc.meshName = _name;
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  if (!meshManager->HasMesh(_name))
+  {
+    common::SubMesh subMesh;
+    subMesh.SetName("grid");
+    subMesh.SetPrimitiveType(common::SubMesh::TRIANGLES);
+    const double step = 10.0 / (_samples - 1u);
+    for (unsigned int j = 0u; j < _samples; ++j)
+    {
+      for (unsigned int i = 0u; i < _samples; ++i)
+      {
+        const double x = -5.0 + i * step;
+        const double y = -5.0 + j * step;
+        subMesh.AddVertex(x, y, 0.5 * std::sin(x) * std::cos(y));
+        subMesh.AddNormal(0, 0, 1);
+        subMesh.AddTexCoord(static_cast<double>(i) / (_samples - 1u),
+            static_cast<double>(j) / (_samples - 1u));
+      }
+    }
+    for (unsigned int j = 0u; j + 1u < _samples; ++j)
+    {
+      for (unsigned int i = 0u; i + 1u < _samples; ++i)
+      {
+        const unsigned int v = j * _samples + i;
+        subMesh.AddIndex(v);
+        subMesh.AddIndex(v + 1u);
+        subMesh.AddIndex(v + _samples);
+        subMesh.AddIndex(v + 1u);
+        subMesh.AddIndex(v + _samples + 1u);
+        subMesh.AddIndex(v + _samples);
+      }
+    }
+
+    common::Mesh *mesh = new common::Mesh();
+    mesh->SetName(_name);
+    mesh->AddSubMesh(subMesh);
+    meshManager->AddMesh(mesh);
+  }
+  desc.mesh = meshManager->MeshByName(_name);
+  return desc;
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshFactoryTest, CompactMeshes)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  const std::map<std::string, std::string> fullParams =
+      {{"meshCachePath", ""}, {"compactMeshes", "0"}};
+  const std::map<std::string, std::string> compactParams =
+      {{"meshCachePath", ""}, {"compactMeshes", "1"}};
+
+  // meshes with less than 65535 vertices get 16 bit indices and QTangents
+  MeshDescriptor small = gridMesh("compact_mesh_small", 100u);
+  ASSERT_NE(nullptr, small.mesh);
+  OgreMeshInfo full;
+  OgreMeshInfo compact;
+  bool fromV1 = false;
+  ASSERT_NO_FATAL_FAILURE(
+      this->CreateMesh(fullParams, small, full, fromV1, true));
+  ASSERT_NO_FATAL_FAILURE(
+      this->CreateMesh(compactParams, small, compact, fromV1, true));
+
+  ASSERT_EQ(1u, full.indexTypes.size());
+  ASSERT_EQ(1u, compact.indexTypes.size());
+  EXPECT_EQ(Ogre::IndexBufferPacked::IT_32BIT, full.indexTypes[0]);
+  EXPECT_EQ(Ogre::IndexBufferPacked::IT_16BIT, compact.indexTypes[0]);
+  EXPECT_EQ(100u * 100u, compact.vertexCount);
+  EXPECT_EQ(full.vertexCount, compact.vertexCount);
+  EXPECT_EQ(full.aabb.getMinimum(), compact.aabb.getMinimum());
+  EXPECT_EQ(full.aabb.getMaximum(), compact.aabb.getMaximum());
+
+  // full meshes keep float3 normals while compact meshes pack the normal
+  // and tangent into a QTangent stored in the normal element
+  ASSERT_EQ(1u, full.normalTypes.size());
+  ASSERT_EQ(1u, compact.normalTypes.size());
+  EXPECT_EQ(Ogre::VET_FLOAT3, full.normalTypes[0]);
+  EXPECT_EQ(Ogre::VET_SHORT4_SNORM, compact.normalTypes[0]);
+  EXPECT_FALSE(compact.hasTangents);
+
+  // the lit mesh looks the same
+  auto compareImages = [](const OgreMeshInfo &_full,
+      const OgreMeshInfo &_compact)
+  {
+    ASSERT_EQ(kImageSize * kImageSize * 3u, _full.image.size());
+    ASSERT_EQ(_full.image.size(), _compact.image.size());
+    unsigned int covered = 0u;
+    unsigned int maxDiff = 0u;
+    double totalDiff = 0.0;
+    for (std::size_t i = 0u; i < _full.image.size(); ++i)
+    {
+      if (_full.image[i] > 0u)
+        ++covered;
+      const unsigned int diff = static_cast<unsigned int>(
+          std::abs(_full.image[i] - _compact.image[i]));
+      maxDiff = std::max(maxDiff, diff);
+      totalDiff += diff;
+    }
+    EXPECT_GT(covered, _full.image.size() / 2u);
+    EXPECT_LE(maxDiff, 8u);
+    EXPECT_LT(totalDiff / _full.image.size(), 1.0);
+  };
+  compareImages(full, compact);
+
+  // meshes with more vertices keep 32 bit indices
+  MeshDescriptor large = gridMesh("compact_mesh_large", 300u);
+  ASSERT_NE(nullptr, large.mesh);
+  ASSERT_NO_FATAL_FAILURE(
+      this->CreateMesh(fullParams, large, full, fromV1, true));
+  ASSERT_NO_FATAL_FAILURE(
+      this->CreateMesh(compactParams, large, compact, fromV1, true));
+
+  ASSERT_EQ(1u, compact.indexTypes.size());
+  EXPECT_EQ(Ogre::IndexBufferPacked::IT_32BIT, compact.indexTypes[0]);
+  EXPECT_EQ(300u * 300u, compact.vertexCount);
+  EXPECT_EQ(full.vertexCount, compact.vertexCount);
+  EXPECT_EQ(full.aabb.getMinimum(), compact.aabb.getMinimum());
+  EXPECT_EQ(full.aabb.getMaximum(), compact.aabb.getMaximum());
+  ASSERT_EQ(1u, compact.normalTypes.size());
+  EXPECT_EQ(Ogre::VET_SHORT4_SNORM, compact.normalTypes[0]);
+  EXPECT_FALSE(compact.hasTangents);
+  compareImages(full, compact);
+}
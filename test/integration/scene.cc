@@ -21,6 +21,12 @@
 
 #include "gz/rendering/Camera.hh"
 #include "gz/rendering/Scene.hh"
+#include "gz/rendering/config.hh"
+
+#if HAVE_OGRE2
+#include "gz/rendering/ogre2/Ogre2Camera.hh"
+#include "gz/rendering/ogre2/Ogre2SelectionBuffer.hh"
+#endif
 
 #include <gz/utils/ExtraTestMacros.hh>
 
@@ -189,6 +195,147 @@ TEST_F(SceneTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(VisualAt))
   VisualPtr empty_visual = scene->VisualAt(camera, emptyPosition);
   ASSERT_EQ(nullptr, empty_visual);
 
+  // the scene reuses its picking query, make sure repeated queries see
+  // scene changes
+  sphere->SetLocalPosition(3, 0, 10);
+  camera->Update();
+  EXPECT_EQ(nullptr, scene->VisualAt(camera, spherePosition));
+  sphere->SetLocalPosition(3, 0, 0);
+  camera->Update();
+  sphere_visual = scene->VisualAt(camera, spherePosition);
+  ASSERT_NE(nullptr, sphere_visual);
+  EXPECT_EQ("sphere", sphere_visual->Name());
+
+  // and queries from another camera
+  CameraPtr backCamera = scene->CreateCamera("back_camera");
+  ASSERT_NE(nullptr, backCamera);
+  backCamera->SetLocalRotation(0.0, 0.0, GZ_PI);
+  backCamera->SetImageWidth(800);
+  backCamera->SetImageHeight(600);
+  backCamera->SetAspectRatio(1.333);
+  backCamera->SetHFOV(GZ_PI / 2);
+  root->AddChild(backCamera);
+  backCamera->Update();
+  EXPECT_EQ(nullptr, scene->VisualAt(backCamera, spherePosition));
+  box_visual = scene->VisualAt(camera, boxPosition);
+  ASSERT_NE(nullptr, box_visual);
+  EXPECT_EQ("box", box_visual->Name());
+
   // Clean up
   engine->DestroyScene(scene);
 }
+
+#if HAVE_OGRE2
+/////////////////////////////////////////////////
+TEST_F(SceneTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(VisualAtFullFrame))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+#ifdef __APPLE__
+  GTEST_SKIP() << "Test is flaky on macOS, see issue #170.";
+#endif
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  VisualPtr root = scene->RootVisual();
+  ASSERT_NE(nullptr, root);
+
+  // create box visual
+  VisualPtr box = scene->CreateVisual("box");
+  ASSERT_NE(nullptr, box);
+  box->AddGeometry(scene->CreateBox());
+  box->SetOrigin(0.0, 0.5, 0.0);
+  box->SetLocalPosition(3, 0, 0);
+  box->SetLocalRotation(GZ_PI / 4, 0, GZ_PI / 3);
+  box->SetLocalScale(1, 2.5, 1);
+  root->AddChild(box);
+
+  // create sphere visual
+  VisualPtr sphere = scene->CreateVisual("sphere");
+  ASSERT_NE(nullptr, sphere);
+  sphere->AddGeometry(scene->CreateSphere());
+  sphere->SetOrigin(0.0, -0.5, 0.0);
+  sphere->SetLocalPosition(3, 0, 0);
+  sphere->SetLocalRotation(0, 0, 0);
+  sphere->SetLocalScale(1, 2.5, 1);
+  root->AddChild(sphere);
+
+  // create camera
+  CameraPtr camera = scene->CreateCamera("camera");
+  ASSERT_NE(nullptr, camera);
+  camera->SetLocalPosition(0.0, 0.0, 0.0);
+  camera->SetLocalRotation(0.0, 0.0, 0.0);
+  camera->SetImageWidth(800);
+  camera->SetImageHeight(600);
+  camera->SetAntiAliasing(2);
+  camera->SetAspectRatio(1.333);
+  camera->SetHFOV(GZ_PI / 2);
+  root->AddChild(camera);
+
+  Ogre2CameraPtr ogreCamera = std::dynamic_pointer_cast<Ogre2Camera>(camera);
+  ASSERT_NE(nullptr, ogreCamera);
+  EXPECT_FALSE(ogreCamera->SelectionBufferFullFrame());
+  ogreCamera->SetSelectionBufferFullFrame(true);
+  EXPECT_TRUE(ogreCamera->SelectionBufferFullFrame());
+
+  // render a frame
+  camera->Update();
+
+  // several queries in the same frame are answered from one full frame
+  // render
+  math::Vector2i spherePosition(220, 307);
+  math::Vector2i boxPosition(452, 338);
+  math::Vector2i emptyPosition(300, 150);
+  for (int i = 0; i < 2; ++i)
+  {
+    VisualPtr sphereVisual = scene->VisualAt(camera, spherePosition);
+    ASSERT_NE(nullptr, sphereVisual);
+    EXPECT_EQ("sphere", sphereVisual->Name());
+
+    VisualPtr boxVisual = scene->VisualAt(camera, boxPosition);
+    ASSERT_NE(nullptr, boxVisual);
+    EXPECT_EQ("box", boxVisual->Name());
+
+    EXPECT_EQ(nullptr, scene->VisualAt(camera, emptyPosition));
+  }
+  ASSERT_NE(nullptr, ogreCamera->SelectionBuffer());
+  EXPECT_TRUE(ogreCamera->SelectionBuffer()->FullFrame());
+
+  // moving a visual does not render the selection buffer again until the
+  // scene starts a new frame
+  sphere->SetLocalPosition(3, 0, 10);
+  VisualPtr cachedVisual = scene->VisualAt(camera, spherePosition);
+  ASSERT_NE(nullptr, cachedVisual);
+  EXPECT_EQ("sphere", cachedVisual->Name());
+
+  camera->Update();
+  EXPECT_EQ(nullptr, scene->VisualAt(camera, spherePosition));
+  VisualPtr boxVisual = scene->VisualAt(camera, boxPosition);
+  ASSERT_NE(nullptr, boxVisual);
+  EXPECT_EQ("box", boxVisual->Name());
+
+  // moving the camera invalidates the full frame right away
+  camera->SetLocalRotation(0.0, 0.0, GZ_PI);
+  EXPECT_EQ(nullptr, scene->VisualAt(camera, boxPosition));
+  camera->SetLocalRotation(0.0, 0.0, 0.0);
+  boxVisual = scene->VisualAt(camera, boxPosition);
+  ASSERT_NE(nullptr, boxVisual);
+  EXPECT_EQ("box", boxVisual->Name());
+
+  // area queries keep the selection buffer mode
+  ogreCamera->SetSelectionBufferFullFrame(false);
+  EXPECT_FALSE(ogreCamera->SelectionBuffer()->FullFrame());
+  auto results = camera->VisualsInRectangle(math::Vector2i(0, 0),
+      math::Vector2i(799, 599));
+  EXPECT_EQ(1u, results.size());
+  EXPECT_FALSE(ogreCamera->SelectionBufferFullFrame());
+  EXPECT_FALSE(ogreCamera->SelectionBuffer()->FullFrame());
+  boxVisual = scene->VisualAt(camera, boxPosition);
+  ASSERT_NE(nullptr, boxVisual);
+  EXPECT_EQ("box", boxVisual->Name());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+#endif
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CommonRenderingTest.hh"
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+
+#include "gz/rendering/Camera.hh"
+#include "gz/rendering/Scene.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Test fixture for the ogre2 shader cache. Since the cache is set
+/// up with an engine parameter the engine is loaded by the tests.
+class ShaderCacheTest: public EngineReloadTest
+{
+  /// \brief Load the engine with a shader cache, render a frame with a lit
+  /// and an unlit material and unload the engine
+  /// \param[in] _cachePath Shader cache directory
+  public: void Render(const std::string &_cachePath)
+  {
+    auto engine = this->LoadEngine({{"shaderCachePath", _cachePath}});
+    ASSERT_NE(nullptr, engine);
+
+    ScenePtr scene = engine->CreateScene("scene");
+    ASSERT_NE(nullptr, scene);
+    VisualPtr root = scene->RootVisual();
+
+    VisualPtr box = scene->CreateVisual();
+    box->AddGeometry(scene->CreateBox());
+    box->SetLocalPosition(3, 0, 0);
+    MaterialPtr lit = scene->CreateMaterial();
+    lit->SetDiffuse(0.8, 0.2, 0.2);
+    box->SetMaterial(lit);
+    root->AddChild(box);
+
+    VisualPtr sphere = scene->CreateVisual();
+    sphere->AddGeometry(scene->CreateSphere());
+    sphere->SetLocalPosition(3, 1, 0);
+    MaterialPtr unlit = scene->CreateMaterial();
+    unlit->SetLightingEnabled(false);
+    sphere->SetMaterial(unlit);
+    root->AddChild(sphere);
+
+    CameraPtr camera = scene->CreateCamera("camera");
+    ASSERT_NE(nullptr, camera);
+    camera->SetImageWidth(64);
+    camera->SetImageHeight(64);
+    root->AddChild(camera);
+    camera->Update();
+
+    engine->DestroyScene(scene);
+    ASSERT_TRUE(this->UnloadEngine());
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(ShaderCacheTest, SaveAndLoad)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  common::TempDirectory cacheDir("shader_cache", "gz_rendering", true);
+  ASSERT_TRUE(cacheDir.Valid());
+
+  // entries are saved when the engine is destroyed, in a subdirectory keyed
+  // by the engine, render system and driver
+  ASSERT_NO_FATAL_FAILURE(this->Render(cacheDir.Path()));
+
+  std::vector<std::string> directories = this->Directories(cacheDir.Path());
+  ASSERT_EQ(1u, directories.size());
+
+  std::vector<std::string> hlmsEntries;
+  for (const auto &entry : this->Files(directories[0], ".cache"))
+  {
+    if (common::basename(entry).compare(0, 4u, "hlms") == 0)
+      hlmsEntries.push_back(entry);
+  }
+  EXPECT_FALSE(hlmsEntries.empty());
+  EXPECT_TRUE(common::isFile(
+      common::joinPaths(directories[0], "microcode.cache")));
+
+  // the next run finds and accepts the entries
+  testing::internal::CaptureStderr();
+  this->Render(cacheDir.Path());
+  const std::string output = testing::internal::GetCapturedStderr();
+  ASSERT_FALSE(this->HasFatalFailure());
+  EXPECT_EQ(std::string::npos, output.find("Ignoring invalid")) << output;
+
+  // and keeps using the same subdirectory
+  EXPECT_EQ(1u, this->Directories(cacheDir.Path()).size());
+}
@@ -169,6 +169,19 @@ TEST_F(ThermalCameraTest,
     EXPECT_FLOAT_EQ(thermalData[right], thermalData[left]);
     EXPECT_NEAR(boxTemp, thermalData[mid] * linearResolution, boxTempRange);
 
+    // change the box temperature and verify the new value is rendered
+    if (this->engineToTest == "ogre2")
+    {
+      const float newBoxTemp = 350.0f;
+      box->SetUserData("temperature", newBoxTemp);
+      thermalCamera->Update();
+      EXPECT_NEAR(newBoxTemp, thermalData[mid] * linearResolution,
+          boxTempRange);
+      box->SetUserData("temperature", boxTemp);
+      thermalCamera->Update();
+      EXPECT_NEAR(boxTemp, thermalData[mid] * linearResolution, boxTempRange);
+    }
+
     // move box in front of near clip plane and verify the thermal
     // image returns all box temperature values
     gz::math::Vector3d boxPositionNear(
@@ -0,0 +1,758 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Scene scale benchmarks. Each test builds a scene, renders a number of
+// frames and records per frame CPU time, Scene::PreRender time, sensor
+// readback time (PostRender and image copies) and heap allocations.
+//
+// The results of all tests are written as JSON when the program exits. The
+// benchmarks can be tuned with the following environment variables:
+//
+//   GZ_RENDERING_BENCHMARK_VISUALS  Comma separated visual counts for the
+//                                   scene size benchmark, e.g.
+//                                   "1000,10000,100000". Default: "1000".
+//   GZ_RENDERING_BENCHMARK_FRAMES   Number of measured frames. Default: 20.
+//   GZ_RENDERING_BENCHMARK_OUTPUT   Path of the JSON file. Default:
+//                                   <build>/test_results/
+//                                   scene_benchmark_<engine>_<backend>.json
+//
+// Set GZ_ENGINE_HEADLESS=1 to run on the EGL path, which works on machines
+// without a display or GPU through Mesa's software rasterizer. The default
+// output file name then ends in _headless.json.
+//
+// The benchmarks are not part of the default test run. Run the
+// PERFORMANCE_scene_benchmark executable with GZ_ENGINE_TO_TEST and
+// GZ_ENGINE_BACKEND set, or configure with -DGZ_RENDERING_RUN_BENCHMARKS=ON
+// to register them with ctest.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CommonRenderingTest.hh"
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/StringUtils.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/rendering/BoundingBoxCamera.hh"
+#include "gz/rendering/Camera.hh"
+#include "gz/rendering/DepthCamera.hh"
+#include "gz/rendering/GpuRays.hh"
+#include "gz/rendering/Image.hh"
+#include "gz/rendering/Marker.hh"
+#include "gz/rendering/Scene.hh"
+#include "gz/rendering/SegmentationCamera.hh"
+#include "gz/rendering/ThermalCamera.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Number of heap allocations made by the process
+static std::atomic<uint64_t> g_allocCount(0u);
+
+/// \brief Number of bytes allocated on the heap by the process
+static std::atomic<uint64_t> g_allocBytes(0u);
+
+/////////////////////////////////////////////////
+// Count heap allocations by replacing the global allocation functions
+void *operator new(std::size_t _size)
+{
+  g_allocCount.fetch_add(1u, std::memory_order_relaxed);
+  g_allocBytes.fetch_add(_size, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(_size == 0u ? 1u : _size))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size)
+{
+  return ::operator new(_size);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/// \brief Summary of a series of measurements
+struct Stats
+{
+  /// \brief Mean value
+  double mean = 0.0;
+
+  /// \brief Min value
+  double min = 0.0;
+
+  /// \brief Max value
+  double max = 0.0;
+
+  /// \brief Median value
+  double p50 = 0.0;
+
+  /// \brief 95th percentile
+  double p95 = 0.0;
+};
+
+/// \brief Results of one benchmark
+struct BenchmarkResult
+{
+  /// \brief Benchmark name
+  std::string name;
+
+  /// \brief Number of visuals in the scene
+  unsigned int visuals = 0u;
+
+  /// \brief Number of sensors rendered each frame
+  unsigned int sensors = 0u;
+
+  /// \brief Number of measured frames
+  unsigned int frames = 0u;
+
+  /// \brief Time taken to build the scene in milliseconds
+  double setupMs = 0.0;
+
+  /// \brief CPU time of a whole frame in milliseconds
+  Stats frameMs;
+
+  /// \brief Time spent in Scene::PreRender in milliseconds
+  Stats preRenderMs;
+
+  /// \brief Time spent reading back sensor data in milliseconds
+  Stats readbackMs;
+
+  /// \brief Mean number of heap allocations per frame
+  double allocationsPerFrame = 0.0;
+
+  /// \brief Mean number of bytes allocated per frame
+  double allocatedBytesPerFrame = 0.0;
+};
+
+/// \brief Results of all benchmarks run so far
+static std::vector<BenchmarkResult> g_results;
+
+/////////////////////////////////////////////////
+Stats ComputeStats(std::vector<double> _samples)
+{
+  Stats stats;
+  if (_samples.empty())
+    return stats;
+
+  std::sort(_samples.begin(), _samples.end());
+  stats.min = _samples.front();
+  stats.max = _samples.back();
+  stats.mean = std::accumulate(_samples.begin(), _samples.end(), 0.0) /
+      _samples.size();
+  stats.p50 = _samples[_samples.size() / 2u];
+  stats.p95 = _samples[std::min(_samples.size() - 1u,
+      static_cast<std::size_t>(_samples.size() * 0.95))];
+  return stats;
+}
+
+/////////////////////////////////////////////////
+double ElapsedMs(const std::chrono::steady_clock::time_point &_start)
+{
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - _start).count();
+}
+
+/////////////////////////////////////////////////
+unsigned int EnvUInt(const std::string &_name, unsigned int _default)
+{
+  std::string value;
+  if (!utils::env(_name, value) || value.empty())
+    return _default;
+  return static_cast<unsigned int>(std::stoul(value));
+}
+
+/////////////////////////////////////////////////
+std::string StatsToJson(const Stats &_stats)
+{
+  std::stringstream ss;
+  ss << "{\"mean\": " << _stats.mean
+     << ", \"min\": " << _stats.min
+     << ", \"max\": " << _stats.max
+     << ", \"p50\": " << _stats.p50
+     << ", \"p95\": " << _stats.p95 << "}";
+  return ss.str();
+}
+
+/// \brief Writes the results of all benchmarks once all tests have run
+class BenchmarkEnvironment : public testing::Environment
+{
+  // Documentation inherited
+  public: void TearDown() override
+  {
+    if (g_results.empty())
+      return;
+
+    auto [engineName, backend, headless] = GetTestParams();
+
+    std::string path;
+    if (!utils::env("GZ_RENDERING_BENCHMARK_OUTPUT", path) || path.empty())
+    {
+      std::string dir = common::joinPaths(PROJECT_BUILD_PATH, "test_results");
+      common::createDirectories(dir);
+      std::string fileName = "scene_benchmark_" + engineName;
+      if (!backend.empty())
+        fileName += "_" + backend;
+      if (!headless.empty())
+        fileName += "_headless";
+      path = common::joinPaths(dir, fileName + ".json");
+    }
+
+    std::ofstream out(path);
+    out << "{\n"
+        << "  \"engine\": \"" << engineName << "\",\n"
+        << "  \"backend\": \"" << backend << "\",\n"
+        << "  \"headless\": " << (headless.empty() ? "false" : "true")
+        << ",\n"
+        << "  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < g_results.size(); ++i)
+    {
+      const BenchmarkResult &r = g_results[i];
+      out << "    {\n"
+          << "      \"name\": \"" << r.name << "\",\n"
+          << "      \"visuals\": " << r.visuals << ",\n"
+          << "      \"sensors\": " << r.sensors << ",\n"
+          << "      \"frames\": " << r.frames << ",\n"
+          << "      \"setup_ms\": " << r.setupMs << ",\n"
+          << "      \"frame_ms\": " << StatsToJson(r.frameMs) << ",\n"
+          << "      \"prerender_ms\": " << StatsToJson(r.preRenderMs) << ",\n"
+          << "      \"readback_ms\": " << StatsToJson(r.readbackMs) << ",\n"
+          << "      \"allocations_per_frame\": " << r.allocationsPerFrame
+          << ",\n"
+          << "      \"allocated_bytes_per_frame\": "
+          << r.allocatedBytesPerFrame << "\n"
+          << "    }" << (i + 1u < g_results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+
+    gzmsg << "Benchmark results written to [" << path << "]" << std::endl;
+  }
+};
+
+testing::Environment *const g_benchmarkEnvironment =
+    testing::AddGlobalTestEnvironment(new BenchmarkEnvironment);
+
+/// \brief Scene scale benchmarks
+class SceneBenchmarkTest : public CommonRenderingTest
+{
+  /// \brief Populate a scene with a grid of boxes sharing one material
+  /// \param[in] _scene Scene to populate
+  /// \param[in] _count Number of visuals to create
+  /// \return Created visuals
+  public: std::vector<VisualPtr> CreateVisuals(ScenePtr _scene,
+              unsigned int _count)
+  {
+    MaterialPtr material = _scene->CreateMaterial();
+    material->SetDiffuse(0.3, 0.6, 0.9);
+
+    std::vector<VisualPtr> visuals;
+    visuals.reserve(_count);
+    unsigned int side = static_cast<unsigned int>(
+        std::ceil(std::sqrt(static_cast<double>(_count))));
+    for (unsigned int i = 0; i < _count; ++i)
+    {
+      VisualPtr visual = _scene->CreateVisual();
+      visual->AddGeometry(_scene->CreateBox());
+      visual->SetMaterial(material, false);
+      visual->SetLocalPosition(2.0 + (i / side) * 0.5,
+          (static_cast<double>(i % side) - side * 0.5) * 0.5, 0.0);
+      visual->SetLocalScale(0.25, 0.25, 0.25);
+      visual->SetUserData("label", static_cast<int>(i % 255u));
+      visual->SetUserData("temperature", 300.0f + (i % 50u));
+      _scene->RootVisual()->AddChild(visual);
+      visuals.push_back(visual);
+    }
+    return visuals;
+  }
+
+  /// \brief Configure a camera looking at the visual grid
+  /// \param[in] _scene Scene the camera belongs to
+  /// \param[in] _camera Camera to configure
+  /// \param[in] _yaw Yaw of the camera
+  public: void SetupCamera(ScenePtr _scene, CameraPtr _camera,
+              double _yaw = 0.0)
+  {
+    _camera->SetLocalPosition(-2.0, 0.0, 2.0);
+    _camera->SetLocalRotation(0.0, 0.3, _yaw);
+    _camera->SetImageWidth(320u);
+    _camera->SetImageHeight(240u);
+    _camera->SetAspectRatio(320.0 / 240.0);
+    _camera->SetHFOV(GZ_PI / 2.0);
+    _camera->SetNearClipPlane(0.1);
+    _camera->SetFarClipPlane(100.0);
+    _scene->RootVisual()->AddChild(_camera);
+  }
+
+  /// \brief Render frames with the given sensors and record the results
+  /// \param[in] _result Result to fill in. Its name, visual count and setup
+  /// time should already be set.
+  /// \param[in] _scene Scene to render
+  /// \param[in] _sensors Sensors to render every frame
+  /// \param[in] _images Images to copy from the sensors after PostRender.
+  /// Either empty or one per sensor; null entries are skipped.
+  /// \param[in] _update Called at the beginning of every frame, e.g. to
+  /// move visuals
+  public: void RunFrames(BenchmarkResult &_result, ScenePtr _scene,
+              const std::vector<CameraPtr> &_sensors,
+              std::vector<Image *> _images = {},
+              std::function<void(unsigned int)> _update = nullptr)
+  {
+    const unsigned int warmupFrames = 3u;
+    const unsigned int frames =
+        EnvUInt("GZ_RENDERING_BENCHMARK_FRAMES", 20u);
+    _images.resize(_sensors.size(), nullptr);
+
+    std::vector<double> frameMs;
+    std::vector<double> preRenderMs;
+    std::vector<double> readbackMs;
+    uint64_t allocCount = 0u;
+    uint64_t allocBytes = 0u;
+
+    for (unsigned int f = 0; f < warmupFrames + frames; ++f)
+    {
+      uint64_t allocCountStart = g_allocCount.load();
+      uint64_t allocBytesStart = g_allocBytes.load();
+      auto frameStart = std::chrono::steady_clock::now();
+
+      if (_update)
+        _update(f);
+
+      auto start = std::chrono::steady_clock::now();
+      _scene->PreRender();
+      double preRender = ElapsedMs(start);
+
+      for (auto &sensor : _sensors)
+        sensor->Render();
+
+      start = std::chrono::steady_clock::now();
+      for (std::size_t i = 0; i < _sensors.size(); ++i)
+      {
+        _sensors[i]->PostRender();
+        if (_images[i])
+          _sensors[i]->Copy(*_images[i]);
+      }
+      double readback = ElapsedMs(start);
+
+      _scene->PostRender();
+      _scene->SetTime(_scene->Time() + std::chrono::milliseconds(16));
+
+      if (f < warmupFrames)
+        continue;
+
+      frameMs.push_back(ElapsedMs(frameStart));
+      preRenderMs.push_back(preRender);
+      readbackMs.push_back(readback);
+      allocCount += g_allocCount.load() - allocCountStart;
+      allocBytes += g_allocBytes.load() - allocBytesStart;
+    }
+
+    _result.sensors = static_cast<unsigned int>(_sensors.size());
+    _result.frames = frames;
+    _result.frameMs = ComputeStats(frameMs);
+    _result.preRenderMs = ComputeStats(preRenderMs);
+    _result.readbackMs = ComputeStats(readbackMs);
+    if (frames > 0u)
+    {
+      _result.allocationsPerFrame = static_cast<double>(allocCount) / frames;
+      _result.allocatedBytesPerFrame =
+          static_cast<double>(allocBytes) / frames;
+    }
+
+    gzmsg << "[" << _result.name << "] frame "
+          << _result.frameMs.mean << " ms, prerender "
+          << _result.preRenderMs.mean << " ms, readback "
+          << _result.readbackMs.mean << " ms, "
+          << _result.allocationsPerFrame << " allocations / frame"
+          << std::endl;
+
+    g_results.push_back(_result);
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(SceneBenchmarkTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Visuals))
+{
+  CHECK_UNSUPPORTED_ENGINE("optix");
+
+  std::string countsStr = "1000";
+  utils::env("GZ_RENDERING_BENCHMARK_VISUALS", countsStr);
+
+  for (const auto &countStr : common::split(countsStr, ","))
+  {
+    unsigned int count = static_cast<unsigned int>(std::stoul(countStr));
+    ScenePtr scene = engine->CreateScene("scene");
+    ASSERT_NE(nullptr, scene);
+
+    BenchmarkResult result;
+    result.name = "visuals_" + std::to_string(count);
+    result.visuals = count;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<VisualPtr> visuals = this->CreateVisuals(scene, count);
+    result.setupMs = ElapsedMs(start);
+
+    CameraPtr camera = scene->CreateCamera();
+    ASSERT_NE(nullptr, camera);
+    this->SetupCamera(scene, camera);
+    Image image = camera->CreateImage();
+
+    // move 1% of the visuals every frame
+    auto update = [&visuals](unsigned int _frame)
+    {
+      for (std::size_t i = _frame % 100u; i < visuals.size(); i += 100u)
+      {
+        math::Vector3d pos = visuals[i]->LocalPosition();
+        pos.Z(0.1 * (_frame % 10u));
+        visuals[i]->SetLocalPosition(pos);
+      }
+    };
+
+    this->RunFrames(result, scene, {camera}, {&image}, update);
+
+    engine->DestroyScene(scene);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneBenchmarkTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ManyCameras))
+{
+  CHECK_UNSUPPORTED_ENGINE("optix");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  BenchmarkResult result;
+  result.name = "many_cameras";
+  result.visuals = 1000u;
+  auto start = std::chrono::steady_clock::now();
+  this->CreateVisuals(scene, result.visuals);
+  result.setupMs = ElapsedMs(start);
+
+  const unsigned int cameraCount = 16u;
+  std::vector<CameraPtr> cameras;
+  std::vector<Image> images;
+  images.reserve(cameraCount);
+  for (unsigned int i = 0; i < cameraCount; ++i)
+  {
+    CameraPtr camera = scene->CreateCamera();
+    ASSERT_NE(nullptr, camera);
+    this->SetupCamera(scene, camera, -0.4 + 0.8 * i / cameraCount);
+    cameras.push_back(camera);
+    images.push_back(camera->CreateImage());
+  }
+  std::vector<Image *> imagePtrs;
+  for (auto &image : images)
+    imagePtrs.push_back(&image);
+
+  this->RunFrames(result, scene, cameras, imagePtrs);
+
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneBenchmarkTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(DepthCamera))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  BenchmarkResult result;
+  result.name = "depth_camera";
+  result.visuals = 1000u;
+  auto start = std::chrono::steady_clock::now();
+  this->CreateVisuals(scene, result.visuals);
+  result.setupMs = ElapsedMs(start);
+
+  DepthCameraPtr camera = scene->CreateDepthCamera();
+  ASSERT_NE(nullptr, camera);
+  this->SetupCamera(scene, camera);
+  camera->CreateDepthTexture();
+  auto depthConnection = camera->ConnectNewDepthFrame(
+      [](const float *, unsigned int, unsigned int, unsigned int,
+         const std::string &) {});
+  auto pointCloudConnection = camera->ConnectNewRgbPointCloud(
+      [](const float *, unsigned int, unsigned int, unsigned int,
+         const std::string &) {});
+
+  this->RunFrames(result, scene, {camera});
+
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneBenchmarkTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ThermalCamera))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  BenchmarkResult result;
+  result.name = "thermal_camera";
+  result.visuals = 1000u;
+  auto start = std::chrono::steady_clock::now();
+  this->CreateVisuals(scene, result.visuals);
+  result.setupMs = ElapsedMs(start);
+
+  ThermalCameraPtr camera = scene->CreateThermalCamera();
+  ASSERT_NE(nullptr, camera);
+  this->SetupCamera(scene, camera);
+  camera->SetAmbientTemperature(296.0f);
+  auto connection = camera->ConnectNewThermalFrame(
+      [](const uint16_t *, unsigned int, unsigned int, unsigned int,
+         const std::string &) {});
+
+  this->RunFrames(result, scene, {camera});
+
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneBenchmarkTest,
+    GZ_UTILS_TEST_DISABLED_ON_WIN32(SegmentationCamera))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  BenchmarkResult result;
+  result.name = "segmentation_camera";
+  result.visuals = 1000u;
+  auto start = std::chrono::steady_clock::now();
+  this->CreateVisuals(scene, result.visuals);
+  result.setupMs = ElapsedMs(start);
+
+  SegmentationCameraPtr camera = scene->CreateSegmentationCamera();
+  ASSERT_NE(nullptr, camera);
+  this->SetupCamera(scene, camera);
+  camera->SetSegmentationType(SegmentationType::ST_PANOPTIC);
+  auto connection = camera->ConnectNewSegmentationFrame(
+      [](const uint8_t *, unsigned int, unsigned int, unsigned int,
+         const std::string &) {});
+
+  this->RunFrames(result, scene, {camera});
+
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneBenchmarkTest,
+    GZ_UTILS_TEST_DISABLED_ON_WIN32(BoundingBoxCamera))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  std::vector<std::pair<std::string, BoundingBoxType>> types = {
+    {"visible_2d", BoundingBoxType::BBT_VISIBLEBOX2D},
+    {"full_2d", BoundingBoxType::BBT_FULLBOX2D},
+    {"3d", BoundingBoxType::BBT_BOX3D},
+  };
+
+  for (const auto &[typeName, type] : types)
+  {
+    ScenePtr scene = engine->CreateScene("scene");
+    ASSERT_NE(nullptr, scene);
+
+    BenchmarkResult result;
+    result.name = "bounding_box_camera_" + typeName;
+    result.visuals = 1000u;
+    auto start = std::chrono::steady_clock::now();
+    this->CreateVisuals(scene, result.visuals);
+    result.setupMs = ElapsedMs(start);
+
+    BoundingBoxCameraPtr camera = scene->CreateBoundingBoxCamera();
+    ASSERT_NE(nullptr, camera);
+    this->SetupCamera(scene, camera);
+    camera->SetBoundingBoxType(type);
+    auto connection = camera->ConnectNewBoundingBoxes(
+        [](const std::vector<BoundingBox> &) {});
+
+    this->RunFrames(result, scene, {camera});
+
+    engine->DestroyScene(scene);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneBenchmarkTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(GpuRays))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  /// \brief GpuRays configuration
+  struct GpuRaysConfig
+  {
+    std::string name;
+    int rayCount;
+    int verticalRayCount;
+    double verticalAngle;
+  };
+
+  std::vector<GpuRaysConfig> configs = {
+    {"gpu_rays_2d_640", 640, 1, 0.0},
+    {"gpu_rays_1800x16", 1800, 16, GZ_DTOR(15.0)},
+    {"gpu_rays_1024x64", 1024, 64, GZ_DTOR(22.5)},
+  };
+
+  for (const auto &config : configs)
+  {
+    ScenePtr scene = engine->CreateScene("scene");
+    ASSERT_NE(nullptr, scene);
+
+    BenchmarkResult result;
+    result.name = config.name;
+    result.visuals = 1000u;
+    auto start = std::chrono::steady_clock::now();
+    this->CreateVisuals(scene, result.visuals);
+    result.setupMs = ElapsedMs(start);
+
+    GpuRaysPtr gpuRays = scene->CreateGpuRays();
+    ASSERT_NE(nullptr, gpuRays);
+    gpuRays->SetLocalPosition(0.0, 0.0, 0.5);
+    gpuRays->SetNearClipPlane(0.1);
+    gpuRays->SetFarClipPlane(100.0);
+    gpuRays->SetAngleMin(-GZ_PI);
+    gpuRays->SetAngleMax(GZ_PI);
+    gpuRays->SetRayCount(config.rayCount);
+    gpuRays->SetVerticalRayCount(config.verticalRayCount);
+    if (config.verticalRayCount > 1)
+    {
+      gpuRays->SetVerticalAngleMin(-config.verticalAngle);
+      gpuRays->SetVerticalAngleMax(config.verticalAngle);
+    }
+    scene->RootVisual()->AddChild(gpuRays);
+    auto connection = gpuRays->ConnectNewGpuRaysFrame(
+        [](const float *, unsigned int, unsigned int, unsigned int,
+           const std::string &) {});
+
+    this->RunFrames(result, scene, {gpuRays});
+
+    engine->DestroyScene(scene);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneBenchmarkTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(MarkerChurn))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  BenchmarkResult result;
+  result.name = "marker_churn";
+  result.visuals = 1000u;
+  auto start = std::chrono::steady_clock::now();
+  this->CreateVisuals(scene, result.visuals);
+  result.setupMs = ElapsedMs(start);
+
+  MaterialPtr material = scene->CreateMaterial();
+  material->SetDiffuse(1.0, 0.0, 0.0);
+  material->SetEmissive(1.0, 0.0, 0.0);
+
+  // point markers whose points are replaced every frame
+  const unsigned int markerCount = 10u;
+  const unsigned int pointCount = 1000u;
+  std::vector<MarkerPtr> pointMarkers;
+  for (unsigned int i = 0; i < markerCount; ++i)
+  {
+    MarkerPtr marker = scene->CreateMarker();
+    marker->SetType(MarkerType::MT_POINTS);
+    marker->SetMaterial(material, false);
+    VisualPtr visual = scene->CreateVisual();
+    visual->AddGeometry(marker);
+    scene->RootVisual()->AddChild(visual);
+    pointMarkers.push_back(marker);
+  }
+
+  // short lived box markers created and destroyed every frame
+  std::vector<VisualPtr> boxMarkers;
+
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  this->SetupCamera(scene, camera);
+
+  auto update = [&](unsigned int _frame)
+  {
+    for (unsigned int i = 0; i < markerCount; ++i)
+    {
+      MarkerPtr marker = pointMarkers[i];
+      marker->ClearPoints();
+      for (unsigned int p = 0; p < pointCount; ++p)
+      {
+        marker->AddPoint(2.0 + p * 0.01, i * 0.2 - 1.0,
+            0.1 * std::sin(p * 0.1 + _frame), math::Color::Red);
+      }
+    }
+
+    for (auto &visual : boxMarkers)
+      scene->DestroyVisual(visual, true);
+    boxMarkers.clear();
+    for (unsigned int i = 0; i < markerCount; ++i)
+    {
+      MarkerPtr marker = scene->CreateMarker();
+      marker->SetType(MarkerType::MT_BOX);
+      marker->SetMaterial(material, false);
+      VisualPtr visual = scene->CreateVisual();
+      visual->AddGeometry(marker);
+      visual->SetLocalPosition(3.0, i * 0.2 - 1.0, 1.0);
+      visual->SetLocalScale(0.1, 0.1, 0.1);
+      scene->RootVisual()->AddChild(visual);
+      boxMarkers.push_back(visual);
+    }
+  };
+
+  this->RunFrames(result, scene, {camera}, {}, update);
+
+  engine->DestroyScene(scene);
+}